@@ -17,6 +17,10 @@ if(WIGCPP_BUILD_BENCHMARK)
   add_subdirectory(benchmarks)
 endif()
 
+if(WIGCPP_BUILD_TABLEGEN)
+  add_subdirectory(tools)
+endif()
+
 if(WIGCPP_BUILD_FORTRAN_INTERFACE)
   include(CheckLanguage)
   check_language(Fortran)
@@ -52,6 +56,23 @@ if(WIGCPP_BUILD_FORTRAN_INTERFACE)
   endif()
 endif()
 
+if(WIGCPP_DOUBLE_EVAL)
+  target_compile_definitions(wigcpp_core PUBLIC WIGCPP_DOUBLE_EVAL)
+endif()
+
+if(WIGCPP_USE_GMP)
+  find_path(GMP_INCLUDE_DIR gmp.h)
+  find_library(GMP_LIBRARY gmp)
+  if(GMP_INCLUDE_DIR AND GMP_LIBRARY)
+    message(STATUS "GMP enabled(library: ${GMP_LIBRARY})")
+    target_compile_definitions(wigcpp_core PRIVATE WIGCPP_USE_GMP)
+    target_include_directories(wigcpp_core PRIVATE ${GMP_INCLUDE_DIR})
+    target_link_libraries(wigcpp_core PUBLIC ${GMP_LIBRARY})
+  else()
+    message(WARNING "GMP is not found, big integers are multiplied by the built-in implementation.")
+  endif()
+endif()
+
 if(WIGCPP_ENABLE_IPO)
   include(CheckIPOSupported)
   check_ipo_supported(RESULT result OUTPUT output)
@@ -0,0 +1,31 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_ASYMPTOTIC__
+#define __WIGCPP_ASYMPTOTIC__
+
+namespace wigcpp::internal::asymptotic {
+
+/* Semiclassical approximations for large angular momenta, evaluated from the geometry of the symbol alone, without the
+ * factorial pool. The 6j symbol is the Ponzano-Regge formula over the tetrahedron with edges j + 1/2, the 3j symbol
+ * its limit when one vertex moves to infinity along the z axis (Edmonds), with the area of the triangle projected on
+ * the xy plane in place of the volume. Both are uniformized with the Airy function around the caustic where the
+ * tetrahedron or the projected triangle becomes flat (Schulten-Gordon), and continue into the classically forbidden
+ * region beyond it.
+ *
+ * The relative error of the approximation falls as 1/j. error receives an estimate of the absolute error, scaled from
+ * the envelope of the symbol and its smallest argument.
+ */
+double calc_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3, double &error) noexcept;
+
+double calc_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6, double &error) noexcept;
+
+} // namespace wigcpp::internal::asymptotic
+
+#endif /* __WIGCPP_ASYMPTOTIC__ */
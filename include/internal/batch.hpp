@@ -0,0 +1,45 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_BATCH__
+#define __WIGCPP_BATCH__
+
+#include "internal/global_pool.hpp"
+#include "internal/tmp_pool.hpp"
+#include <cstddef>
+
+namespace wigcpp::internal::batch {
+using namespace wigcpp::internal::global;
+using namespace wigcpp::internal::tmp;
+
+/* Instruction sets of the batch kernels. A kernel evaluates 4 (scalar), 8 (avx2) or 16 (avx512) symbols side by side,
+ * one symbol per SIMD lane, with every term of the sums held as an exact double. Symbols whose terms don't fit in 53
+ * bits, or with two_j above max_two_j, are handed to the Calculator one by one.
+ */
+enum class Isa { scalar, avx2, avx512 };
+
+constexpr int max_two_j = 24;
+
+/* the widest kernel the running CPU supports */
+Isa native_isa() noexcept;
+
+int lane_count(Isa isa) noexcept;
+
+/* two_j holds count symbols of 6 arguments each, in the order of wigner3j and wigner6j. The results are identical to
+ * those of Calculator::calc_3j and Calculator::calc_6j.
+ */
+void batch_3j(const GlobalFactorialPool &pool, TempStorage &csi, const int *two_j, std::size_t count, double *results,
+              Isa isa = native_isa()) noexcept;
+
+void batch_6j(const GlobalFactorialPool &pool, TempStorage &csi, const int *two_j, std::size_t count, double *results,
+              Isa isa = native_isa()) noexcept;
+
+} // namespace wigcpp::internal::batch
+
+#endif /* __WIGCPP_BATCH__ */
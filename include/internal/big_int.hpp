@@ -9,6 +9,7 @@
 
 #ifndef __WIGCPP_BIG_INT__
 #define __WIGCPP_BIG_INT__
+#include "internal/big_nat.hpp"
 #include "internal/definitions.hpp"
 #include "internal/vector.hpp"
 #include <cstddef>
@@ -17,7 +18,7 @@
 namespace wigcpp::internal::mwi {
 class big_int {
 private:
-  container::vector<def::uword_t> data;
+  word_vector data;
 
   static inline auto add_kernel(def::uword_t src1, def::uword_t src2, def::uword_t carry) noexcept {
     def::udword_t s = static_cast<def::udword_t>(src1), t = static_cast<def::udword_t>(src2),
@@ -45,6 +46,13 @@ private:
     return std::pair<def::uword_t, def::uword_t>(product, from_lower_out);
   }
 
+  /* the operations on a signed or natural rhs, whose words past its size are rhs_sign_bits */
+  big_int &add(const word_vector &rhs, def::uword_t rhs_sign_bits) noexcept;
+
+  big_int &sub(const word_vector &rhs, def::uword_t rhs_sign_bits) noexcept;
+
+  static big_int multiply(const word_vector &src, const word_vector &factor, def::uword_t factor_sign_bits) noexcept;
+
 public:
   big_int() noexcept {
     data.reserve(8);
@@ -60,7 +68,7 @@ public:
   big_int(std::size_t size, def::uword_t init_value) noexcept : data(size, init_value) {
   }
 
-  explicit big_int(container::vector<def::uword_t> &&vec) noexcept : data(std::move(vec)) {
+  explicit big_int(word_vector &&vec) noexcept : data(std::move(vec)) {
   }
 
   std::size_t size() const noexcept {
@@ -75,6 +83,15 @@ public:
     return data.back() & def::sign_bit;
   }
 
+  bool is_zero() const noexcept {
+    for (std::size_t i = 0; i < size(); ++i) {
+      if (data[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   bool is_single_word() const noexcept {
     if (size() == 1) {
       return true;
@@ -82,7 +99,8 @@ public:
     return false;
   }
 
-  std::pair<def::double_type, int> to_floating_point() const noexcept;
+  /* instantiated for double and long double */
+  template <typename Float = def::double_type> std::pair<Float, int> to_floating_point() const noexcept;
 
   const def::uword_t &operator[](std::size_t index) const noexcept {
     return data[index];
@@ -103,18 +121,38 @@ public:
     return *this;
   }
 
+  /* assigns a signed double word, a named function since an overload of operator= would make assigning int literals
+   * ambiguous */
+  big_int &assign(def::dword_t v) noexcept {
+    const auto low = static_cast<def::uword_t>(v);
+    const auto high = static_cast<def::uword_t>(static_cast<def::udword_t>(v) >> def::shift_bits);
+    if (high == def::full_sign_word(low)) {
+      return *this = low;
+    }
+    data.resize(2);
+    data[0] = low;
+    data[1] = high;
+    return *this;
+  }
+
   big_int &operator+=(def::uword_t scalar) noexcept;
 
   big_int &operator+=(const big_int &rhs) noexcept;
 
+  big_int &operator+=(const big_nat &rhs) noexcept;
+
   big_int &operator-=(def::uword_t scalar) noexcept;
 
   big_int &operator-=(const big_int &rhs) noexcept;
 
+  big_int &operator-=(const big_nat &rhs) noexcept;
+
   big_int &operator*=(def::uword_t factor) noexcept;
 
   big_int &operator*=(const big_int &rhs) noexcept;
 
+  big_int &operator*=(const big_nat &rhs) noexcept;
+
   [[nodiscard]] big_int operator-() const noexcept;
 
   friend big_int operator+(const big_int &src, def::uword_t scalar) noexcept;
@@ -135,6 +173,8 @@ public:
 
   friend big_int operator*(const big_int &src, const big_int &factor) noexcept;
 
+  friend big_int operator*(const big_int &src, const big_nat &factor) noexcept;
+
   big_int &operator++() noexcept {
     *this += 1;
     return *this;
@@ -159,5 +199,29 @@ public:
 
   std::string to_hex_str() const;
 };
+
+/* An alternating sum of natural numbers, kept as the sum of the added terms and the sum of the subtracted ones in
+ * words allocated up front. A term then costs one carry chain over its own words, without sign words or growth, and
+ * the sign is resolved once by result. */
+class big_sum {
+  word_vector pos;
+  word_vector neg;
+
+  static void accumulate(word_vector &sum, const big_nat &term) noexcept;
+
+public:
+  /* zero, for sums of terms whose total, added or subtracted, fits in words */
+  void reset(std::size_t words) noexcept;
+
+  void add(const big_nat &term) noexcept {
+    accumulate(pos, term);
+  }
+
+  void sub(const big_nat &term) noexcept {
+    accumulate(neg, term);
+  }
+
+  void result(big_int &sum) const noexcept;
+};
 } // namespace wigcpp::internal::mwi
 #endif /* __WIGCPP_BIG_INT__ */
\ No newline at end of file
@@ -0,0 +1,84 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_BIG_NAT__
+#define __WIGCPP_BIG_NAT__
+#include "internal/definitions.hpp"
+#include "internal/vector.hpp"
+#include "internal/word_arena.hpp"
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace wigcpp::internal::mwi {
+class big_int;
+
+/* the words of big numbers, from the word_arena of the computation context */
+using word_vector = container::vector<def::uword_t, allocator::arena_allocator<def::uword_t>>;
+
+/* A natural number in unsigned words from the lowest one, without leading zero words but for zero itself. The
+ * products of prime powers are never negative, so they skip the sign words and sign extension of big_int. */
+class big_nat {
+private:
+  friend class big_int;
+  friend big_int operator*(const big_int &src, const big_nat &factor) noexcept;
+
+  word_vector data;
+
+public:
+  big_nat() noexcept {
+    data.reserve(8);
+    data.resize(1, 0);
+  }
+
+  big_nat(def::uword_t init_value) noexcept {
+    data.reserve(8);
+    data.resize(1, 0);
+    data[0] = init_value;
+  }
+
+  std::size_t size() const noexcept {
+    return data.size();
+  }
+
+  std::size_t capacity() const noexcept {
+    return data.capacity();
+  }
+
+  bool is_zero() const noexcept {
+    return size() == 1 && !data[0];
+  }
+
+  bool is_single_word() const noexcept {
+    return size() == 1;
+  }
+
+  /* instantiated for double and long double */
+  template <typename Float = def::double_type> std::pair<Float, int> to_floating_point() const noexcept;
+
+  const def::uword_t &operator[](std::size_t index) const noexcept {
+    return data[index];
+  }
+
+  big_nat &operator=(def::uword_t v) noexcept {
+    data.resize(1);
+    data[0] = v;
+    return *this;
+  }
+
+  big_nat &operator*=(def::uword_t factor) noexcept;
+
+  big_nat &operator*=(const big_nat &rhs) noexcept;
+
+  friend big_nat operator*(const big_nat &src, const big_nat &factor) noexcept;
+
+  std::string to_hex_str() const;
+};
+} // namespace wigcpp::internal::mwi
+#endif /* __WIGCPP_BIG_NAT__ */
@@ -93,8 +93,8 @@ public:
 
 class Calculator {
 
-  static void delta_coeff(const GlobalFactorialPool &pool, int two_a, int two_b, int two_c, exp_t *prefact_fpf,
-                          std::uint32_t &used) noexcept;
+  static void delta_coeff(const GlobalFactorialPool &pool, TempStorage &csi, int two_a, int two_b, int two_c,
+                          exp_t *prefact_fpf, std::uint32_t &used) noexcept;
 
   static void calcsum_cg(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_m1, int two_j2,
                          int two_m2, int two_J, int two_M) noexcept;
@@ -102,6 +102,10 @@ class Calculator {
   static void calcsum_3j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3,
                          int two_m1, int two_m2, int two_m3) noexcept;
 
+  /* (j1 j2 j3; 0 0 0) in closed form, the caller has excluded odd j1 + j2 + j3 */
+  static void calcsum_3j_m0(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2,
+                            int two_j3) noexcept;
+
   static void factor_6j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3,
                         int two_j4, int two_j5, int two_j6, exp_t *min_nume_fpf, std::uint32_t &used,
                         mwi::big_int &sum_prod) noexcept;
@@ -112,24 +116,43 @@ class Calculator {
   static void calcsum_9j(const GlobalFactorialPool &pool, TempStorage &csi, int two_a, int two_b, int two_c, int two_d,
                          int two_e, int two_f, int two_g, int two_h, int two_i) noexcept;
 
-  static void split_sqrt_add(const global::PrimeTable &prime_table, exp_t *src_dest_fpf, std::uint32_t &used_src,
-                             mwi::big_int &big_sqrt, exp_t *add_fpf, std::uint32_t &used_add) noexcept;
+  /* the terms two_k = two_k_first, two_k_first + two_k_step, ... up to two_k_last of the 9j sum, into sum_prod over
+   * the exponents in min_nume */
+  static void sum_9j_range(const GlobalFactorialPool &pool, TempStorage &csi, int two_a, int two_b, int two_c,
+                           int two_d, int two_e, int two_f, int two_g, int two_h, int two_i, int two_k_first,
+                           int two_k_last, int two_k_step) noexcept;
 
-  static def::double_type eval_calcsum_info(const global::PrimeTable &prime_table, TempStorage &csi) noexcept;
+  /* adds the partial 9j sum of from to the one of into, as the k loop adds a term */
+  static void merge_9j(const global::PrimeTable &prime_table, TempStorage &into, TempStorage &from) noexcept;
 
-public:
-  static def::double_type calc_cg(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2,
-                                  int two_m1, int two_m2, int two_J, int two_M) noexcept;
+  /* a 9j symbol with a zero entry reduces to a single 6j symbol */
+  static void calcsum_9j_zero(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3,
+                              int two_j4, int two_j5, int two_j6, int two_j7, int two_j8, int two_j9) noexcept;
 
-  static def::double_type calc_3j(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2,
-                                  int two_j3, int two_m1, int two_m2, int two_m3) noexcept;
+  static void split_sqrt_add(const global::PrimeTable &prime_table, exp_t *src_dest_fpf, std::uint32_t &used_src,
+                             mwi::big_nat &big_sqrt, exp_t *add_fpf, std::uint32_t &used_add) noexcept;
 
-  static def::double_type calc_6j(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2,
-                                  int two_j3, int two_j4, int two_j5, int two_j6) noexcept;
+  template <typename Float>
+  static Float eval_calcsum_info(const global::PrimeTable &prime_table, TempStorage &csi) noexcept;
 
-  static def::double_type calc_9j(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2,
-                                  int two_j3, int two_j4, int two_j5, int two_j6, int two_j7, int two_j8,
-                                  int two_j9) noexcept;
+public:
+  /* Float is double or long double. The default, def::eval_type, is the precision behind the double API; long double
+   * backs the long double API. */
+  template <typename Float = def::eval_type>
+  static Float calc_cg(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_m1,
+                       int two_m2, int two_J, int two_M) noexcept;
+
+  template <typename Float = def::eval_type>
+  static Float calc_3j(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3,
+                       int two_m1, int two_m2, int two_m3) noexcept;
+
+  template <typename Float = def::eval_type>
+  static Float calc_6j(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3,
+                       int two_j4, int two_j5, int two_j6) noexcept;
+
+  template <typename Float = def::eval_type>
+  static Float calc_9j(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3,
+                       int two_j4, int two_j5, int two_j6, int two_j7, int two_j8, int two_j9) noexcept;
 };
 } // namespace wigcpp::internal::calc
 #endif /* __WIGCPP_CALC__*/
\ No newline at end of file
@@ -0,0 +1,65 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_DEDUP__
+#define __WIGCPP_DEDUP__
+
+#include "internal/vector.hpp"
+#include <cstddef>
+
+namespace wigcpp::internal::dedup {
+
+/* The distinct symbols of a batch up to symmetry. Every symbol is reduced to the canonical form of its symmetry class
+ * as the result cache does, and the classes are hashed within the batch only. A representative of a class has the same
+ * value as every member, bit for bit, up to the sign.
+ */
+struct UniqueSymbols {
+  /* arguments of the representatives, 6 or 9 per symbol in the order of first occurrence */
+  container::vector<int> two_j;
+  /* per symbol of the batch, its representative and its sign, 0 for a trivial zero */
+  container::vector<std::size_t> index;
+  container::vector<signed char> sign;
+  int args;
+
+  std::size_t size() const noexcept {
+    return two_j.size() / args;
+  }
+};
+
+/* count symbols of wigner_type (3, 6 or 9) in two_j, in the order of wigner3j, wigner6j or wigner9j */
+UniqueSymbols unique_symbols(int wigner_type, const int *two_j, std::size_t count) noexcept;
+
+/* the results of the batch from those of the representatives */
+void scatter(const UniqueSymbols &unique, const double *unique_results, double *results) noexcept;
+
+/* Off by default: the reduction costs about as much as a small symbol, and the value of a class may differ from that of
+ * another member in the last bit. */
+void set_enabled(bool enable) noexcept;
+
+bool enabled() noexcept;
+
+/* evaluates the distinct symbols of a batch with eval(two_j, count, results) and scatters their results, or the whole
+ * batch while deduplication is off */
+template <typename Eval>
+void eval_unique(int wigner_type, const int *two_j, std::size_t count, double *results, Eval &&eval) noexcept {
+  if (!enabled()) {
+    eval(two_j, count, results);
+    return;
+  }
+  const auto unique = unique_symbols(wigner_type, two_j, count);
+  /* resized, as a vector of size 0 can't be allocated */
+  container::vector<double> unique_results;
+  unique_results.resize(unique.size());
+  eval(unique.two_j.data(), unique.size(), unique_results.data());
+  scatter(unique, unique_results.data(), results);
+}
+
+} // namespace wigcpp::internal::dedup
+
+#endif /* __WIGCPP_DEDUP__ */
@@ -33,6 +33,14 @@ constexpr inline bool has_long_double = false;
 
 using double_type = std::conditional_t<has_long_double, long double, double>;
 
+/* type the double API evaluates in, the build option WIGCPP_DOUBLE_EVAL trades the extended precision of double_type
+ * for double arithmetic that stays in SSE2/AVX registers */
+#ifdef WIGCPP_DOUBLE_EVAL
+using eval_type = double;
+#else
+using eval_type = double_type;
+#endif
+
 /* definitions for single signed word and unsigned word */
 
 template <unsigned size> struct multi_word_traits {};
@@ -12,7 +12,15 @@
 
 #include <cstdlib>
 namespace wigcpp::internal::error {
-enum class ErrorCode { Bad_Alloc, TOO_LARGE_FACTORIAL, NOT_INITIALIZED, BAD_WIGNER_TYPE };
+enum class ErrorCode {
+  Bad_Alloc,
+  TOO_LARGE_FACTORIAL,
+  NOT_INITIALIZED,
+  BAD_WIGNER_TYPE,
+  OUT_OF_TABLE_RANGE,
+  BAD_MAX_TWO_J,
+  NULL_TABLE
+};
 
 [[noreturn]] void error_process(ErrorCode code) noexcept;
 
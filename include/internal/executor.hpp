@@ -0,0 +1,152 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_EXECUTOR__
+#define __WIGCPP_EXECUTOR__
+
+#include "internal/global_pool.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace wigcpp::internal::exec {
+using namespace wigcpp::internal::global;
+
+/* The predicted cost of a symbol of wigner_type, whose arguments are in the order of wigner3j, wigner6j or wigner9j:
+ * the terms of its sums times the used length of its largest factorial row, at least 1. */
+double symbol_cost(const GlobalFactorialPool &pool, int wigner_type, const int *two_j) noexcept;
+
+/* A pool of worker threads with work-stealing deques. The calling thread of run joins the workers as worker 0, so
+ * num_threads counts it. Chunk c goes to worker c % num_threads, which takes its chunks in increasing order, and once
+ * it has none left it steals the last ones of the others. Lower chunks thus start first, and the last chunks of a
+ * batch fill the gaps. Worker threads evaluate symbols with their own thread-local TempStorage, which lives as long as
+ * the executor.
+ */
+class Executor {
+  /* the slots [top, bottom) left to a worker, a Chase-Lev deque over the slots [first, first + count) that never
+   * grows. The owner takes the slot at bottom - 1 first, which holds its lowest chunk. */
+  struct alignas(64) Deque {
+    std::atomic<std::int64_t> top;
+    std::atomic<std::int64_t> bottom;
+    std::int64_t first;
+    std::int64_t count;
+  };
+
+  int num_workers;
+  std::unique_ptr<Deque[]> deques;
+  std::vector<std::thread> threads;
+
+  std::mutex run_mutex;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  std::uint64_t generation = 0;
+  int busy = 0;
+  bool stopping = false;
+
+  void (*task)(void *context, std::int64_t chunk) noexcept = nullptr;
+  void *context = nullptr;
+
+  std::int64_t chunk_at(int worker, std::int64_t slot) const noexcept {
+    const Deque &d = deques[worker];
+    return worker + num_workers * (d.first + d.count - 1 - slot);
+  }
+
+  bool pop(int worker, std::int64_t &chunk) noexcept;
+
+  bool steal(int worker, std::int64_t &chunk) noexcept;
+
+  void work(int worker) noexcept;
+
+  void loop(int worker, bool pin) noexcept;
+
+  void run_chunks(std::int64_t num_chunks, void (*fn)(void *, std::int64_t) noexcept, void *ctx) noexcept;
+
+public:
+  /* num_threads <= 0 for one per core. pin binds worker i to core i on Linux, and is ignored elsewhere. */
+  Executor(int num_threads, bool pin) noexcept;
+  ~Executor() noexcept;
+
+  Executor(const Executor &) = delete;
+  Executor &operator=(const Executor &) = delete;
+
+  int size() const noexcept {
+    return num_workers;
+  }
+
+  /* calls fn(chunk) for every chunk in [0, num_chunks), the lower ones first, and returns when all are done. Batches
+   * run one at a time. */
+  template <typename Fn> void run(std::int64_t num_chunks, Fn &&fn) noexcept {
+    using F = std::remove_reference_t<Fn>;
+    run_chunks(
+        num_chunks, [](void *ctx, std::int64_t chunk) noexcept { (*static_cast<F *>(ctx))(chunk); }, &fn);
+  }
+};
+
+/* The executor shared by the batches started on any thread. A batch holds a lease of it for as long as it runs. init
+ * and shutdown wait for the leases to end before they replace or stop it, and no lease starts while one of them waits. */
+class ExecutorManager {
+  inline static std::unique_ptr<Executor> ptr;
+  inline static std::mutex mutex;
+  inline static std::condition_variable idle;
+  inline static int leases = 0;
+  inline static bool replacing = false;
+
+  ExecutorManager() = delete;
+  ~ExecutorManager() = delete;
+
+  /* ends a lease */
+  static void put_back() noexcept;
+
+  /* replaces the executor by executor, once no lease is left */
+  static void replace(std::unique_ptr<Executor> executor) noexcept;
+
+public:
+  class lease {
+    Executor *executor;
+
+  public:
+    explicit lease(Executor &executor) noexcept : executor(&executor) {
+    }
+
+    ~lease() noexcept {
+      put_back();
+    }
+
+    lease(const lease &) = delete;
+    lease &operator=(const lease &) = delete;
+
+    Executor &operator*() const noexcept {
+      return *executor;
+    }
+  };
+
+  static void init(int num_threads, bool pin) noexcept;
+
+  static void shutdown() noexcept;
+
+  /* a lease of the executor, started with one thread per core if init was not called */
+  static lease get() noexcept;
+};
+
+/* count symbols of wigner_type in two_j, in the order of wigner3j, wigner6j or wigner9j, into results. The symbols are
+ * cut into chunks of about equal predicted cost, several per worker. The results are those of wigner3j, wigner6j and
+ * wigner9j without the result cache. */
+void eval_batch(Executor &executor, const GlobalFactorialPool &pool, int wigner_type, const int *two_j,
+                std::size_t count, double *results) noexcept;
+
+} // namespace wigcpp::internal::exec
+
+#endif /* __WIGCPP_EXECUTOR__ */
@@ -70,6 +70,18 @@ public:
     return factorial_pool.stride();
   }
 
+  /* bytes held by the prime list and the two tables */
+  std::size_t bytes() const noexcept {
+    return bytes(prime_table);
+  }
+
+  /* bytes of a pool with the primes of prime_table */
+  static std::size_t bytes(const PrimeTable &prime_table) noexcept {
+    const std::size_t rows = prime_table.max_factorial + 1;
+    return prime_table.num_primes * sizeof(std::uint32_t) +
+           2 * rows * (prime_table.stride * sizeof(exp_t) + sizeof(std::uint32_t));
+  }
+
   exp_t &operator()(std::uint32_t i, std::uint32_t j) noexcept {
     return factorial_pool.row(i)[j];
   }
@@ -82,8 +94,21 @@ class PoolManager {
   ~PoolManager() = delete;
 
 public:
+  /* the largest factorial of a pool for symbols of wigner_type up to max_two_j, at least 2 */
+  static std::uint32_t max_factorial(int max_two_j, int wigner_type) noexcept;
+
   static void ensure(int max_two_j, int wigner_type) noexcept;
 
+  /* a pool for exactly max_two_j and wigner_type, even if the present one is larger */
+  static void replace(int max_two_j, int wigner_type) noexcept;
+
+  static void release() noexcept;
+
+  /* the pool, or nullptr before ensure */
+  static const GlobalFactorialPool *current() noexcept {
+    return ptr.get();
+  }
+
   static const GlobalFactorialPool &get() noexcept;
 };
 
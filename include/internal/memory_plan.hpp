@@ -0,0 +1,49 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_MEMORY_PLAN__
+#define __WIGCPP_MEMORY_PLAN__
+
+#include <cstddef>
+
+namespace wigcpp::internal::memory {
+
+/* The memory of a configuration: the factorial pool, the thread-local storage of each of num_threads threads
+ * evaluating symbols up to max_two_j and of the kept_storages storages the free list keeps for new threads, and the
+ * result cache. A storage counts its exponent rows and the arena of its big integers at their largest; the stacks of
+ * the threads are left out. */
+struct Plan {
+  std::size_t pool_bytes;
+  std::size_t thread_bytes;
+  std::size_t cache_bytes;
+  int num_threads;
+  int kept_storages;
+
+  std::size_t total() const noexcept {
+    return pool_bytes + static_cast<std::size_t>(num_threads + kept_storages) * thread_bytes + cache_bytes;
+  }
+};
+
+/* the plan of a pool for symbols of wigner_type up to max_two_j, num_threads threads, 0 for one per core, and a cache
+ * of at most cache_bytes, 0 for none */
+Plan plan(int max_two_j, int wigner_type, int num_threads, std::size_t cache_bytes) noexcept;
+
+/* Sets up the pool for symbols of wigner_type up to max_two_j within budget bytes for num_threads threads. The present
+ * pool and cache stay if they fit. Otherwise the pool is replaced by the smallest one for these symbols, and an
+ * enabled cache is cut to what is left, or disabled if not even its smallest size fits. The free list then keeps only
+ * the storages that fit in the rest. Returns false and changes nothing if the pool and the storages of the threads
+ * alone exceed budget. */
+bool ensure_budget(int max_two_j, int wigner_type, int num_threads, std::size_t budget) noexcept;
+
+/* stops the executor and frees the cache, the storage of this thread, the kept storages and the pool */
+void release() noexcept;
+
+} // namespace wigcpp::internal::memory
+
+#endif /* __WIGCPP_MEMORY_PLAN__ */
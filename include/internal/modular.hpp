@@ -0,0 +1,50 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_MODULAR__
+#define __WIGCPP_MODULAR__
+
+#include "internal/big_int.hpp"
+#include "internal/global_pool.hpp"
+#include "internal/uniform_jagged_matrix.hpp"
+
+namespace wigcpp::internal::modular {
+using exp_t = def::prime::exp_t;
+using view_type = container::uniform_jagged_matrix<exp_t>::row_view;
+
+/* The terms of a Racah sum, t_k = prod (num_i + k)! / (prod (up_i + k)! prod (down_i - k)!) for 0 <= k <= k_lim, the
+ * term k taken with the sign (-1)^(k + sign) */
+struct racah_terms {
+  int k_lim;
+  int sign;
+  int num_count;
+  int up_count;
+  int down_count;
+  int num[1];
+  int up[4];
+  int down[3];
+};
+
+/* moduli below 2^62, enough for sums of up to 61 * (max_moduli - 1) - 1 bits */
+constexpr int max_moduli = 128;
+
+/* The sum of the terms divided by the prime factorization min_view, exactly, from its residues modulo primes just
+ * below 2^62. first is the factorization of t_0. Each residue runs a Horner scheme over the ratios of consecutive
+ * terms, which are products of a few small integers, so the sum costs a few modular products per term and modulus,
+ * independent of their size, and the moduli run side by side. The integer is reconstructed from the residues with
+ * Garner's algorithm. A sum that vanishes modulo all of them is zero, found without any big_int work.
+ *
+ * bits bounds the bits of the absolute value of the sum. Returns false, leaving sum_prod untouched, when the sum needs
+ * more than max_moduli moduli, when the factors of the ratios reach 2^21, or without 128-bit integers. */
+bool sum_terms(const global::PrimeTable &prime_table, view_type first, view_type min_view, const racah_terms &terms,
+               int bits, mwi::big_int &sum_prod) noexcept;
+
+} // namespace wigcpp::internal::modular
+
+#endif /* __WIGCPP_MODULAR__ */
@@ -0,0 +1,43 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_MWI_KERNELS__
+#define __WIGCPP_MWI_KERNELS__
+
+#include "internal/definitions.hpp"
+#include <cstddef>
+
+namespace wigcpp::internal::mwi::kernel {
+using def::uword_t;
+
+/* The word loops of big_int, over n >= 1 unsigned words from the lowest one. rp may be up or vp. The generic kernels
+ * carry through double words, the adx kernels through the carry flag with mulx, on x86-64 CPUs with ADX and BMI2.
+ */
+struct Kernels {
+  /* rp = up + vp + carry, returns the carry out */
+  uword_t (*add_n)(uword_t *rp, const uword_t *up, const uword_t *vp, std::size_t n, uword_t carry) noexcept;
+  /* rp = up - vp - borrow, returns the borrow out */
+  uword_t (*sub_n)(uword_t *rp, const uword_t *up, const uword_t *vp, std::size_t n, uword_t borrow) noexcept;
+  /* rp = up * v, returns the high word */
+  uword_t (*mul_1)(uword_t *rp, const uword_t *up, std::size_t n, uword_t v) noexcept;
+  /* rp += up * v, returns the high word */
+  uword_t (*addmul_1)(uword_t *rp, const uword_t *up, std::size_t n, uword_t v) noexcept;
+};
+
+const Kernels &generic() noexcept;
+
+/* null unless the running CPU supports ADX and BMI2 */
+const Kernels *adx() noexcept;
+
+/* the kernels big_int uses, chosen once */
+const Kernels &native() noexcept;
+
+} // namespace wigcpp::internal::mwi::kernel
+
+#endif /* __WIGCPP_MWI_KERNELS__ */
@@ -9,10 +9,75 @@
 
 #ifndef __WIGCPP_NOTHROW_ALLOCATOR__
 #define __WIGCPP_NOTHROW_ALLOCATOR__
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <new>
 namespace wigcpp::internal::allocator {
+
+/* The functions every block of wigcpp comes from, malloc and the aligned operator new unless set replaces them. A block
+ * goes back to the functions that allocated it, so they are only replaced while no block is live. */
+class hooks {
+public:
+  using alloc_fn = void *(*)(std::size_t size, std::size_t alignment, void *user);
+  using free_fn = void (*)(void *p, std::size_t size, std::size_t alignment, void *user);
+
+private:
+  inline static std::atomic<alloc_fn> alloc_hook{nullptr};
+  inline static std::atomic<free_fn> free_hook{nullptr};
+  inline static std::atomic<void *> user_data{nullptr};
+  inline static std::atomic<std::int64_t> live{0};
+
+  hooks() = delete;
+  ~hooks() = delete;
+
+public:
+  /* replaces the functions, or restores the defaults if either is nullptr, and returns false without a change while
+   * blocks are live. Called on the main thread with no calculation running. */
+  static bool set(alloc_fn alloc, free_fn dealloc, void *user) noexcept {
+    if (live.load(std::memory_order_acquire)) {
+      return false;
+    }
+    const bool custom = alloc && dealloc;
+    alloc_hook.store(custom ? alloc : nullptr, std::memory_order_relaxed);
+    free_hook.store(custom ? dealloc : nullptr, std::memory_order_relaxed);
+    user_data.store(custom ? user : nullptr, std::memory_order_relaxed);
+    return true;
+  }
+
+  /* the blocks not yet freed */
+  static std::int64_t live_blocks() noexcept {
+    return live.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] static void *allocate(std::size_t size, std::size_t alignment) noexcept {
+    void *p;
+    if (const alloc_fn alloc = alloc_hook.load(std::memory_order_relaxed)) {
+      p = alloc(size, alignment, user_data.load(std::memory_order_relaxed));
+    } else if (alignment > alignof(std::max_align_t)) {
+      p = ::operator new(size, std::align_val_t{alignment}, std::nothrow);
+    } else {
+      p = std::malloc(size);
+    }
+    if (p) {
+      live.fetch_add(1, std::memory_order_relaxed);
+    }
+    return p;
+  }
+
+  static void deallocate(void *p, std::size_t size, std::size_t alignment) noexcept {
+    live.fetch_sub(1, std::memory_order_relaxed);
+    if (const free_fn dealloc = free_hook.load(std::memory_order_relaxed)) {
+      dealloc(p, size, alignment, user_data.load(std::memory_order_relaxed));
+    } else if (alignment > alignof(std::max_align_t)) {
+      ::operator delete(p, std::align_val_t{alignment}, std::nothrow);
+    } else {
+      std::free(p);
+    }
+  }
+};
+
 template <typename T, std::size_t Alignment = alignof(T)> class nothrow_allocator {
   static_assert(Alignment > 0, "Alignment must be greater than 0");
   static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
@@ -25,35 +90,13 @@ public:
   [[nodiscard]] value_type *allocate(std::size_t n) noexcept {
     if (n == 0)
       return nullptr;
-
-    constexpr std::size_t alignof_T = alignof(value_type);
-    const std::size_t size = n * sizeof(value_type);
-
-    if constexpr (Alignment > alignof_T) {
-      return static_cast<value_type *>(::operator new(size, std::align_val_t{Alignment}, std::nothrow));
-    } else if constexpr (alignof_T > alignof(std::max_align_t)) {
-      return static_cast<value_type *>(::operator new(size, std::align_val_t{alignof_T}, std::nothrow));
-    } else {
-      return static_cast<value_type *>(std::malloc(size));
-    }
+    return static_cast<value_type *>(hooks::allocate(n * sizeof(value_type), Alignment));
   }
 
   void deallocate(value_type *p, std::size_t n) noexcept {
-    (void)n;
     if (!p)
       return;
-    constexpr std::size_t alignof_T = alignof(value_type);
-
-    if constexpr (Alignment > alignof_T) {
-      ::operator delete(static_cast<void *>(p), std::align_val_t{Alignment}, std::nothrow);
-      return;
-    } else if constexpr (alignof_T > alignof(std::max_align_t)) {
-      ::operator delete(static_cast<void *>(p), std::align_val_t{alignof_T}, std::nothrow);
-      return;
-    } else {
-      std::free(static_cast<void *>(p));
-      return;
-    }
+    hooks::deallocate(static_cast<void *>(p), n * sizeof(value_type), Alignment);
   }
 };
 
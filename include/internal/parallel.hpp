@@ -0,0 +1,86 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_PARALLEL__
+#define __WIGCPP_PARALLEL__
+
+#include <thread>
+#include <vector>
+
+namespace wigcpp::internal::parallel {
+
+/* Splitting the sum of a single symbol over threads. It is off by default, set_sum_threads(n) lets a symbol use up to
+ * n threads, 0 for one per core. A part of a split sum never splits again, so a 9j symbol doesn't split the 6j sums of
+ * its terms. */
+void set_sum_threads(int num_threads) noexcept;
+
+/* the parts to split count items into, at least min_per_part items each, 1 inside a part or while splitting is off */
+int parts(int count, int min_per_part) noexcept;
+
+class PartScope {
+  static inline thread_local bool active = false;
+  bool outer;
+
+public:
+  PartScope() noexcept : outer(active) {
+    active = true;
+  }
+
+  ~PartScope() noexcept {
+    active = outer;
+  }
+
+  PartScope(const PartScope &) = delete;
+  PartScope &operator=(const PartScope &) = delete;
+
+  static bool inside() noexcept {
+    return active;
+  }
+};
+
+/* runs fn(part) for part in [0, num_parts), part 0 on the calling thread. Parts whose thread can't be started, for
+ * lack of memory or of threads, run on the calling thread after part 0. */
+template <typename Fn> void run_parts(int num_parts, Fn &&fn) noexcept {
+  auto worker = [&](int part) {
+    PartScope scope;
+    fn(part);
+  };
+
+  std::vector<std::thread> threads;
+  int started = 1;
+  try {
+    threads.reserve(num_parts - 1);
+    for (; started < num_parts; ++started) {
+      threads.emplace_back(worker, started);
+    }
+  } catch (...) {
+  }
+  worker(0);
+  for (int i = started; i < num_parts; ++i) {
+    worker(i);
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+}
+
+/* merges the results of num_parts parts pairwise into part 0, merge(into, from) with into < from. The merges of a
+ * level are independent and run in parallel, the parts keep their order so merge may be non-commutative. */
+template <typename Merge> void tree_reduce(int num_parts, Merge &&merge) noexcept {
+  for (int step = 1; step < num_parts; step *= 2) {
+    const int pairs = (num_parts - step + 2 * step - 1) / (2 * step);
+    run_parts(pairs, [&](int pair) {
+      merge(2 * step * pair, 2 * step * pair + step);
+    });
+  }
+}
+
+} // namespace wigcpp::internal::parallel
+
+#endif /* __WIGCPP_PARALLEL__ */
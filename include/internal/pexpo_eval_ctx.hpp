@@ -10,7 +10,7 @@
 #ifndef __WIGCPP_PRIME_FACTOR__
 #define __WIGCPP_PRIME_FACTOR__
 
-#include "internal/big_int.hpp"
+#include "internal/big_nat.hpp"
 #include "internal/definitions.hpp"
 #include "internal/global_pool.hpp"
 #include <array>
@@ -20,21 +20,66 @@
 namespace wigcpp::internal::prime {
 using exp_t = wigcpp::internal::def::prime::exp_t;
 using namespace wigcpp::internal::container;
+/* Fixed-width counterparts of pexpo_eval_temp::evaluate and evaluate2, the caller makes sure the products fit. Each
+ * square taken is then a factor of a product and can't overflow either */
+template <typename UInt> inline UInt pow_fixed(UInt up, exp_t fpf) noexcept {
+  UInt fact = 1;
+  for (;;) {
+    if (fpf & 1) {
+      fact *= up;
+    }
+    fpf >>= 1;
+    if (!fpf) {
+      return fact;
+    }
+    up *= up;
+  }
+}
+
+template <typename UInt>
+inline UInt evaluate_fixed(const global::PrimeTable &prime_table,
+                           uniform_jagged_matrix<exp_t>::row_view in_fpf) noexcept {
+  UInt prod = 1;
+  for (auto i = 0u; i < in_fpf.used; ++i) {
+    const exp_t fpf = in_fpf.ptr[i];
+    assert(fpf >= 0);
+    if (fpf) {
+      prod *= pow_fixed<UInt>(prime_table.prime_list[i], fpf);
+    }
+  }
+  return prod;
+}
+
+template <typename UInt>
+inline void evaluate2_fixed(const global::PrimeTable &prime_table, UInt &prod_pos, UInt &prod_neg,
+                            uniform_jagged_matrix<exp_t>::row_view in_fpf) noexcept {
+  prod_pos = 1;
+  prod_neg = 1;
+  for (auto i = 0u; i < in_fpf.used; ++i) {
+    const exp_t fpf = in_fpf.ptr[i];
+    if (fpf > 0) {
+      prod_pos *= pow_fixed<UInt>(prime_table.prime_list[i], fpf);
+    } else if (fpf < 0) {
+      prod_neg *= pow_fixed<UInt>(prime_table.prime_list[i], -fpf);
+    }
+  }
+}
+
 class pexpo_eval_temp {
-  std::array<mwi::big_int, 2> prod_pos;
-  std::array<mwi::big_int, 2> prod_neg;
-  std::array<mwi::big_int, 2> factor;
-  std::array<mwi::big_int, 2> big_up;
+  std::array<mwi::big_nat, 2> prod_pos;
+  std::array<mwi::big_nat, 2> prod_neg;
+  std::array<mwi::big_nat, 2> factor;
+  std::array<mwi::big_nat, 2> big_up;
 
   int compute_prime_factor(std::int64_t prime, exp_t fpf) noexcept;
 
-  int merge_factor(int factor_active, int active, std::array<mwi::big_int, 2> &prod) noexcept;
+  int merge_factor(int factor_active, int active, std::array<mwi::big_nat, 2> &prod) noexcept;
 
 public:
-  void evaluate(const global::PrimeTable &prime_table, mwi::big_int &big_prod,
+  void evaluate(const global::PrimeTable &prime_table, mwi::big_nat &big_prod,
                 uniform_jagged_matrix<exp_t>::row_view in_fpf) noexcept;
 
-  void evaluate2(const global::PrimeTable &prime_table, mwi::big_int &big_prod_pos, mwi::big_int &big_prod_neg,
+  void evaluate2(const global::PrimeTable &prime_table, mwi::big_nat &big_prod_pos, mwi::big_nat &big_prod_neg,
                  uniform_jagged_matrix<exp_t>::row_view in_fpf) noexcept;
 
   void reset() noexcept;
@@ -47,6 +47,15 @@ inline void reset_row(exp_t *data, std::uint32_t &used) noexcept {
   used = 0;
 }
 
+/* rows are zero beyond used, which ensure_used relies on, so a row that is overwritten with fewer entries clears the
+ * entries it drops */
+inline void set_used(exp_t *data, std::uint32_t &used, std::uint32_t n) noexcept {
+  if (n < used) {
+    std::memset(data + n, 0, (used - n) * sizeof(exp_t));
+  }
+  used = n;
+}
+
 inline void ensure_used(std::uint32_t &used, std::uint32_t n) noexcept {
   if (used >= n) {
     return;
@@ -55,7 +64,7 @@ inline void ensure_used(std::uint32_t &used, std::uint32_t n) noexcept {
 }
 
 inline void fill_max(exp_t *data, std::uint32_t &used, std::uint32_t n) noexcept {
-  used = n;
+  set_used(data, used, n);
   std::fill(data, data + n, def::prime::max_exp);
 }
 
@@ -78,7 +87,7 @@ inline void store_min_and_diff(exp_t *__restrict data, std::uint32_t used, exp_t
 }
 
 inline void copy(exp_t *__restrict data, std::uint32_t &used, view_type view) noexcept {
-  used = view.used;
+  set_used(data, used, view.used);
   std::memcpy(data, view.ptr, used * sizeof(exp_t));
 }
 
@@ -94,7 +103,7 @@ inline void expand_sub(exp_t *__restrict data, std::uint32_t &used, view_type vi
 
 inline void sum3(exp_t *__restrict data, std::uint32_t &used, view_type v1, view_type v2, view_type v3) noexcept {
   const auto max_used = std::max({v1.used, v2.used, v3.used});
-  used = max_used;
+  set_used(data, used, max_used);
   for (auto i = 0u; i < used; ++i) {
     exp_t val = (i < v1.used ? v1.ptr[i] : 0);
     val += (i < v2.used ? v2.ptr[i] : 0);
@@ -125,14 +134,14 @@ inline void add_sub3(exp_t *__restrict data, std::uint32_t used, view_type v1, v
 
 inline void sum_sub7(exp_t *__restrict data, std::uint32_t &used, view_type v1, view_type v2, view_type v3,
                      view_type v4, view_type v5, view_type v6, view_type v7, view_type v8, std::uint32_t num) noexcept {
-  used = num;
+  set_used(data, used, num);
   sum<OP::add, OP::sub, OP::sub, OP::sub, OP::sub, OP::sub, OP::sub, OP::sub>(data, num, v1, v2, v3, v4, v5, v6, v7,
                                                                               v8);
 }
 
 inline void sub6(exp_t *__restrict data, std::uint32_t &used, view_type v1, view_type v2, view_type v3, view_type v4,
                  view_type v5, view_type v6, std::uint32_t num) noexcept {
-  used = num;
+  set_used(data, used, num);
   sum<OP::sub, OP::sub, OP::sub, OP::sub, OP::sub, OP::sub>(data, num, v1, v2, v3, v4, v5, v6);
 }
 
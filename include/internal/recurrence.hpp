@@ -0,0 +1,36 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_RECURRENCE__
+#define __WIGCPP_RECURRENCE__
+
+namespace wigcpp::internal::recurrence {
+
+/* Whole families of symbols in floating point from the three-term recurrences of Schulten and Gordon, without the
+ * factorial pool. The recurrence runs forward from the lower end of the family through the classically allowed region
+ * and backward from the upper end, the two solutions are matched by least squares where they meet, normalized with the
+ * orthogonality sum and signed from the phase of the stretched symbol at the upper end.
+ *
+ * Each function returns the number of symbols in the family, 0 if it is empty, and stores the two_j or two_m of its
+ * first member in two_min. results receives the symbols in increasing order of the free argument and may be null to
+ * query the size only.
+ */
+
+/* (j1 j2 j3; m1 m2 m3) over j1, with m1 = -m2 - m3 */
+int family_3j_j(int two_j2, int two_j3, int two_m2, int two_m3, int &two_min, double *results) noexcept;
+
+/* (j1 j2 j3; m1 m2 m3) over m2, with m3 = -m1 - m2 */
+int family_3j_m(int two_j1, int two_j2, int two_j3, int two_m1, int &two_min, double *results) noexcept;
+
+/* {j1 j2 j3; j4 j5 j6} over j1 */
+int family_6j(int two_j2, int two_j3, int two_j4, int two_j5, int two_j6, int &two_min, double *results) noexcept;
+
+} // namespace wigcpp::internal::recurrence
+
+#endif /* __WIGCPP_RECURRENCE__ */
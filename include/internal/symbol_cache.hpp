@@ -0,0 +1,121 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_SYMBOL_CACHE__
+#define __WIGCPP_SYMBOL_CACHE__
+
+#include "internal/global_pool.hpp"
+#include "internal/tmp_pool.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace wigcpp::internal::cache {
+using namespace wigcpp::internal::global;
+using namespace wigcpp::internal::tmp;
+
+/* 128-bit key of a canonical symbol, the top two bits of hi hold the symbol type, so {0, 0} marks an empty slot */
+struct CacheKey {
+  std::uint64_t lo;
+  std::uint64_t hi;
+};
+
+struct CacheStats {
+  std::uint64_t hits;
+  std::uint64_t misses;
+};
+
+/* Lock-free set-associative result cache. Every shard is a small set of slots with its own CLOCK hand; readers
+ * validate slots with a per-slot sequence number, writers claim a slot with a CAS and simply give up on contention.
+ */
+class SymbolCache {
+  static constexpr std::uint32_t ways = 8;
+
+  struct Slot {
+    std::atomic<std::uint64_t> seq;
+    std::atomic<std::uint64_t> key_lo;
+    std::atomic<std::uint64_t> key_hi;
+    std::atomic<std::uint64_t> value;
+    std::atomic<std::uint32_t> referenced;
+  };
+
+  struct alignas(64) Shard {
+    std::atomic<std::uint32_t> hand;
+    Slot slots[ways];
+  };
+
+  Shard *shards;
+  std::size_t num_shards;
+
+  Shard &shard_of(const CacheKey &key) noexcept;
+
+  bool find(const CacheKey &key, double &value) noexcept;
+
+  void insert(const CacheKey &key, double value) noexcept;
+
+public:
+  explicit SymbolCache(std::size_t max_bytes) noexcept;
+  ~SymbolCache() noexcept;
+
+  SymbolCache(const SymbolCache &) = delete;
+  SymbolCache &operator=(const SymbolCache &) = delete;
+
+  std::size_t bytes() const noexcept {
+    return num_shards * sizeof(Shard);
+  }
+
+  static constexpr std::size_t bytes_per_shard() noexcept {
+    return sizeof(Shard);
+  }
+
+  /* the shards of a cache of at most max_bytes, a power of two and at least one */
+  static constexpr std::size_t shards_for(std::size_t max_bytes) noexcept {
+    std::size_t num_shards = 1;
+    while (num_shards * 2 * sizeof(Shard) <= max_bytes) {
+      num_shards *= 2;
+    }
+    return num_shards;
+  }
+
+  double calc_3j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3, int two_m1,
+                 int two_m2, int two_m3) noexcept;
+
+  double calc_6j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3, int two_j4,
+                 int two_j5, int two_j6) noexcept;
+
+  double calc_9j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3, int two_j4,
+                 int two_j5, int two_j6, int two_j7, int two_j8, int two_j9) noexcept;
+};
+
+class CacheManager {
+  inline static std::unique_ptr<SymbolCache> ptr;
+  static inline thread_local CacheStats stats{0, 0};
+
+  CacheManager() = delete;
+  ~CacheManager() = delete;
+
+public:
+  /* a new cache of at most max_bytes, or none if max_bytes can't hold a shard */
+  static void enable(std::size_t max_bytes) noexcept;
+
+  static void disable() noexcept;
+
+  static SymbolCache *get() noexcept {
+    return ptr.get();
+  }
+
+  static CacheStats &thread_stats() noexcept {
+    return stats;
+  }
+};
+
+} // namespace wigcpp::internal::cache
+
+#endif /* __WIGCPP_SYMBOL_CACHE__ */
@@ -0,0 +1,170 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_SYMMETRY__
+#define __WIGCPP_SYMMETRY__
+
+#include <array>
+#include <utility>
+
+namespace wigcpp::internal::symmetry {
+
+/* Reduction of 3j, 6j and 9j arguments to a canonical representative of their symmetry class.
+ *
+ * 3j: the Regge square R of a 3j symbol can always be written as R[i][j] = e[(j - i) % 3] + o[(i + j) % 3].
+ *     Permuting e or o is an even symmetry (sign +1), swapping e and o is an odd one (sign (-1)^J). With e and o
+ *     sorted, the path R00 <= R01 <= R11 <= R21 <= R22 of the sorted addition table determines the symbol, so the
+ *     72 Regge symmetries collapse to one non-decreasing 5-chain. The chain top is the largest Regge entry, which
+ *     never exceeds max_two_j.
+ *
+ * 6j: the Racah sum and the triangle coefficients only depend on the multisets of the four triads {alpha} and the
+ *     three quads {beta}, so the 144 Regge/tetrahedral symmetries have no sign. With both sorted, the path
+ *     beta1-alpha4 <= beta1-alpha3 <= beta1-alpha2 <= beta1-alpha1 <= beta2-alpha1 <= beta3-alpha1 through the
+ *     Regge array is a 6-chain whose consecutive differences are free, again topped by the largest Regge entry.
+ *
+ * 9j: the 72 row/column permutations and the transposition, odd permutations carrying (-1)^(sum of j). The
+ *     canonical form is the lexicographically smallest matrix of the orbit.
+ *
+ * All functions expect arguments which passed TrivialZero, i.e. all triangle sums are even and non-negative.
+ */
+
+struct canonical_3j {
+  std::array<int, 5> chain;
+  int sign;
+};
+
+struct canonical_6j {
+  std::array<int, 6> chain;
+};
+
+struct canonical_9j {
+  std::array<int, 9> two_j;
+  int sign;
+};
+
+namespace detail {
+constexpr void sort3(std::array<int, 3> &v) noexcept {
+  if (v[0] > v[1])
+    std::swap(v[0], v[1]);
+  if (v[1] > v[2])
+    std::swap(v[1], v[2]);
+  if (v[0] > v[1])
+    std::swap(v[0], v[1]);
+}
+
+constexpr void sort4(std::array<int, 4> &v) noexcept {
+  for (int i = 1; i < 4; ++i) {
+    for (int j = i; j > 0 && v[j - 1] > v[j]; --j) {
+      std::swap(v[j - 1], v[j]);
+    }
+  }
+}
+
+/* the six permutations of {0, 1, 2}, odd ones in the second half */
+constexpr int perm3[6][3] = {{0, 1, 2}, {1, 2, 0}, {2, 0, 1}, {1, 0, 2}, {0, 2, 1}, {2, 1, 0}};
+} // namespace detail
+
+/* two_m1 is implied by two_m1 + two_m2 + two_m3 = 0, and taken only to keep the order of the arguments of wigner3j */
+constexpr canonical_3j canonicalize_3j(int two_j1, int two_j2, int two_j3, [[maybe_unused]] int two_m1, int two_m2,
+                                       int two_m3) noexcept {
+  const int r00 = (-two_j1 + two_j2 + two_j3) / 2;
+  const int r01 = (two_j1 - two_j2 + two_j3) / 2;
+  const int r02 = (two_j1 + two_j2 - two_j3) / 2;
+  const int r11 = (two_j2 - two_m2) / 2;
+  const int r12 = (two_j3 - two_m3) / 2;
+
+  std::array<int, 3> e{r00, r12, r00 + r02 - r11};
+  std::array<int, 3> o{0, r01 - r12, r11 - r00};
+  detail::sort3(e);
+  detail::sort3(o);
+
+  const int c3 = e[2] + o[1], c3_swapped = o[2] + e[1];
+  const int c1 = e[0] + o[1], c1_swapped = o[0] + e[1];
+
+  const bool swapped = c3_swapped > c3 || (c3_swapped == c3 && c1_swapped > c1);
+  if (swapped) {
+    std::swap(e, o);
+  }
+
+  const int J = r00 + r01 + r02;
+  const int sign = (swapped && (J & 1)) ? -1 : 1;
+
+  return {{e[0] + o[0], e[0] + o[1], e[1] + o[1], e[2] + o[1], e[2] + o[2]}, sign};
+}
+
+/* arguments (two_j1, two_j2, two_j3, two_m1, two_m2, two_m3) of a 3j symbol equal to the canonical form */
+constexpr std::array<int, 6> representative_3j(const canonical_3j &c) noexcept {
+  const auto &v = c.chain;
+  const std::array<int, 3> e{0, v[2] - v[1], v[3] - v[1]};
+  const std::array<int, 3> o{v[0], v[1], v[1] + v[4] - v[3]};
+
+  std::array<int, 6> args{};
+  for (int col = 0; col < 3; ++col) {
+    const int r1 = e[(col + 2) % 3] + o[(col + 1) % 3];
+    const int r2 = e[(col + 1) % 3] + o[(col + 2) % 3];
+    args[col] = r1 + r2;
+    args[col + 3] = r2 - r1;
+  }
+  return args;
+}
+
+constexpr canonical_6j canonicalize_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5,
+                                       int two_j6) noexcept {
+  std::array<int, 4> alpha{(two_j1 + two_j2 + two_j3) / 2, (two_j1 + two_j5 + two_j6) / 2,
+                           (two_j4 + two_j2 + two_j6) / 2, (two_j4 + two_j5 + two_j3) / 2};
+  std::array<int, 3> beta{(two_j1 + two_j2 + two_j4 + two_j5) / 2, (two_j2 + two_j3 + two_j5 + two_j6) / 2,
+                          (two_j3 + two_j1 + two_j6 + two_j4) / 2};
+  detail::sort4(alpha);
+  detail::sort3(beta);
+
+  return {{beta[0] - alpha[3], beta[0] - alpha[2], beta[0] - alpha[1], beta[0] - alpha[0], beta[1] - alpha[0],
+           beta[2] - alpha[0]}};
+}
+
+/* arguments (two_j1, ..., two_j6) of a 6j symbol equal to the canonical form */
+constexpr std::array<int, 6> representative_6j(const canonical_6j &c) noexcept {
+  const auto &v = c.chain;
+  const int s = v[0], d1 = v[1] - v[0], d2 = v[2] - v[1], d3 = v[3] - v[2], e1 = v[4] - v[3], e2 = v[5] - v[4];
+
+  const int a4 = 3 * s + 2 * e1 + e2 + 3 * d1 + 2 * d2 + d3;
+  const int a3 = a4 - d1, a2 = a3 - d2, a1 = a2 - d3;
+  const int b1 = a4 + s, b2 = b1 + e1, b3 = b2 + e2;
+
+  return {a1 + a2 - b2, a1 + a3 - b3, a1 + a4 - b1, a3 + a4 - b2, a2 + a4 - b3, a2 + a3 - b1};
+}
+
+constexpr canonical_9j canonicalize_9j(const std::array<int, 9> &two_j) noexcept {
+  const int sum = (two_j[0] + two_j[1] + two_j[2] + two_j[3] + two_j[4] + two_j[5] + two_j[6] + two_j[7] +
+                   two_j[8]) /
+                  2;
+
+  canonical_9j best{two_j, 1};
+  for (int transpose = 0; transpose < 2; ++transpose) {
+    for (int r = 0; r < 6; ++r) {
+      for (int c = 0; c < 6; ++c) {
+        std::array<int, 9> cand{};
+        for (int i = 0; i < 3; ++i) {
+          for (int j = 0; j < 3; ++j) {
+            const int row = detail::perm3[r][i], col = detail::perm3[c][j];
+            cand[i * 3 + j] = transpose ? two_j[col * 3 + row] : two_j[row * 3 + col];
+          }
+        }
+        if (cand < best.two_j) {
+          const bool odd = (r >= 3) != (c >= 3);
+          best = {cand, (odd && (sum & 1)) ? -1 : 1};
+        }
+      }
+    }
+  }
+  return best;
+}
+
+} // namespace wigcpp::internal::symmetry
+
+#endif /* __WIGCPP_SYMMETRY__ */
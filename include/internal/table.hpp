@@ -0,0 +1,275 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_TABLE__
+#define __WIGCPP_TABLE__
+
+#include "internal/calc.hpp"
+#include "internal/global_pool.hpp"
+#include "internal/symmetry.hpp"
+#include "internal/vector.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace wigcpp::internal::table {
+using namespace wigcpp::internal::global;
+
+/* Dense tables of canonical 3j and 6j symbols.
+ *
+ * Every symmetry class is stored once, at the rank of its canonical chain (see symmetry.hpp). A non-decreasing chain
+ * c0 <= c1 <= ... <= c(N-1) maps to the strictly increasing sequence c_i + i, whose rank in the combinatorial number
+ * system is sum C(c_i + i, i + 1). The rank does not depend on the table bound, and the chains with top entry <= n
+ * occupy exactly the ranks [0, C(n + N, N)), so tables of different max_two_j share their common prefix. Ranks are
+ * ordered by the largest Regge entry first, so consecutive entries reuse the same rows of the factorial pool.
+ *
+ * A 3j chain and its transpose (v0, v0 + v2 - v1, v2, v2 + v4 - v3, v4) belong to the same class, so 3j symbols are
+ * ranked among the canonical chains only, see rank_3j, and take about half the entries of the 5-chains.
+ *
+ * 9j symbols have no such chain, their canonical forms are stored in an open-addressing hash table of Slot9j instead,
+ * keyed by the canonical two_j packed into 7 bits each. The top bit of an occupied key is set, so 0 marks an empty slot.
+ */
+
+constexpr std::uint64_t binomial(std::uint64_t n, std::uint64_t k) noexcept {
+  if (k > n) {
+    return 0;
+  }
+  std::uint64_t r = 1;
+  for (std::uint64_t i = 0; i < k; ++i) {
+    r = r * (n - i) / (i + 1);
+  }
+  return r;
+}
+
+template <std::size_t N> constexpr std::uint64_t rank(const std::array<int, N> &chain) noexcept {
+  std::uint64_t r = 0;
+  for (std::size_t i = 0; i < N; ++i) {
+    r += binomial(static_cast<std::uint64_t>(chain[i]) + i, i + 1);
+  }
+  return r;
+}
+
+template <std::size_t N> constexpr std::array<int, N> unrank(std::uint64_t r) noexcept {
+  std::array<int, N> chain{};
+  for (std::size_t i = N; i-- > 0;) {
+    std::uint64_t x = i;
+    while (binomial(x + 1, i + 1) <= r) {
+      ++x;
+    }
+    r -= binomial(x, i + 1);
+    chain[i] = static_cast<int>(x - i);
+  }
+  return chain;
+}
+
+/* advance a chain to the one of the next rank */
+template <std::size_t N> constexpr void next(std::array<int, N> &chain) noexcept {
+  std::size_t i = 0;
+  while (i + 1 < N && chain[i] == chain[i + 1]) {
+    ++i;
+  }
+  ++chain[i];
+  for (std::size_t j = 0; j < i; ++j) {
+    chain[j] = 0;
+  }
+}
+
+/* Canonical 3j chains, those with 2 v3 > v2 + v4, or 2 v3 = v2 + v4 and 2 v1 >= v0 + v2. They are ranked by their top
+ * t = v4, then by the span u = v4 - v2. Within a span come first the chains with 2 v3 > v2 + v4, by v3 from the top
+ * and then by the rank of (v0, v1), then those with 2 v3 = v2 + v4, by v1 from the top and then by v0. A chain and its
+ * transpose are one pair of the chains of the same top and span, or the same chain, so the canonical chains below a
+ * bound are half of all chains and of those fixed by the transposition. */
+
+/* canonical chains of top below t */
+constexpr std::uint64_t chains_3j_below(std::uint64_t t) noexcept {
+  /* the fixed chains of top s are C(s / 2 + 2, 2) */
+  const std::uint64_t m = t / 2;
+  const std::uint64_t fixed = 2 * binomial(m + 2, 3) + (t & 1 ? binomial(m + 2, 2) : 0);
+  return (binomial(t + 4, 5) + fixed) / 2;
+}
+
+/* canonical chains of top t and span below u */
+constexpr std::uint64_t span_3j_below(std::uint64_t t, std::uint64_t u) noexcept {
+  /* the chains of span k - 1 are k C(t - k + 3, 2), summed over k in [1, u] */
+  const auto m = static_cast<std::int64_t>(t) + 3, n = static_cast<std::int64_t>(u);
+  const std::int64_t s1 = n * (n + 1) / 2, s2 = n * (n + 1) * (2 * n + 1) / 6;
+  const auto all = static_cast<std::uint64_t>(((m * m - m) * s1 - (2 * m - 1) * s2 + s1 * s1) / 2);
+  /* the fixed ones have an even span k and t / 2 - k / 2 + 1 choices of v1 */
+  const std::uint64_t evens = (u + 1) / 2;
+  const std::uint64_t fixed = evens * (t / 2 + 1) - evens * (evens - 1) / 2;
+  return (all + fixed) / 2;
+}
+
+constexpr std::uint64_t rank_3j(const std::array<int, 5> &chain) noexcept {
+  const auto t = static_cast<std::uint64_t>(chain[4]), w = static_cast<std::uint64_t>(chain[2]), u = t - w;
+  const auto v0 = static_cast<std::uint64_t>(chain[0]), v1 = static_cast<std::uint64_t>(chain[1]);
+  const std::uint64_t lower = binomial(w + 2, 2);
+  const std::uint64_t r = chains_3j_below(t) + span_3j_below(t, u);
+  const auto a = static_cast<std::uint64_t>(chain[3] - chain[2]);
+  if (2 * a > u) {
+    return r + (u - a) * lower + binomial(v1 + 1, 2) + v0;
+  }
+  const std::uint64_t d = w - v1;
+  return r + (u + 1) / 2 * lower + d * (w + 2 - d) + v0;
+}
+
+constexpr std::array<int, 5> unrank_3j(std::uint64_t r) noexcept {
+  std::uint64_t t = 0, u = 0;
+  while (chains_3j_below(t + 1) <= r) {
+    ++t;
+  }
+  r -= chains_3j_below(t);
+  while (u < t && span_3j_below(t, u + 1) <= r) {
+    ++u;
+  }
+  r -= span_3j_below(t, u);
+
+  const std::uint64_t w = t - u, lower = binomial(w + 2, 2), strict = (u + 1) / 2;
+  std::uint64_t v0, v1, v3;
+  if (r < strict * lower) {
+    v3 = t - r / lower;
+    r %= lower;
+    v1 = 0;
+    while (binomial(v1 + 2, 2) <= r) {
+      ++v1;
+    }
+    v0 = r - binomial(v1 + 1, 2);
+  } else {
+    v3 = w + u / 2;
+    r -= strict * lower;
+    std::uint64_t d = 0;
+    while ((d + 1) * (w + 1 - d) <= r) {
+      ++d;
+    }
+    v1 = w - d;
+    v0 = r - d * (w + 2 - d);
+  }
+  return {static_cast<int>(v0), static_cast<int>(v1), static_cast<int>(w), static_cast<int>(v3), static_cast<int>(t)};
+}
+
+/* advance a canonical 3j chain to the one of the next rank */
+constexpr void next_3j(std::array<int, 5> &chain) noexcept {
+  auto &[v0, v1, v2, v3, v4] = chain;
+  if (2 * v3 > v2 + v4) {
+    if (v0 < v1) {
+      ++v0;
+      return;
+    }
+    if (v1 < v2) {
+      ++v1;
+      v0 = 0;
+      return;
+    }
+    if (2 * (v3 - 1) >= v2 + v4) {
+      --v3;
+      v1 = 2 * v3 > v2 + v4 ? 0 : v2;
+      v0 = 0;
+      return;
+    }
+  } else {
+    if (v0 < 2 * v1 - v2) {
+      ++v0;
+      return;
+    }
+    if (2 * (v1 - 1) >= v2) {
+      --v1;
+      v0 = 0;
+      return;
+    }
+  }
+  /* the first chain of the next span, the one of the largest v3 */
+  const int t = v2 ? v4 : v4 + 1, w = v2 ? v2 - 1 : t;
+  chain = {0, w == t ? w : 0, w, t, t};
+}
+
+constexpr std::size_t chain_length(int wigner_type) noexcept {
+  return wigner_type == 3 ? 5 : 6;
+}
+
+/* ensures a pool for every symbol of a table of wigner_type (3, 6 or 9) up to max_two_j, that of the next even
+ * max_two_j for an odd one */
+void ensure_pool(int wigner_type, int max_two_j) noexcept;
+
+/* number of entries of a table holding every symbol with all two_j <= max_two_j */
+std::uint64_t table_size(int wigner_type, int max_two_j) noexcept;
+
+/* evaluates all table_size(wigner_type, max_two_j) entries into table, using num_threads threads (0: one per core) */
+void fill_table(const GlobalFactorialPool &pool, int wigner_type, int max_two_j, double *table,
+                int num_threads) noexcept;
+
+/* evaluates the entries of ranks [begin, end) into dest[0, end - begin) */
+void fill_table_range(const GlobalFactorialPool &pool, int wigner_type, int max_two_j, double *dest,
+                      std::uint64_t begin, std::uint64_t end, int num_threads) noexcept;
+
+struct Slot9j {
+  std::uint64_t key;
+  double value;
+};
+
+constexpr int max_two_j_9j = 127;
+
+constexpr bool pack_9j(const std::array<int, 9> &two_j, std::uint64_t &key) noexcept {
+  key = std::uint64_t{1} << 63;
+  for (int i = 0; i < 9; ++i) {
+    if (two_j[i] < 0 || two_j[i] > max_two_j_9j) {
+      return false;
+    }
+    key |= static_cast<std::uint64_t>(two_j[i]) << (7 * i);
+  }
+  return true;
+}
+
+constexpr std::array<int, 9> unpack_9j(std::uint64_t key) noexcept {
+  std::array<int, 9> two_j{};
+  for (int i = 0; i < 9; ++i) {
+    two_j[i] = static_cast<int>((key >> (7 * i)) & 0x7f);
+  }
+  return two_j;
+}
+
+/* first probe position of a key in a table of power-of-two capacity */
+constexpr std::uint64_t slot_hash(std::uint64_t key) noexcept {
+  key ^= key >> 30;
+  key *= 0xbf58476d1ce4e5b9ull;
+  key ^= key >> 27;
+  key *= 0x94d049bb133111ebull;
+  key ^= key >> 31;
+  return key;
+}
+
+/* hash table holding the keys of every canonical 9j symbol with all two_j <= max_two_j, values are left zero */
+container::vector<Slot9j> layout_9j(int max_two_j) noexcept;
+
+/* evaluates the values of the occupied slots in [begin, end) */
+void fill_slots_9j(const GlobalFactorialPool &pool, int max_two_j, Slot9j *slots, std::uint64_t begin,
+                   std::uint64_t end, int num_threads) noexcept;
+
+/* returns -1 for trivially zero symbols, the table entry has to be multiplied by sign */
+inline std::int64_t index_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3,
+                             int &sign) noexcept {
+  if (calc::TrivialZero::is_zero_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3)) {
+    sign = 0;
+    return -1;
+  }
+  const auto canon = symmetry::canonicalize_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3);
+  sign = canon.sign;
+  return static_cast<std::int64_t>(rank_3j(canon.chain));
+}
+
+inline std::int64_t index_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) noexcept {
+  if (calc::TrivialZero::is_zero_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6)) {
+    return -1;
+  }
+  const auto canon = symmetry::canonicalize_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
+  return static_cast<std::int64_t>(rank(canon.chain));
+}
+
+} // namespace wigcpp::internal::table
+
+#endif /* __WIGCPP_TABLE__ */
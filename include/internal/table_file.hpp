@@ -0,0 +1,116 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_TABLE_FILE__
+#define __WIGCPP_TABLE_FILE__
+
+#include "internal/global_pool.hpp"
+#include "internal/table.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace wigcpp::internal::table {
+
+/* Layout of a table file, in native byte order:
+ *
+ *   [0, 48)             FileHeader
+ *   [4096, ...)         payload, entries * 8 bytes of double for 3j and 6j, entries * 16 bytes of Slot9j for 9j
+ *
+ * The payload starts on a page boundary so that a mapping of the file only touches the pages holding the symbols
+ * looked up. The payload checksum is only verified on request, the header checksum always.
+ */
+
+constexpr char file_magic[8] = {'W', 'I', 'G', 'C', 'P', 'P', 'T', 'B'};
+constexpr std::uint32_t file_version = 2;
+constexpr std::uint32_t file_byte_order = 0x01020304;
+constexpr std::uint64_t payload_offset = 4096;
+
+struct FileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t wigner_type;
+  std::int32_t max_two_j;
+  std::uint32_t byte_order;
+  std::uint64_t entries;
+  std::uint64_t payload_checksum;
+  std::uint64_t header_checksum; /* over all fields above */
+};
+
+static_assert(sizeof(FileHeader) == 48, "FileHeader must not contain padding");
+
+constexpr std::uint64_t entry_bytes(int wigner_type) noexcept {
+  return wigner_type == 9 ? sizeof(Slot9j) : sizeof(double);
+}
+
+/* running checksum over 64-bit words, start with state 0 */
+std::uint64_t checksum(std::uint64_t state, const std::uint64_t *words, std::size_t count) noexcept;
+
+std::uint64_t header_checksum(const FileHeader &header) noexcept;
+
+using progress_fn = void (*)(std::uint64_t done, std::uint64_t total);
+
+/* Writes the table of all symbols with two_j <= max_two_j to path. Shards of shard_entries entries are computed in
+ * turn and written to path.partial, finished shards are recorded in path.progress, so an interrupted run with the same
+ * parameters continues where it stopped. On success the partial file is renamed to path. Returns false on I/O errors.
+ */
+bool write_table_file(const GlobalFactorialPool &pool, int wigner_type, int max_two_j, const char *path,
+                      int num_threads, std::uint64_t shard_entries, progress_fn progress) noexcept;
+
+/* read-only memory mapping of a table file */
+class TableFile {
+  void *base;
+  std::size_t bytes;
+#ifdef _WIN32
+  void *file_handle;
+  void *mapping_handle;
+#endif
+  const FileHeader *header;
+
+  const double *values() const noexcept {
+    return reinterpret_cast<const double *>(static_cast<const char *>(base) + payload_offset);
+  }
+
+  const Slot9j *slots() const noexcept {
+    return reinterpret_cast<const Slot9j *>(static_cast<const char *>(base) + payload_offset);
+  }
+
+  void check(int wigner_type, std::initializer_list<int> two_j) const noexcept;
+
+public:
+  TableFile() noexcept;
+  ~TableFile() noexcept;
+
+  TableFile(const TableFile &) = delete;
+  TableFile &operator=(const TableFile &) = delete;
+
+  /* prints the reason and returns false if the file is missing, truncated or fails a checksum */
+  bool open(const char *path, bool verify) noexcept;
+
+  void close() noexcept;
+
+  int wigner_type() const noexcept {
+    return static_cast<int>(header->wigner_type);
+  }
+
+  int max_two_j() const noexcept {
+    return header->max_two_j;
+  }
+
+  double lookup_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3) const noexcept;
+
+  double lookup_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) const noexcept;
+
+  double lookup_9j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6, int two_j7, int two_j8,
+                   int two_j9) const noexcept;
+};
+
+} // namespace wigcpp::internal::table
+
+#endif /* __WIGCPP_TABLE_FILE__ */
@@ -0,0 +1,54 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_TIERED__
+#define __WIGCPP_TIERED__
+
+#include "internal/global_pool.hpp"
+#include "internal/tmp_pool.hpp"
+
+namespace wigcpp::internal::tiered {
+using namespace wigcpp::internal::global;
+using namespace wigcpp::internal::tmp;
+
+/* The floating tier evaluates the Racah sum in double-double, the terms from the ratio of consecutive terms and the
+ * prefactor from the prime exponents of the pool. Its error is bounded from the number of rounded operations and the
+ * cancellation of the sum, sum |t_k| / |sum t_k|. A symbol is certified when the bound is below 2^-60 relative, so that
+ * the returned double is off by at most 2^-53 + 2^-60 relative to the exact value. Symbols that fail the bound, or
+ * with two_j above max_two_j, are handed to the Calculator.
+ */
+constexpr int max_two_j = 4096;
+
+/* symbols whose largest factorial is at most min_factorial go straight to the Calculator, whose double-word path is
+ * faster there */
+constexpr int min_factorial = 32;
+
+/* the floating tier alone, false when the symbol isn't certified */
+bool try_cg(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_m1, int two_m2,
+            int two_J, int two_M, double &result) noexcept;
+
+bool try_3j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3, int two_m1,
+            int two_m2, int two_m3, double &result) noexcept;
+
+bool try_6j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3, int two_j4,
+            int two_j5, int two_j6, double &result) noexcept;
+
+/* the floating tier, or the Calculator when it fails */
+double calc_cg(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_m1, int two_m2,
+               int two_J, int two_M) noexcept;
+
+double calc_3j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3, int two_m1,
+               int two_m2, int two_m3) noexcept;
+
+double calc_6j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3, int two_j4,
+               int two_j5, int two_j6) noexcept;
+
+} // namespace wigcpp::internal::tiered
+
+#endif /* __WIGCPP_TIERED__ */
@@ -14,9 +14,14 @@
 #include "internal/big_int.hpp"
 #include "internal/uniform_jagged_matrix.hpp"
 #include "internal/pexpo_eval_ctx.hpp"
+#include "internal/word_arena.hpp"
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <memory>
+#include <utility>
 
 namespace wigcpp::internal::tmp {
 using namespace wigcpp::internal::global;
@@ -27,17 +32,35 @@ constexpr auto nume_triprod = 2u;
 constexpr auto triprod_Fx = 3u;
 constexpr auto iter_start = 6u;
 
+/* slots of the triangle coefficient cache, a power of two */
+constexpr std::uint32_t delta_slots = 128u;
+
 class TempStorage {
-  uniform_jagged_matrix<exp_t> storage;
+  /* rows [0, iter_start) of full stride, which callers keep across calls */
+  uniform_jagged_matrix<exp_t> fixed_rows;
+
+  /* the rows iter_start + k of the terms of a sum, scratch of a single sum. They are sized by reserve_iter for the
+   * sums met so far rather than for the largest symbol of the pool. */
+  uniform_jagged_matrix<exp_t> iter_rows;
+
+  /* Delta(abc) of recent triads, direct mapped on the sorted triad. Families and batches of symbols share most of
+   * their triads, and the 9j sum meets the same ones again for every k. */
+  uniform_jagged_matrix<exp_t> delta_rows;
+  std::array<std::uint64_t, delta_slots> delta_keys;
+
+  void grow_iter(std::uint32_t count, std::uint32_t width, std::uint32_t limit) noexcept;
 
 public:
-  const int max_iter;
+  /* the words of the big numbers below, made current by the Calculator for the symbol it evaluates. It is declared
+   * first so that it outlives them. */
+  allocator::word_arena arena;
 
   mwi::big_int sum_prod;
-  mwi::big_int big_prod;
-  mwi::big_int big_sqrt;
-  mwi::big_int big_nume;
-  mwi::big_int big_div;
+  mwi::big_sum sum_acc;
+  mwi::big_nat big_prod;
+  mwi::big_nat big_sqrt;
+  mwi::big_nat big_nume;
+  mwi::big_nat big_div;
   mwi::big_int big_nume_prod;
   mwi::big_int triprod;
   mwi::big_int triprod_tmp;
@@ -45,41 +68,160 @@ public:
 
   prime::pexpo_eval_temp pexpo_tmp;
 
-  TempStorage(std::uint32_t max_iter, std::uint32_t stride) noexcept;
+  explicit TempStorage(std::uint32_t stride) noexcept;
   TempStorage() = delete;
   TempStorage(const TempStorage &) = delete;
   TempStorage &operator=(const TempStorage &) = delete;
-  TempStorage(TempStorage &&) = default;
+  TempStorage(TempStorage &&) = delete;
   TempStorage &operator=(TempStorage &&) = delete;
 
   exp_t *data(std::uint32_t n) noexcept {
-    return storage.row(n);
+    return n < iter_start ? fixed_rows.row(n) : iter_rows.row(n - iter_start);
   }
 
   std::uint32_t &used(std::uint32_t n) noexcept {
-    return storage.used(n);
+    return n < iter_start ? fixed_rows.used(n) : iter_rows.used(n - iter_start);
   }
 
   uniform_jagged_matrix<exp_t>::row_view view(std::uint32_t n) const noexcept {
-    return storage.view(n);
+    return n < iter_start ? fixed_rows.view(n) : iter_rows.view(n - iter_start);
+  }
+
+  /* room for count iteration rows of width exponents. The rows grow geometrically in both directions, but not past
+   * limit rows unless count does, and growing drops their contents, so it is called before a sum fills them. */
+  void reserve_iter(std::uint32_t count, std::uint32_t width, std::uint32_t limit) noexcept {
+    if (count > iter_rows.rows() || width > iter_rows.stride()) [[unlikely]] {
+      grow_iter(count, width, limit);
+    }
+  }
+
+  /* frees the iteration rows and the arena, the next sum grows them again */
+  void shrink() noexcept;
+
+  std::uint32_t iter_capacity() const noexcept {
+    return iter_rows.rows();
+  }
+
+  /* the iteration rows the sums of symbols up to max_two_j need at most */
+  static std::uint32_t max_iter(int max_two_j) noexcept {
+    return static_cast<std::uint32_t>(max_two_j / 2 + 1);
+  }
+
+  /* bytes of the rows of a storage of stride with iter_rows full iteration rows */
+  static std::size_t row_bytes(std::size_t stride, std::uint32_t iter_rows) noexcept {
+    return (iter_start + delta_slots + iter_rows) * stride * sizeof(exp_t);
+  }
+
+  /* bytes the arena takes at most for the numbers of symbols whose factorials are at most max_factorial */
+  static std::size_t number_bytes(std::uint32_t max_factorial) noexcept;
+
+  /* bytes held by the rows */
+  std::size_t row_bytes() const noexcept {
+    return (static_cast<std::size_t>(fixed_rows.rows()) * fixed_rows.stride() +
+            static_cast<std::size_t>(iter_rows.rows()) * iter_rows.stride() +
+            static_cast<std::size_t>(delta_rows.rows()) * delta_rows.stride()) *
+           sizeof(exp_t);
+  }
+
+  /* the cached row of Delta(abc), computed by fill on a miss as fill(data, used) */
+  template <typename Fill>
+  uniform_jagged_matrix<exp_t>::row_view delta(int two_a, int two_b, int two_c, Fill &&fill) noexcept {
+    const std::uint64_t key = delta_key(two_a, two_b, two_c);
+    const auto slot = static_cast<std::uint32_t>((key * 0x9e3779b97f4a7c15ull) >> 32) & (delta_slots - 1);
+    if (delta_keys[slot] != key) [[unlikely]] {
+      fill(delta_rows.row(slot), delta_rows.used(slot));
+      delta_keys[slot] = key;
+    }
+    return delta_rows.view(slot);
   }
 
   void reset() noexcept;
 
   std::uint32_t stride() const noexcept {
-    return storage.stride();
+    return fixed_rows.stride();
+  }
+
+private:
+  static constexpr std::uint64_t no_delta = ~std::uint64_t{0};
+
+  /* Delta(abc) is symmetric in a, b and c, 21 bits hold any two_j the factorial pool can reach */
+  static std::uint64_t delta_key(int two_a, int two_b, int two_c) noexcept {
+    if (two_a > two_b) {
+      std::swap(two_a, two_b);
+    }
+    if (two_b > two_c) {
+      std::swap(two_b, two_c);
+    }
+    if (two_a > two_b) {
+      std::swap(two_a, two_b);
+    }
+    return (static_cast<std::uint64_t>(two_a) << 42) | (static_cast<std::uint64_t>(two_b) << 21) |
+           static_cast<std::uint64_t>(two_c);
   }
 };
 
+/* TempStorage of exited threads, which the next new threads start with instead of allocating and faulting in their
+ * own. The list is a fixed array of slots, each filled and emptied by a single atomic exchange, so it is lock-free and
+ * free of ABA. Storage is reset when it is put back, off the path of the next thread.
+ */
+class FreeList {
+  static constexpr int max_slots = 64;
+
+  inline static std::array<std::atomic<TempStorage *>, max_slots> slots{};
+  inline static std::atomic<int> cap{8};
+
+  FreeList() = delete;
+  ~FreeList() = delete;
+
+public:
+  /* keeps at most max_storages storages, at most max_slots, and frees those beyond */
+  static void set_cap(int max_storages) noexcept;
+
+  /* the storages the list keeps at most */
+  static int capacity() noexcept {
+    return cap.load(std::memory_order_relaxed);
+  }
+
+  /* frees the storage if the list is full */
+  static void put(std::unique_ptr<TempStorage> storage) noexcept;
+
+  /* a storage of stride, or nullptr. Storages of other strides are freed on the way. */
+  static std::unique_ptr<TempStorage> take(std::uint32_t stride) noexcept;
+
+  /* frees the iteration rows and arenas of the kept storages */
+  static void shrink() noexcept;
+
+  /* frees the kept storages */
+  static void clear() noexcept;
+};
+
 class TempManager {
-  static inline thread_local std::unique_ptr<TempStorage> ptr = nullptr;
+  /* hands the storage of the thread to the free list when the thread exits */
+  struct Holder {
+    std::unique_ptr<TempStorage> storage;
+
+    ~Holder() noexcept {
+      FreeList::put(std::move(storage));
+    }
+  };
+
+  static inline thread_local Holder holder;
 
 public:
+  /* a storage from the free list, or a new one if the list holds none of stride */
+  static std::unique_ptr<TempStorage> acquire(std::uint32_t stride) noexcept;
+
   static void init(int max_two_j, std::size_t stride) noexcept;
 
   static TempStorage &get(int max_two_j, std::size_t stride) noexcept;
 
   static void reset() noexcept;
+
+  /* frees the iteration rows and arenas of the storage of this thread and of the free list */
+  static void shrink() noexcept;
+
+  /* frees the storage of this thread and of the free list */
+  static void release() noexcept;
 };
 
 } // namespace wigcpp::internal::tmp
@@ -0,0 +1,138 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_WORD_ARENA__
+#define __WIGCPP_WORD_ARENA__
+
+#include "internal/nothrow_allocator.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace wigcpp::internal::allocator {
+
+/* Blocks for the words of the big numbers of one computation context. A TempStorage owns one, and the thread evaluating
+ * a symbol with it makes it current, so the numbers of the sum take their words from the arena rather than from
+ * malloc. Blocks of a power-of-two size are cut from chunks, and freed ones are kept by size for the next ones, so a
+ * thread repeating symbols of the same size allocates nothing after the first. The parts of a split sum free blocks of
+ * the arena on other threads: those go to a lock-free list the owner takes back on its next miss. The chunks are freed
+ * all at once, by release or with the arena.
+ */
+class word_arena {
+  /* the header of a block, owner is nullptr for a block of its own from hooks, whose size are its bytes */
+  struct block {
+    word_arena *owner;
+    std::size_t size;
+  };
+
+  struct chunk {
+    chunk *next;
+    std::size_t bytes;
+  };
+
+  /* blocks of 8 words to 8 Mi words, larger ones are blocks of their own */
+  static constexpr int min_class = 3;
+  static constexpr int num_classes = 21;
+  static constexpr std::size_t chunk_bytes = std::size_t{64} << 10;
+
+  static inline thread_local word_arena *current = nullptr;
+
+  std::array<block *, num_classes> free_blocks{};
+  std::atomic<block *> remote{nullptr};
+  chunk *chunks = nullptr;
+  std::byte *top = nullptr;
+  std::byte *end = nullptr;
+  std::size_t chunk_total = 0;
+
+  static block *&next_of(block *b) noexcept {
+    return *reinterpret_cast<block **>(b + 1);
+  }
+
+  static std::size_t block_bytes(std::size_t cls) noexcept {
+    return sizeof(block) + (sizeof(std::uint64_t) << (cls + min_class));
+  }
+
+  block *take(std::size_t cls) noexcept;
+
+  block *cut(std::size_t cls) noexcept;
+
+  std::byte *new_chunk(std::size_t bytes) noexcept;
+
+  void take_remote() noexcept;
+
+public:
+  word_arena() noexcept = default;
+  ~word_arena() noexcept {
+    release();
+  }
+
+  word_arena(const word_arena &) = delete;
+  word_arena &operator=(const word_arena &) = delete;
+
+  /* makes arena current on this thread for its lifetime, nullptr for none */
+  class scope {
+    word_arena *outer;
+
+  public:
+    explicit scope(word_arena *arena) noexcept : outer(current) {
+      current = arena;
+    }
+
+    ~scope() noexcept {
+      current = outer;
+    }
+
+    scope(const scope &) = delete;
+    scope &operator=(const scope &) = delete;
+  };
+
+  /* bytes from the current arena of this thread, or a block of their own without one */
+  [[nodiscard]] static void *allocate(std::size_t bytes) noexcept;
+
+  /* frees a block of allocate on any thread */
+  static void deallocate(void *p) noexcept;
+
+  /* frees the chunks, once no block of the arena is live */
+  void release() noexcept;
+
+  /* bytes an arena takes at most for count numbers that grow to bytes each, with a freed block of every smaller size */
+  static std::size_t bytes_for(std::size_t bytes, std::size_t count) noexcept;
+
+  /* bytes of the chunks */
+  std::size_t bytes() const noexcept {
+    return chunk_total;
+  }
+};
+
+/* The allocator of the words of big numbers, from the current word_arena */
+template <typename T> class arena_allocator {
+  static_assert(alignof(T) <= alignof(std::max_align_t), "arena blocks are aligned as max_align_t");
+
+public:
+  using value_type = T;
+  arena_allocator() noexcept = default;
+
+  [[nodiscard]] value_type *allocate(std::size_t n) noexcept {
+    if (n == 0)
+      return nullptr;
+    return static_cast<value_type *>(word_arena::allocate(n * sizeof(value_type)));
+  }
+
+  void deallocate(value_type *p, std::size_t n) noexcept {
+    (void)n;
+    if (!p)
+      return;
+    word_arena::deallocate(p);
+  }
+};
+
+} // namespace wigcpp::internal::allocator
+
+#endif /* __WIGCPP_WORD_ARENA__ */
@@ -0,0 +1,582 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WIGCPP_TINY__
+#define __WIGCPP_TINY__
+
+/* Header-only, constexpr 3j, 6j and Clebsch-Gordan coefficients of small angular momenta.
+ *
+ * The values of all symbols with two_j <= max_two_j are computed by the compiler and stored in the binary, one entry
+ * per Regge (and for 6j tetrahedral) symmetry class, at the index wigcpp_table_index_3j and wigcpp_table_index_6j
+ * give. A call reduces its arguments to the canonical chain of the class and loads one entry, without the global
+ * factorial pool. The results are those of wigner3j and wigner6j. Calling a function with a two_j above max_two_j
+ * doesn't compile in a constant expression and aborts otherwise.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+namespace wigcpp::tiny {
+
+inline constexpr int max_two_j = 8;
+
+namespace detail {
+
+/* the largest factorial of the Racah sums of symbols with two_j <= max_two_j, reached by 6j symbols */
+inline constexpr int max_factorial = 2 * max_two_j + 1;
+
+constexpr bool is_prime(int n) noexcept {
+  for (int d = 2; d * d <= n; ++d) {
+    if (n % d == 0) {
+      return false;
+    }
+  }
+  return n >= 2;
+}
+
+constexpr int count_primes(int n) noexcept {
+  int count = 0;
+  for (int p = 2; p <= n; ++p) {
+    count += is_prime(p);
+  }
+  return count;
+}
+
+inline constexpr int num_primes = count_primes(max_factorial);
+
+/* The exponents of all primes packed into one integer, field_bits per prime and biased by half the field, so that
+ * adding and subtracting factorials is one integer operation. Plain arrays and integers throughout: compilers evaluate
+ * them far faster than std::array in constant expressions. */
+inline constexpr int field_bits = 9;
+inline constexpr int field_bias = 1 << (field_bits - 1);
+static_assert(num_primes * field_bits <= 64, "the exponents of all primes must fit in one integer");
+
+using exps = std::uint64_t;
+
+inline constexpr exps zero_exps = [] {
+  exps e = 0;
+  for (int i = 0; i < num_primes; ++i) {
+    e |= static_cast<exps>(field_bias) << (field_bits * i);
+  }
+  return e;
+}();
+
+struct Primes {
+  std::int64_t prime[num_primes];
+  exps fact[max_factorial + 1]; /* exponents of n!, without the bias */
+};
+
+inline constexpr Primes primes = [] {
+  Primes table{};
+  for (int p = 2, i = 0; i < num_primes; ++p) {
+    if (!is_prime(p)) {
+      continue;
+    }
+    table.prime[i] = p;
+    for (int n = 1, e = 0; n <= max_factorial; ++n) {
+      for (int x = n; x % p == 0; x /= p) {
+        ++e;
+      }
+      table.fact[n] |= static_cast<exps>(e) << (field_bits * i);
+    }
+    ++i;
+  }
+  return table;
+}();
+
+/* the precision of the runtime evaluation, see the build option WIGCPP_DOUBLE_EVAL */
+#ifdef WIGCPP_DOUBLE_EVAL
+using float_type = double;
+#else
+using float_type = long double;
+#endif
+
+/* Newton's iteration from above stops at most one ulp away from the root, a last step on the exact residual
+ * s - x * x (Dekker's product) rounds it the way std::sqrt does */
+constexpr float_type sqrt(float_type s) noexcept {
+  if (s == 0) {
+    return 0;
+  }
+  float_type x = s;
+  while (true) {
+    const float_type y = (x + s / x) / 2;
+    if (!(y < x)) {
+      break;
+    }
+    x = y;
+  }
+  constexpr float_type split =
+      static_cast<float_type>((std::uint64_t{1} << ((std::numeric_limits<float_type>::digits + 1) / 2)) + 1);
+  const float_type c = split * x, hi = c - (c - x), lo = x - hi;
+  const float_type p = x * x;
+  const float_type e = ((hi * hi - p) + 2 * hi * lo) + lo * lo;
+  return x + ((s - p) - e) / (2 * x);
+}
+
+/* sqrt(pre) * sum_k (-1)^(k + sign) * term[k - k_min] for k in [k_min, k_max], as the same n * sum / d / sqrt(s) as
+ * eval_fixed computes, with every term divided by the common factor of all terms */
+constexpr double eval(exps pre, const exps *term, int sign, int k_min, int k_max) noexcept {
+  constexpr exps mask = (exps{1} << field_bits) - 1;
+  const int num_terms = k_max - k_min + 1;
+  int e[max_two_j + 1][num_primes] = {};
+  int min_e[num_primes] = {};
+  for (int k = 0; k < num_terms; ++k) {
+    for (int i = 0; i < num_primes; ++i) {
+      e[k][i] = static_cast<int>((term[k] >> (field_bits * i)) & mask) - field_bias;
+      min_e[i] = !k || e[k][i] < min_e[i] ? e[k][i] : min_e[i];
+    }
+  }
+
+  std::int64_t sum = 0;
+  for (int k = 0; k < num_terms; ++k) {
+    std::int64_t t = 1;
+    for (int i = 0; i < num_primes; ++i) {
+      for (int n = e[k][i]; n > min_e[i]; --n) {
+        t *= primes.prime[i];
+      }
+    }
+    sum += ((k_min + k + sign) & 1) ? -t : t;
+  }
+
+  std::int64_t nume = 1, div = 1, root = 1;
+  for (int i = 0; i < num_primes; ++i) {
+    const int p = static_cast<int>((pre >> (field_bits * i)) & mask) - field_bias;
+    const int odd = p & 1;
+    const int half = (p + odd) / 2 + min_e[i];
+    for (int n = 0; n < half; ++n) {
+      nume *= primes.prime[i];
+    }
+    for (int n = 0; n < -half; ++n) {
+      div *= primes.prime[i];
+    }
+    root *= odd ? primes.prime[i] : 1;
+  }
+  return static_cast<double>(static_cast<float_type>(nume * sum) / static_cast<float_type>(div) /
+                             sqrt(static_cast<float_type>(root)));
+}
+
+/* the prefactor of a triad */
+constexpr exps delta(int two_a, int two_b, int two_c) noexcept {
+  return primes.fact[(two_a + two_b - two_c) / 2] + primes.fact[(two_a - two_b + two_c) / 2] +
+         primes.fact[(-two_a + two_b + two_c) / 2] - primes.fact[(two_a + two_b + two_c) / 2 + 1];
+}
+
+constexpr double eval_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3) noexcept {
+  exps pre = zero_exps + delta(two_j1, two_j2, two_j3);
+  for (const int n : {two_j1 - two_m1, two_j1 + two_m1, two_j2 - two_m2, two_j2 + two_m2, two_j3 - two_m3,
+                      two_j3 + two_m3}) {
+    pre += primes.fact[n / 2];
+  }
+
+  const int k_min = std::max({0, two_j2 - two_j3 - two_m1, two_j1 - two_j3 + two_m2}) / 2;
+  const int k_max = std::min({two_j1 + two_j2 - two_j3, two_j1 - two_m1, two_j2 + two_m2}) / 2;
+  exps term[max_two_j + 1] = {};
+  for (int k = k_min; k <= k_max; ++k) {
+    term[k - k_min] = zero_exps - primes.fact[k] - primes.fact[(two_j3 - two_j2 + two_m1) / 2 + k] -
+                      primes.fact[(two_j3 - two_j1 - two_m2) / 2 + k] - primes.fact[(two_j1 + two_j2 - two_j3) / 2 - k] -
+                      primes.fact[(two_j1 - two_m1) / 2 - k] - primes.fact[(two_j2 + two_m2) / 2 - k];
+  }
+  return eval(pre, term, (two_j1 - two_j2 - two_m3) / 2, k_min, k_max);
+}
+
+/* the closed form of zero_6j in calc.cpp for a zero entry */
+constexpr double zero_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) noexcept {
+  int upper[3] = {two_j1, two_j2, two_j3};
+  int lower[3] = {two_j4, two_j5, two_j6};
+  int col = 0;
+  while (upper[col] && lower[col]) {
+    ++col;
+  }
+  if (!upper[col]) {
+    std::swap(upper[col], lower[col]);
+    std::swap(upper[(col + 1) % 3], lower[(col + 1) % 3]);
+  }
+  const int two_a = upper[(col + 1) % 3], two_b = upper[(col + 2) % 3], two_c = upper[col];
+
+  const float_type r = 1 / sqrt(static_cast<float_type>(two_a + 1) * (two_b + 1));
+  return static_cast<double>((((two_a + two_b + two_c) / 2) & 1) ? -r : r);
+}
+
+constexpr double eval_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) noexcept {
+  const int alpha[4] = {(two_j1 + two_j2 + two_j3) / 2, (two_j1 + two_j5 + two_j6) / 2,
+                        (two_j4 + two_j2 + two_j6) / 2, (two_j4 + two_j5 + two_j3) / 2};
+  const int beta[3] = {(two_j1 + two_j2 + two_j4 + two_j5) / 2, (two_j2 + two_j3 + two_j5 + two_j6) / 2,
+                       (two_j3 + two_j1 + two_j6 + two_j4) / 2};
+  const exps pre = zero_exps + delta(two_j1, two_j2, two_j3) + delta(two_j1, two_j5, two_j6) +
+                   delta(two_j4, two_j2, two_j6) + delta(two_j4, two_j5, two_j3);
+
+  const int k_min = std::max({alpha[0], alpha[1], alpha[2], alpha[3]});
+  const int k_max = std::min({beta[0], beta[1], beta[2]});
+  exps term[max_two_j + 1] = {};
+  for (int k = k_min; k <= k_max; ++k) {
+    exps e = zero_exps + primes.fact[k + 1];
+    for (const int a : alpha) {
+      e -= primes.fact[k - a];
+    }
+    for (const int b : beta) {
+      e -= primes.fact[b - k];
+    }
+    term[k - k_min] = e;
+  }
+  return eval(pre, term, 0, k_min, k_max);
+}
+
+constexpr bool is_zero_triad(int two_a, int two_b, int two_c) noexcept {
+  return two_a < 0 || two_b < 0 || two_c < 0 || ((two_a + two_b + two_c) & 1) || two_a + two_b < two_c ||
+         two_a + two_c < two_b || two_b + two_c < two_a;
+}
+
+constexpr bool is_zero_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3) noexcept {
+  const auto bad_m = [](int two_j, int two_m) { return ((two_j + two_m) & 1) || two_m > two_j || -two_m > two_j; };
+  return is_zero_triad(two_j1, two_j2, two_j3) || two_m1 + two_m2 + two_m3 || bad_m(two_j1, two_m1) ||
+         bad_m(two_j2, two_m2) || bad_m(two_j3, two_m3);
+}
+
+constexpr bool is_zero_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) noexcept {
+  return is_zero_triad(two_j1, two_j2, two_j3) || is_zero_triad(two_j1, two_j5, two_j6) ||
+         is_zero_triad(two_j4, two_j2, two_j6) || is_zero_triad(two_j4, two_j5, two_j3);
+}
+
+/* The canonical chains and their ranks, see internal/symmetry.hpp and internal/table.hpp for the derivation. */
+template <int N> struct chain {
+  int v[N];
+  int sign;
+};
+
+struct symbol {
+  int two_j[6];
+};
+
+constexpr void sort(int *v, int n) noexcept {
+  for (int i = 1; i < n; ++i) {
+    for (int j = i; j > 0 && v[j - 1] > v[j]; --j) {
+      std::swap(v[j - 1], v[j]);
+    }
+  }
+}
+
+constexpr chain<5> canonicalize_3j(int two_j1, int two_j2, int two_j3, [[maybe_unused]] int two_m1, int two_m2,
+                                   int two_m3) noexcept {
+  const int r00 = (-two_j1 + two_j2 + two_j3) / 2;
+  const int r01 = (two_j1 - two_j2 + two_j3) / 2;
+  const int r02 = (two_j1 + two_j2 - two_j3) / 2;
+  const int r11 = (two_j2 - two_m2) / 2;
+  const int r12 = (two_j3 - two_m3) / 2;
+
+  int e[3] = {r00, r12, r00 + r02 - r11};
+  int o[3] = {0, r01 - r12, r11 - r00};
+  sort(e, 3);
+  sort(o, 3);
+
+  const int c3 = e[2] + o[1], c3_swapped = o[2] + e[1];
+  const int c1 = e[0] + o[1], c1_swapped = o[0] + e[1];
+  const bool swapped = c3_swapped > c3 || (c3_swapped == c3 && c1_swapped > c1);
+  if (swapped) {
+    for (int i = 0; i < 3; ++i) {
+      std::swap(e[i], o[i]);
+    }
+  }
+  const int sign = (swapped && ((r00 + r01 + r02) & 1)) ? -1 : 1;
+  return {{e[0] + o[0], e[0] + o[1], e[1] + o[1], e[2] + o[1], e[2] + o[2]}, sign};
+}
+
+constexpr chain<6> canonicalize_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) noexcept {
+  int alpha[4] = {(two_j1 + two_j2 + two_j3) / 2, (two_j1 + two_j5 + two_j6) / 2, (two_j4 + two_j2 + two_j6) / 2,
+                  (two_j4 + two_j5 + two_j3) / 2};
+  int beta[3] = {(two_j1 + two_j2 + two_j4 + two_j5) / 2, (two_j2 + two_j3 + two_j5 + two_j6) / 2,
+                 (two_j3 + two_j1 + two_j6 + two_j4) / 2};
+  sort(alpha, 4);
+  sort(beta, 3);
+  return {{beta[0] - alpha[3], beta[0] - alpha[2], beta[0] - alpha[1], beta[0] - alpha[0], beta[1] - alpha[0],
+           beta[2] - alpha[0]},
+          1};
+}
+
+constexpr std::int64_t binomial(std::int64_t n, std::int64_t k) noexcept {
+  if (k > n) {
+    return 0;
+  }
+  std::int64_t r = 1;
+  for (std::int64_t i = 0; i < k; ++i) {
+    r = r * (n - i) / (i + 1);
+  }
+  return r;
+}
+
+/* 3j chains are ranked among the canonical ones only, as internal::table::rank_3j */
+constexpr std::int64_t chains_3j_below(std::int64_t t) noexcept {
+  const std::int64_t m = t / 2;
+  return (binomial(t + 4, 5) + 2 * binomial(m + 2, 3) + (t & 1 ? binomial(m + 2, 2) : 0)) / 2;
+}
+
+constexpr std::int64_t span_3j_below(std::int64_t t, std::int64_t u) noexcept {
+  const std::int64_t m = t + 3, s1 = u * (u + 1) / 2, s2 = u * (u + 1) * (2 * u + 1) / 6;
+  const std::int64_t evens = (u + 1) / 2;
+  return (((m * m - m) * s1 - (2 * m - 1) * s2 + s1 * s1) / 2 + evens * (t / 2 + 1) - evens * (evens - 1) / 2) / 2;
+}
+
+constexpr std::int64_t rank_3j(const chain<5> &c) noexcept {
+  const std::int64_t t = c.v[4], w = c.v[2], u = t - w, a = c.v[3] - c.v[2];
+  const std::int64_t lower = binomial(w + 2, 2), r = chains_3j_below(t) + span_3j_below(t, u);
+  if (2 * a > u) {
+    return r + (u - a) * lower + binomial(c.v[1] + 1, 2) + c.v[0];
+  }
+  const std::int64_t d = w - c.v[1];
+  return r + (u + 1) / 2 * lower + d * (w + 2 - d) + c.v[0];
+}
+
+constexpr chain<5> unrank_3j(std::int64_t r) noexcept {
+  std::int64_t t = 0, u = 0;
+  while (chains_3j_below(t + 1) <= r) {
+    ++t;
+  }
+  r -= chains_3j_below(t);
+  while (u < t && span_3j_below(t, u + 1) <= r) {
+    ++u;
+  }
+  r -= span_3j_below(t, u);
+  const std::int64_t w = t - u, lower = binomial(w + 2, 2), strict = (u + 1) / 2;
+  std::int64_t v0 = 0, v1 = 0, v3 = w + u / 2;
+  if (r < strict * lower) {
+    v3 = t - r / lower;
+    r %= lower;
+    while (binomial(v1 + 2, 2) <= r) {
+      ++v1;
+    }
+    v0 = r - binomial(v1 + 1, 2);
+  } else {
+    r -= strict * lower;
+    std::int64_t d = 0;
+    while ((d + 1) * (w + 1 - d) <= r) {
+      ++d;
+    }
+    v1 = w - d;
+    v0 = r - d * (w + 2 - d);
+  }
+  return {{static_cast<int>(v0), static_cast<int>(v1), static_cast<int>(w), static_cast<int>(v3), static_cast<int>(t)},
+          1};
+}
+
+constexpr void next_3j(chain<5> &c) noexcept {
+  int *v = c.v;
+  if (2 * v[3] > v[2] + v[4]) {
+    if (v[0] < v[1]) {
+      ++v[0];
+      return;
+    }
+    if (v[1] < v[2]) {
+      ++v[1];
+      v[0] = 0;
+      return;
+    }
+    if (2 * (v[3] - 1) >= v[2] + v[4]) {
+      --v[3];
+      v[1] = 2 * v[3] > v[2] + v[4] ? 0 : v[2];
+      v[0] = 0;
+      return;
+    }
+  } else {
+    if (v[0] < 2 * v[1] - v[2]) {
+      ++v[0];
+      return;
+    }
+    if (2 * (v[1] - 1) >= v[2]) {
+      --v[1];
+      v[0] = 0;
+      return;
+    }
+  }
+  const int t = v[2] ? v[4] : v[4] + 1, w = v[2] ? v[2] - 1 : t;
+  c = {{0, w == t ? w : 0, w, t, t}, 1};
+}
+
+template <int N> constexpr std::int64_t rank(const chain<N> &c) noexcept {
+  if constexpr (N == 5) {
+    return rank_3j(c);
+  }
+  std::int64_t r = 0;
+  for (int i = 0; i < N; ++i) {
+    r += binomial(c.v[i] + i, i + 1);
+  }
+  return r;
+}
+
+template <int N> constexpr chain<N> unrank(std::int64_t r) noexcept {
+  if constexpr (N == 5) {
+    return unrank_3j(r);
+  }
+  chain<N> c{};
+  for (int i = N; i-- > 0;) {
+    std::int64_t x = i;
+    while (binomial(x + 1, i + 1) <= r) {
+      ++x;
+    }
+    r -= binomial(x, i + 1);
+    c.v[i] = static_cast<int>(x - i);
+  }
+  return c;
+}
+
+template <int N> constexpr void next(chain<N> &c) noexcept {
+  if constexpr (N == 5) {
+    next_3j(c);
+    return;
+  }
+  int i = 0;
+  while (i + 1 < N && c.v[i] == c.v[i + 1]) {
+    ++i;
+  }
+  ++c.v[i];
+  for (int j = 0; j < i; ++j) {
+    c.v[j] = 0;
+  }
+}
+
+/* arguments of a symbol of the class of a chain, as symmetry::representative_3j and representative_6j */
+constexpr symbol representative_3j(const chain<5> &c) noexcept {
+  const int *v = c.v;
+  const int e[3] = {0, v[2] - v[1], v[3] - v[1]};
+  const int o[3] = {v[0], v[1], v[1] + v[4] - v[3]};
+  symbol s{};
+  for (int col = 0; col < 3; ++col) {
+    const int r1 = e[(col + 2) % 3] + o[(col + 1) % 3];
+    const int r2 = e[(col + 1) % 3] + o[(col + 2) % 3];
+    s.two_j[col] = r1 + r2;
+    s.two_j[col + 3] = r2 - r1;
+  }
+  return s;
+}
+
+constexpr symbol representative_6j(const chain<6> &c) noexcept {
+  const int *v = c.v;
+  const int s = v[0], d1 = v[1] - v[0], d2 = v[2] - v[1], d3 = v[3] - v[2], e1 = v[4] - v[3], e2 = v[5] - v[4];
+  const int a4 = 3 * s + 2 * e1 + e2 + 3 * d1 + 2 * d2 + d3;
+  const int a3 = a4 - d1, a2 = a3 - d2, a1 = a2 - d3;
+  const int b1 = a4 + s, b2 = b1 + e1, b3 = b2 + e2;
+  return {{a1 + a2 - b2, a1 + a3 - b3, a1 + a4 - b1, a3 + a4 - b2, a2 + a4 - b3, a2 + a3 - b1}};
+}
+
+/* Classes without a symbol of two_j <= max_two_j have larger factorials than max_factorial and are left zero. */
+constexpr double eval_chain(const chain<5> &c) noexcept {
+  const auto a = representative_3j(c).two_j;
+  if ((a[0] + a[1] + a[2]) / 2 + 1 > max_factorial) {
+    return 0;
+  }
+  return eval_3j(a[0], a[1], a[2], a[3], a[4], a[5]);
+}
+
+constexpr double eval_chain(const chain<6> &c) noexcept {
+  const auto a = representative_6j(c).two_j;
+  const int beta1 = (a[0] + a[1] + a[3] + a[4]) / 2;
+  const int beta2 = (a[1] + a[2] + a[4] + a[5]) / 2;
+  const int beta3 = (a[2] + a[0] + a[5] + a[3]) / 2;
+  if (std::max({beta1, beta2, beta3}) + 1 > max_factorial) {
+    return 0;
+  }
+  return eval_6j(a[0], a[1], a[2], a[3], a[4], a[5]);
+}
+
+template <int N>
+inline constexpr std::size_t table_size =
+    static_cast<std::size_t>(N == 5 ? chains_3j_below(max_two_j + 1) : binomial(max_two_j + N, N));
+
+/* entries [begin, begin + block_size) of a table, every block is a constant expression of its own so that none of
+ * them runs into the evaluation limits of the compiler */
+inline constexpr std::size_t block_size = 64;
+
+template <std::size_t Size> struct values {
+  double v[Size];
+};
+
+template <int N, std::size_t Begin> inline constexpr auto block = [] {
+  values<block_size> b{};
+  auto c = unrank<N>(static_cast<std::int64_t>(Begin));
+  for (std::size_t i = 0; i < block_size && Begin + i < table_size<N>; ++i, next(c)) {
+    b.v[i] = eval_chain(c);
+  }
+  return b;
+}();
+
+template <int N, std::size_t... Blocks> constexpr values<table_size<N>> join(std::index_sequence<Blocks...>) noexcept {
+  values<table_size<N>> table{};
+  std::size_t i = 0;
+  for (const double *b : {block<N, Blocks * block_size>.v...}) {
+    for (std::size_t j = 0; j < block_size && i < table_size<N>; ++j) {
+      table.v[i++] = b[j];
+    }
+  }
+  return table;
+}
+
+/* indexed by the rank of the chain of N entries, 5 for 3j and 6 for 6j symbols */
+template <int N>
+inline constexpr auto table = join<N>(std::make_index_sequence<(table_size<N> + block_size - 1) / block_size>{});
+
+inline constexpr auto sqrt_table = [] {
+  values<max_two_j + 2> b{};
+  for (int n = 0; n < max_two_j + 2; ++n) {
+    b.v[n] = static_cast<double>(sqrt(static_cast<float_type>(n)));
+  }
+  return b;
+}();
+
+/* not constexpr, so that reaching it in a constant expression is a compile error */
+[[noreturn]] inline void out_of_range(const char *name) noexcept {
+  std::fprintf(stderr, "error in wigcpp::tiny::%s: the symbol exceeds the tables of max_two_j = %d.\n", name,
+               max_two_j);
+  std::abort();
+}
+
+} // namespace detail
+
+[[nodiscard]] constexpr double three_j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3) noexcept {
+  if (detail::is_zero_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3)) {
+    return 0;
+  }
+  if (std::max({two_j1, two_j2, two_j3}) > max_two_j) {
+    detail::out_of_range("three_j");
+  }
+  const auto c = detail::canonicalize_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3);
+  const double value = detail::table<5>.v[detail::rank(c)];
+  return c.sign < 0 ? -value : value;
+}
+
+[[nodiscard]] constexpr double six_j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) noexcept {
+  if (detail::is_zero_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6)) {
+    return 0;
+  }
+  if (std::max({two_j1, two_j2, two_j3, two_j4, two_j5, two_j6}) > max_two_j) {
+    detail::out_of_range("six_j");
+  }
+  /* like the runtime, by the arguments rather than by the representative of their class */
+  if (!two_j1 || !two_j2 || !two_j3 || !two_j4 || !two_j5 || !two_j6) {
+    return detail::zero_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
+  }
+  const auto c = detail::canonicalize_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
+  return detail::table<6>.v[detail::rank(c)];
+}
+
+/* (-1)^(j1 - j2 + M) * sqrt(2J + 1) times the 3j symbol */
+[[nodiscard]] constexpr double cg(int two_j1, int two_j2, int two_m1, int two_m2, int two_J, int two_M) noexcept {
+  const double value = three_j(two_j1, two_j2, two_J, two_m1, two_m2, -two_M);
+  if (value == 0) {
+    return 0;
+  }
+  const double norm = detail::sqrt_table.v[two_J + 1];
+  return (((two_j1 - two_j2 + two_M) / 2) & 1) ? -norm * value : norm * value;
+}
+
+} // namespace wigcpp::tiny
+
+#endif /* __WIGCPP_TINY__ */
@@ -10,16 +10,67 @@
 #ifndef __WIGCPP_H__
 #define __WIGCPP_H__
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
+typedef struct wigcpp_table_file wigcpp_table_file;
+typedef void *(*wigcpp_alloc_fn)(size_t size, size_t alignment, void *user);
+typedef void (*wigcpp_free_fn)(void *ptr, size_t size, size_t alignment, void *user);
+
+int wigcpp_set_allocator(wigcpp_alloc_fn alloc, wigcpp_free_fn dealloc, void *user);
+
 void wigcpp_ensure_global(int max_two_j, int wigner_type);
+long long wigcpp_plan_memory(int max_two_j, int wigner_type, int num_threads, long long cache_bytes,
+                             long long *pool_bytes, long long *thread_bytes);
+int wigcpp_ensure_global_budget(int max_two_j, int wigner_type, int num_threads, long long budget_bytes);
+void wigcpp_release();
 void wigcpp_reset_tls();
+void wigcpp_recycle_tls(int max_storages);
+void wigcpp_shrink_tls();
+void wigcpp_cache_enable(long long max_bytes);
+void wigcpp_cache_disable();
+void wigcpp_cache_stats(long long *hits, long long *misses);
+void wigcpp_cache_reset_stats();
+void wigcpp_parallel_sums(int num_threads);
+long long wigcpp_table_size(int wigner_type, int max_two_j);
+void wigcpp_table_fill(int wigner_type, int max_two_j, double *table, int num_threads);
+long long wigcpp_table_index_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3, int *sign);
+long long wigcpp_table_index_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6);
+wigcpp_table_file *wigcpp_table_open(const char *path, int verify);
+void wigcpp_table_close(wigcpp_table_file *table);
+double wigcpp_table_lookup_3j(const wigcpp_table_file *table, int two_j1, int two_j2, int two_j3, int two_m1, int two_m2,
+                              int two_m3);
+double wigcpp_table_lookup_6j(const wigcpp_table_file *table, int two_j1, int two_j2, int two_j3, int two_j4, int two_j5,
+                              int two_j6);
+double wigcpp_table_lookup_9j(const wigcpp_table_file *table, int two_j1, int two_j2, int two_j3, int two_j4, int two_j5,
+                              int two_j6, int two_j7, int two_j8, int two_j9);
+void wigcpp_batch_3j(const int *two_j, long long count, double *results);
+void wigcpp_batch_6j(const int *two_j, long long count, double *results);
+void wigcpp_batch_dedup(int enable);
+void wigcpp_executor_init(int num_threads, int pin_threads);
+void wigcpp_executor_shutdown();
+double wigcpp_estimate_cost(int wigner_type, const int *two_j);
+void wigcpp_eval_batch_parallel(int wigner_type, const int *two_j, long long count, double *results);
+double wigcpp_tiered_cg(int two_j1, int two_j2, int two_m1, int two_m2, int two_J, int two_M);
+double wigcpp_tiered_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3);
+double wigcpp_tiered_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6);
+double wigcpp_asymptotic_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3, double *error);
+double wigcpp_asymptotic_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6, double *error);
+int wigcpp_family_3j_j(int two_j2, int two_j3, int two_m2, int two_m3, int *two_j1_min, double *results);
+int wigcpp_family_3j_m(int two_j1, int two_j2, int two_j3, int two_m1, int *two_m2_min, double *results);
+int wigcpp_family_6j(int two_j2, int two_j3, int two_j4, int two_j5, int two_j6, int *two_j1_min, double *results);
 double clebsch_gordan(int two_j1, int two_j2, int two_m1, int two_m2, int two_J, int two_M);
 double wigner3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3);
 double wigner6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6);
 double wigner9j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6, int two_j7, int two_j8,
                 int two_j9);
+long double clebsch_gordan_l(int two_j1, int two_j2, int two_m1, int two_m2, int two_J, int two_M);
+long double wigner3j_l(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3);
+long double wigner6j_l(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6);
+long double wigner9j_l(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6, int two_j7, int two_j8,
+                       int two_j9);
 #ifdef __cplusplus
 }
 #endif
@@ -15,14 +15,197 @@
 #ifdef __cplusplus
 namespace wigcpp {
 
+[[nodiscard]] inline bool set_allocator(wigcpp_alloc_fn alloc, wigcpp_free_fn dealloc, void *user = nullptr) {
+  return wigcpp_set_allocator(alloc, dealloc, user);
+}
+
 inline void ensure_global(int max_two_j, int wigner_type) {
   wigcpp_ensure_global(max_two_j, wigner_type);
 }
 
+[[nodiscard]] inline long long plan_memory(int max_two_j, int wigner_type, int num_threads = 0,
+                                           long long cache_bytes = 0) {
+  return wigcpp_plan_memory(max_two_j, wigner_type, num_threads, cache_bytes, nullptr, nullptr);
+}
+
+inline long long plan_memory(int max_two_j, int wigner_type, int num_threads, long long cache_bytes,
+                             long long &pool_bytes, long long &thread_bytes) {
+  return wigcpp_plan_memory(max_two_j, wigner_type, num_threads, cache_bytes, &pool_bytes, &thread_bytes);
+}
+
+[[nodiscard]] inline bool ensure_global_budget(int max_two_j, int wigner_type, int num_threads,
+                                               long long budget_bytes) {
+  return wigcpp_ensure_global_budget(max_two_j, wigner_type, num_threads, budget_bytes);
+}
+
+inline void release() {
+  wigcpp_release();
+}
+
 inline void reset_tls() {
   wigcpp_reset_tls();
 }
 
+inline void recycle_tls(int max_storages) {
+  wigcpp_recycle_tls(max_storages);
+}
+
+inline void shrink_tls() {
+  wigcpp_shrink_tls();
+}
+
+inline void cache_enable(long long max_bytes) {
+  wigcpp_cache_enable(max_bytes);
+}
+
+inline void cache_disable() {
+  wigcpp_cache_disable();
+}
+
+inline void cache_stats(long long &hits, long long &misses) {
+  wigcpp_cache_stats(&hits, &misses);
+}
+
+inline void cache_reset_stats() {
+  wigcpp_cache_reset_stats();
+}
+
+inline void parallel_sums(int num_threads = 0) {
+  wigcpp_parallel_sums(num_threads);
+}
+
+[[nodiscard]] inline long long table_size(int wigner_type, int max_two_j) {
+  return wigcpp_table_size(wigner_type, max_two_j);
+}
+
+inline void table_fill(int wigner_type, int max_two_j, double *table, int num_threads = 0) {
+  wigcpp_table_fill(wigner_type, max_two_j, table, num_threads);
+}
+
+[[nodiscard]] inline long long table_index_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3,
+                                              int &sign) {
+  return wigcpp_table_index_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3, &sign);
+}
+
+[[nodiscard]] inline long long table_index_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) {
+  return wigcpp_table_index_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
+}
+
+/* read-only view of a table file written by wigcpp-tablegen */
+class table_file {
+  wigcpp_table_file *handle;
+
+public:
+  explicit table_file(const char *path, bool verify = false) : handle(wigcpp_table_open(path, verify)) {}
+
+  ~table_file() {
+    wigcpp_table_close(handle);
+  }
+
+  table_file(const table_file &) = delete;
+  table_file &operator=(const table_file &) = delete;
+
+  table_file(table_file &&src) noexcept : handle(src.handle) {
+    src.handle = nullptr;
+  }
+
+  table_file &operator=(table_file &&src) noexcept {
+    if (this != &src) {
+      wigcpp_table_close(handle);
+      handle = src.handle;
+      src.handle = nullptr;
+    }
+    return *this;
+  }
+
+  explicit operator bool() const {
+    return handle != nullptr;
+  }
+
+  [[nodiscard]] double three_j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3) const {
+    return wigcpp_table_lookup_3j(handle, two_j1, two_j2, two_j3, two_m1, two_m2, two_m3);
+  }
+
+  [[nodiscard]] double six_j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) const {
+    return wigcpp_table_lookup_6j(handle, two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
+  }
+
+  [[nodiscard]] double nine_j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6, int two_j7,
+                              int two_j8, int two_j9) const {
+    return wigcpp_table_lookup_9j(handle, two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9);
+  }
+};
+
+inline void batch_3j(const int *two_j, long long count, double *results) {
+  wigcpp_batch_3j(two_j, count, results);
+}
+
+inline void batch_6j(const int *two_j, long long count, double *results) {
+  wigcpp_batch_6j(two_j, count, results);
+}
+
+inline void batch_dedup(bool enable = true) {
+  wigcpp_batch_dedup(enable);
+}
+
+inline void executor_init(int num_threads = 0, bool pin_threads = false) {
+  wigcpp_executor_init(num_threads, pin_threads);
+}
+
+inline void executor_shutdown() {
+  wigcpp_executor_shutdown();
+}
+
+[[nodiscard]] inline double estimate_cost(int wigner_type, const int *two_j) {
+  return wigcpp_estimate_cost(wigner_type, two_j);
+}
+
+inline void eval_batch_parallel(int wigner_type, const int *two_j, long long count, double *results) {
+  wigcpp_eval_batch_parallel(wigner_type, two_j, count, results);
+}
+
+[[nodiscard]] inline double tiered_cg(int two_j1, int two_j2, int two_m1, int two_m2, int two_J, int two_M) {
+  return wigcpp_tiered_cg(two_j1, two_j2, two_m1, two_m2, two_J, two_M);
+}
+
+[[nodiscard]] inline double tiered_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3) {
+  return wigcpp_tiered_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3);
+}
+
+[[nodiscard]] inline double tiered_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) {
+  return wigcpp_tiered_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
+}
+
+[[nodiscard]] inline double asymptotic_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3,
+                                         double &error) {
+  return wigcpp_asymptotic_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3, &error);
+}
+
+[[nodiscard]] inline double asymptotic_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3) {
+  return wigcpp_asymptotic_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3, nullptr);
+}
+
+[[nodiscard]] inline double asymptotic_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6,
+                                         double &error) {
+  return wigcpp_asymptotic_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, &error);
+}
+
+[[nodiscard]] inline double asymptotic_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) {
+  return wigcpp_asymptotic_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, nullptr);
+}
+
+inline int family_3j_j(int two_j2, int two_j3, int two_m2, int two_m3, int &two_j1_min, double *results) {
+  return wigcpp_family_3j_j(two_j2, two_j3, two_m2, two_m3, &two_j1_min, results);
+}
+
+inline int family_3j_m(int two_j1, int two_j2, int two_j3, int two_m1, int &two_m2_min, double *results) {
+  return wigcpp_family_3j_m(two_j1, two_j2, two_j3, two_m1, &two_m2_min, results);
+}
+
+inline int family_6j(int two_j2, int two_j3, int two_j4, int two_j5, int two_j6, int &two_j1_min, double *results) {
+  return wigcpp_family_6j(two_j2, two_j3, two_j4, two_j5, two_j6, &two_j1_min, results);
+}
+
 [[nodiscard]] inline double cg(int two_j1, int two_j2, int two_m1, int two_m2, int two_J, int two_M) {
   return clebsch_gordan(two_j1, two_j2, two_m1, two_m2, two_J, two_M);
 }
@@ -40,6 +223,24 @@ inline void reset_tls() {
   return wigner9j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9);
 }
 
+/* evaluated in long double whatever the build, and never cached */
+[[nodiscard]] inline long double cg_l(int two_j1, int two_j2, int two_m1, int two_m2, int two_J, int two_M) {
+  return clebsch_gordan_l(two_j1, two_j2, two_m1, two_m2, two_J, two_M);
+}
+
+[[nodiscard]] inline long double three_j_l(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3) {
+  return wigner3j_l(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3);
+}
+
+[[nodiscard]] inline long double six_j_l(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) {
+  return wigner6j_l(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
+}
+
+[[nodiscard]] inline long double nine_j_l(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6,
+                                          int two_j7, int two_j8, int two_j9) {
+  return wigner9j_l(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9);
+}
+
 } // namespace wigcpp
 #endif
 #endif /* WIGCPP_CPLUS_WRAPPER */
\ No newline at end of file
@@ -0,0 +1,263 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "internal/asymptotic.hpp"
+#include "internal/calc.hpp"
+#include "internal/definitions.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace wigcpp::internal::asymptotic {
+
+namespace {
+using real = def::double_type;
+using calc::TrivialZero;
+
+constexpr real pi = 3.141592653589793238462643383279502884L;
+constexpr real epsilon = std::numeric_limits<real>::epsilon();
+
+/* Ai(x) from its Maclaurin series, for |x| where the cancellation between the two series stays small */
+real airy_series(real x) noexcept {
+  constexpr real ai0 = 0.355028053887817239260063186004183177L;  /* Ai(0) */
+  constexpr real dai0 = 0.258819403792806798405183560189203964L; /* -Ai'(0) */
+  const real x3 = x * x * x;
+  real f = 1, g = x, tf = 1, tg = x;
+  for (int k = 0; k < 200; ++k) {
+    tf *= x3 / ((3 * k + 2) * (3 * k + 3));
+    tg *= x3 / ((3 * k + 3) * (3 * k + 4));
+    f += tf;
+    g += tg;
+    if (std::fabs(tf) + std::fabs(tg) <= epsilon * (std::fabs(f) + std::fabs(g))) {
+      break;
+    }
+  }
+  return ai0 * f - dai0 * g;
+}
+
+/* The Airy factors of the uniform approximation as functions of the phase phi = 2/3 t^(3/2) accumulated from the
+ * caustic, sqrt(pi) t^(1/4) Ai(-t) on the allowed side and sqrt(pi) t^(1/4) Ai(t) on the forbidden side. Far from the
+ * caustic they take the asymptotic expansions in phi, cos(phi - pi/4) and exp(-phi) / 2 to leading order, truncated
+ * at their smallest term. */
+real airy_allowed(real phi) noexcept {
+  if (phi < 15) {
+    const real t = std::cbrt(real(1.5) * phi * real(1.5) * phi);
+    return std::sqrt(pi * std::sqrt(t)) * airy_series(-t);
+  }
+  /* the terms u_k / phi^k alternate in pairs, the even ones in p and the odd ones in q */
+  real p = 1, q = 0, term = 1;
+  for (int k = 0; k < 100; ++k) {
+    const real next = term * (6 * k + 5) * (6 * k + 3) * (6 * k + 1) / (216 * (2 * k + 1) * (k + 1) * phi);
+    if (next > term || next < epsilon) {
+      break;
+    }
+    term = next;
+    ((k + 1) % 2 ? q : p) += (k + 1) % 4 < 2 ? term : -term;
+  }
+  return p * std::cos(phi - pi / 4) + q * std::sin(phi - pi / 4);
+}
+
+real airy_forbidden(real phi) noexcept {
+  if (phi < 7) {
+    const real t = std::cbrt(real(1.5) * phi * real(1.5) * phi);
+    return std::sqrt(pi * std::sqrt(t)) * airy_series(t);
+  }
+  real sum = 1, term = 1;
+  for (int k = 0; k < 100; ++k) {
+    const real next = term * (6 * k + 5) * (6 * k + 3) * (6 * k + 1) / (216 * (2 * k + 1) * (k + 1) * phi);
+    if (next > term || next < epsilon) {
+      break;
+    }
+    term = next;
+    sum += k % 2 ? term : -term;
+  }
+  return std::exp(-phi) / 2 * sum;
+}
+
+/* The semiclassical phase is sum_i weight_i * theta_i over exterior angles theta_i given by their cosines. sq is the
+ * squared volume or area, positive in the classically allowed region. There the angles are real, beyond the caustic
+ * they continue to i * a or pi - i * a with the cosines outside [-1, 1]. */
+struct geometry {
+  real sq;
+  real weight[6];
+  real cosine[6];
+  int size;
+};
+
+/* The uniform approximation relative to the sign of the symbol, false at the caustic itself, where the envelope
+ * 1 / sqrt(scale * sqrt|sq|) is infinite and the Airy factor is zero. The phase is measured from the flat
+ * configuration nearest in angles, whose angles 0 and pi sum to a multiple of pi / 2, and whose residue fixes how the
+ * Airy function joins the Ponzano-Regge phase. Far from the caustic, where the nearest flat angles don't join, the
+ * Ponzano-Regge formula itself is returned. modulus receives the local amplitude of the oscillation, the envelope
+ * times sqrt(pi) t^(1/4) (Ai^2(-t) + Bi^2(-t))^(1/2) ~ (t / (t + 0.4))^(1/4) in the allowed region and the decaying
+ * value itself beyond the caustic. */
+bool uniform(const geometry &g, real scale, real &value, real &modulus) noexcept {
+  real phase = 0, flat = 0;
+  for (int i = 0; i < g.size; ++i) {
+    const real x = g.cosine[i];
+    if (g.sq > 0) {
+      phase += g.weight[i] * std::acos(std::clamp(x, real(-1), real(1)));
+    } else {
+      phase += (x < 0 ? -g.weight[i] : g.weight[i]) * std::acosh(std::max(std::fabs(x), real(1)));
+    }
+    flat += x < 0 ? g.weight[i] : 0;
+  }
+  /* the weights are multiples of 1/2 */
+  const long long quarter = static_cast<long long>(std::llround(2 * flat)) & 3;
+  const real kappa = (quarter == 1 || quarter == 2) ? -1 : 1;
+
+  const real envelope = 1 / std::sqrt(scale * std::sqrt(std::fabs(g.sq)));
+  if (g.sq > 0) {
+    phase -= pi * flat;
+    if ((phase < 0) != (quarter % 2 == 0)) {
+      value = envelope * std::cos(phase + pi * flat + pi / 4);
+      modulus = envelope;
+      return true;
+    }
+  }
+  const real phi = std::fabs(phase);
+  if (!(phi > 1e-9) || !std::isfinite(envelope)) {
+    return false;
+  }
+  if (g.sq > 0) {
+    const real t = std::cbrt(real(1.5) * phi * real(1.5) * phi);
+    value = kappa * envelope * airy_allowed(phi);
+    modulus = envelope * std::sqrt(std::sqrt(t / (t + real(0.4))));
+  } else {
+    modulus = envelope * airy_forbidden(phi);
+    value = kappa * modulus;
+  }
+  return true;
+}
+
+/* cosine of the exterior dihedral angle at the edge (a, b) between the faces (a, b, c) and (a, b, d), from the
+ * squared edge lengths */
+real exterior_cosine(const real (&d2)[4][4], int a, int b, int c, int d) noexcept {
+  const real uu = d2[a][b], vv = d2[a][c], ww = d2[a][d];
+  const real uv = (uu + vv - d2[b][c]) / 2, uw = (uu + ww - d2[b][d]) / 2, vw = (vv + ww - d2[c][d]) / 2;
+  return (uw * uv - uu * vw) / std::sqrt((uu * vv - uv * uv) * (uu * ww - uw * uw));
+}
+
+/* The tetrahedron A, B, C, D with j1 = BC, j2 = CA, j3 = AB, j4 = DA, j5 = DB, j6 = DC, so that the triads of the
+ * symbol are its faces. Edge lengths are j + 1/2, the first one shifted by delta. */
+geometry geometry_6j(const real (&length)[6], real delta) noexcept {
+  constexpr int edge[6][4] = {{1, 2, 0, 3}, {2, 0, 1, 3}, {0, 1, 2, 3}, {3, 0, 1, 2}, {3, 1, 0, 2}, {3, 2, 0, 1}};
+  real d2[4][4] = {};
+  geometry g{};
+  for (int i = 0; i < 6; ++i) {
+    const real l = length[i] + (i == 0 ? delta : 0);
+    d2[edge[i][0]][edge[i][1]] = d2[edge[i][1]][edge[i][0]] = l * l;
+    g.weight[i] = l;
+  }
+  for (int i = 0; i < 6; ++i) {
+    g.cosine[i] = exterior_cosine(d2, edge[i][0], edge[i][1], edge[i][2], edge[i][3]);
+  }
+  /* squared volume, the Gram determinant of the edges from A over 36 */
+  const real b = d2[0][1], c = d2[0][2], d = d2[0][3];
+  const real bc = (b + c - d2[1][2]) / 2, bd = (b + d - d2[1][3]) / 2, cd = (c + d - d2[2][3]) / 2;
+  g.sq = (b * (c * d - cd * cd) - bc * (bc * d - cd * bd) + bd * (bc * cd - c * bd)) / 36;
+  g.size = 6;
+  return g;
+}
+
+/* The triangle P0, P1, P2 of the vectors j_i + 1/2 with z components m_i, P0 -> P1 the first, placed at the heights
+ * 0, m1, m1 + m2. The phase sums the exterior angles at its edges between its plane and the vertical planes through
+ * them, weighted by j_i + 1/2, and the exterior angles of the projected triangle at its vertices, weighted by minus
+ * their heights. The first length is shifted by delta. */
+geometry geometry_3j(const real (&length)[3], const real (&m)[3], real delta) noexcept {
+  const real z[3] = {0, m[0], m[0] + m[1]};
+  real l2[3][3] = {};
+  for (int i = 0; i < 3; ++i) {
+    const real l = length[i] + (i == 0 ? delta : 0);
+    l2[i][(i + 1) % 3] = l2[(i + 1) % 3][i] = l * l;
+  }
+  geometry g{};
+  real r2[3];
+  for (int i = 0; i < 3; ++i) {
+    const int a = i, b = (i + 1) % 3, c = (i + 2) % 3;
+    const real uu = l2[a][b], vv = l2[a][c], uv = (uu + vv - l2[b][c]) / 2;
+    const real uz = z[b] - z[a], vz = z[c] - z[a];
+    r2[i] = uu - uz * uz;
+    g.weight[i] = std::sqrt(uu);
+    g.cosine[i] = (uz * uv - uu * vz) / std::sqrt((uu * vv - uv * uv) * r2[i]);
+  }
+  for (int v = 0; v < 3; ++v) {
+    /* the edges at P_v are v and v - 1, the opposite one v + 1 */
+    const real a = r2[v], b = r2[(v + 2) % 3], c = r2[(v + 1) % 3];
+    g.weight[3 + v] = -z[v];
+    g.cosine[3 + v] = (c - a - b) / (2 * std::sqrt(a * b));
+  }
+  g.sq = (2 * (r2[0] * r2[1] + r2[1] * r2[2] + r2[2] * r2[0]) - r2[0] * r2[0] - r2[1] * r2[1] - r2[2] * r2[2]) / 16;
+  g.size = 6;
+  return g;
+}
+
+/* the smallest height of the triangle, 2 * area / longest side */
+real height(real a, real b, real c) noexcept {
+  const real area4 = std::sqrt((a + b + c) * (b + c - a) * (a + c - b) * (a + b - c));
+  return area4 / (2 * std::max({a, b, c}));
+}
+
+/* At the caustic the approximation is the mean of its values a small shift of the first length away, the uniform
+ * approximation being smooth there. */
+template <typename Geometry>
+real evaluate(Geometry &&geometry, real scale, real &modulus) noexcept {
+  real value;
+  if (uniform(geometry(real(0)), scale, value, modulus)) {
+    return value;
+  }
+  constexpr real shift = real(1) / 1024;
+  real below, above, m_below, m_above;
+  uniform(geometry(-shift), scale, below, m_below);
+  uniform(geometry(shift), scale, above, m_above);
+  modulus = std::max(m_below, m_above);
+  return (below + above) / 2;
+}
+
+} // namespace
+
+double calc_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3, double &error) noexcept {
+  error = 0;
+  if (TrivialZero::is_zero_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3)) {
+    return 0;
+  }
+  const real length[3] = {real(two_j1 + 1) / 2, real(two_j2 + 1) / 2, real(two_j3 + 1) / 2};
+  const real m[3] = {real(two_m1) / 2, real(two_m2) / 2, real(two_m3) / 2};
+  real modulus;
+  const real value = evaluate([&](real delta) { return geometry_3j(length, m, delta); }, 2 * pi, modulus);
+
+  /* (-1)^(j1 - j2 + j3 + 1) */
+  const int sign = ((two_j1 - two_j2 + two_j3) / 2 + 1) % 2 ? -1 : 1;
+  /* the error grows as the triangle or the projections of its sides shrink */
+  real smallest = height(length[0], length[1], length[2]);
+  for (int i = 0; i < 3; ++i) {
+    smallest = std::min(smallest, std::sqrt(length[i] * length[i] - m[i] * m[i]));
+  }
+  error = static_cast<double>(modulus / smallest);
+  return static_cast<double>(sign * value);
+}
+
+double calc_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6, double &error) noexcept {
+  error = 0;
+  if (TrivialZero::is_zero_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6)) {
+    return 0;
+  }
+  const real length[6] = {real(two_j1 + 1) / 2, real(two_j2 + 1) / 2, real(two_j3 + 1) / 2,
+                          real(two_j4 + 1) / 2, real(two_j5 + 1) / 2, real(two_j6 + 1) / 2};
+  real modulus;
+  const real value = evaluate([&](real delta) { return geometry_6j(length, delta); }, 12 * pi, modulus);
+
+  /* the error grows as a face shrinks */
+  const real smallest = std::min({height(length[0], length[1], length[2]), height(length[0], length[4], length[5]),
+                                  height(length[3], length[1], length[5]), height(length[3], length[4], length[2])});
+  error = static_cast<double>(modulus / smallest);
+  return static_cast<double>(value);
+}
+
+} // namespace wigcpp::internal::asymptotic
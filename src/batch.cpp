@@ -0,0 +1,564 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "internal/batch.hpp"
+#include "internal/calc.hpp"
+#include "internal/definitions.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define WIGCPP_BATCH_X86
+#endif
+
+/* the kernels are templates instantiated inside functions with a target attribute, they have to be inlined there to
+ * be compiled for that target */
+#if defined(__GNUC__) || defined(__clang__)
+#define WIGCPP_BATCH_INLINE [[gnu::always_inline]] inline
+#else
+#define WIGCPP_BATCH_INLINE inline
+#endif
+
+namespace wigcpp::internal::batch {
+namespace {
+using calc::Calculator;
+using calc::TrivialZero;
+
+constexpr int max_terms = max_two_j + 1;
+constexpr int max_factorial = 2 * max_two_j + 1;
+constexpr int max_exp = 52; /* doubles hold integers below 2^53 exactly */
+
+constexpr bool is_prime(int n) noexcept {
+  for (int d = 2; d * d <= n; ++d) {
+    if (n % d == 0) {
+      return false;
+    }
+  }
+  return n >= 2;
+}
+
+constexpr int count_primes(int n) noexcept {
+  int count = 0;
+  for (int p = 2; p <= n; ++p) {
+    count += is_prime(p);
+  }
+  return count;
+}
+
+constexpr int max_primes = count_primes(max_factorial);
+
+/* p^e for e <= max_exp, exact whenever e * bit_width(p) <= max_exp */
+struct PowTable {
+  double prime[max_primes];
+  double pow[max_primes][max_exp + 1];
+};
+
+constexpr PowTable make_pow_table() noexcept {
+  PowTable table{};
+  for (int p = 2, i = 0; i < max_primes; ++p) {
+    if (!is_prime(p)) {
+      continue;
+    }
+    table.prime[i] = p;
+    table.pow[i][0] = 1;
+    for (int e = 1; e <= max_exp; ++e) {
+      table.pow[i][e] = table.pow[i][e - 1] * p;
+    }
+    ++i;
+  }
+  return table;
+}
+
+constexpr PowTable pow_table = make_pow_table();
+
+/* Exponents of the primes in n! and in n for n <= max_factorial, the same numbers as the rows of the pool but of a
+ * fixed width, so that the loops over them have a constant trip count and compile to a few vector instructions. */
+constexpr int exp_width = 16;
+static_assert(max_primes <= exp_width, "the exponents of a symbol must fit in one row");
+
+using exp_row = std::int16_t[exp_width];
+
+struct ExpTable {
+  exp_row fact[max_factorial + 1];
+  exp_row factor[max_factorial + 1];
+  exp_row bits; /* bit_width of the primes, 0 in the padding */
+};
+
+constexpr ExpTable make_exp_table() noexcept {
+  ExpTable table{};
+  for (int p = 2, i = 0; i < max_primes; ++p) {
+    if (!is_prime(p)) {
+      continue;
+    }
+    table.bits[i] = static_cast<std::int16_t>(std::bit_width(static_cast<unsigned>(p)));
+    for (int n = 1; n <= max_factorial; ++n) {
+      int e = 0;
+      for (int x = n; x % p == 0; x /= p) {
+        ++e;
+      }
+      table.factor[n][i] = static_cast<std::int16_t>(e);
+      table.fact[n][i] = static_cast<std::int16_t>(table.fact[n - 1][i] + e);
+    }
+    ++i;
+  }
+  return table;
+}
+
+constexpr ExpTable exp_table = make_exp_table();
+
+/* The sums of calcsum_3j and factor_6j: term k is the factorial of base[0] + dir[0] * k over the factorials of
+ * base[t] + dir[t] * k, t > 0. The prefactor is the product of the factorials of plus over those of minus. */
+struct Sum3j {
+  static constexpr int terms = 7, plus = 9, minus = 1;
+  static constexpr int dir[terms] = {0, 1, 1, 1, -1, -1, -1};
+};
+
+struct Sum6j {
+  static constexpr int terms = 8, plus = 12, minus = 4;
+  static constexpr int dir[terms] = {1, 1, 1, 1, 1, -1, -1, -1};
+};
+
+/* the symbols of a batch side by side, unused entries are 0, since 0! = 1 */
+template <int W, typename Sum> struct Lanes {
+  int base[Sum::terms][W];
+  int plus[Sum::plus][W];
+  int minus[Sum::minus][W];
+  int k_lim[W];
+  int sign[W];
+
+  /* the exact integers of eval_calcsum_info: the first term over the common factor of all terms, the sum, the
+   * numerator and divisor of the prefactor and the number under the square root */
+  double term[W];
+  double sum[W];
+  double nume[W];
+  double div[W];
+  double sqrt[W];
+  bool exact[W];
+
+  void clear(int l) noexcept {
+    for (int t = 0; t < Sum::terms; ++t) {
+      base[t][l] = 0;
+    }
+    for (int t = 0; t < Sum::plus; ++t) {
+      plus[t][l] = 0;
+    }
+    for (int t = 0; t < Sum::minus; ++t) {
+      minus[t][l] = 0;
+    }
+    k_lim[l] = sign[l] = 0;
+  }
+};
+
+template <int W> using Lanes3j = Lanes<W, Sum3j>;
+template <int W> using Lanes6j = Lanes<W, Sum6j>;
+
+enum class Lane { zero, kernel, calculator };
+
+/* the factorials of delta_coeff */
+void set_delta(int *plus, int &minus, int two_a, int two_b, int two_c) noexcept {
+  plus[0] = (two_a + two_b - two_c) / 2;
+  plus[1] = (two_a - two_b + two_c) / 2;
+  plus[2] = (-two_a + two_b + two_c) / 2;
+  minus = (two_a + two_b + two_c) / 2 + 1;
+}
+
+template <typename L>
+WIGCPP_BATCH_INLINE void set_terms(L &lanes, int l, std::initializer_list<int> base) noexcept {
+  int t = 0;
+  for (const int b : base) {
+    lanes.base[t++][l] = b;
+  }
+}
+
+/* follows Calculator::calc_3j, calcsum_3j and calcsum_3j_m0 */
+template <int W>
+WIGCPP_BATCH_INLINE Lane setup_3j(const GlobalFactorialPool &pool, Lanes3j<W> &lanes, int l, const int *s) noexcept {
+  const int two_j1 = s[0], two_j2 = s[1], two_j3 = s[2], two_m1 = s[3], two_m2 = s[4], two_m3 = s[5];
+  if (TrivialZero::is_zero_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3)) {
+    return Lane::zero;
+  }
+  const int max_fact = (two_j1 + two_j2 + two_j3) / 2 + 1;
+  if (std::max({two_j1, two_j2, two_j3}) > max_two_j || max_fact > static_cast<int>(pool.prime_table.max_factorial)) {
+    return Lane::calculator;
+  }
+
+  int delta[3];
+  set_delta(delta, lanes.minus[0][l], two_j1, two_j2, two_j3);
+
+  if (!two_m1 && !two_m2 && !two_m3) {
+    if (((two_j1 + two_j2 + two_j3) / 2) & 1) {
+      return Lane::zero;
+    }
+    const int g = (two_j1 + two_j2 + two_j3) / 4;
+    set_terms(lanes, l, {g, g - two_j1 / 2, g - two_j2 / 2, g - two_j3 / 2, 0, 0, 0});
+    lanes.k_lim[l] = 0;
+    lanes.sign[l] = g;
+    for (int t = 0; t < 9; ++t) {
+      lanes.plus[t][l] = t < 3 ? delta[t] : 0;
+    }
+    return Lane::kernel;
+  }
+
+  const int k_min = std::max({two_j1 + two_m2 - two_j3, two_j2 - two_m1 - two_j3, 0}) / 2;
+  const int k_max = std::min({two_j2 + two_m2, two_j1 - two_m1, two_j1 + two_j2 - two_j3}) / 2;
+  lanes.k_lim[l] = k_max - k_min;
+  lanes.sign[l] = k_min ^ ((two_j1 - two_j2 - two_m3) / 2);
+
+  set_terms(lanes, l,
+            {0, k_min, k_min + (two_j3 - two_j1 - two_m2) / 2, k_min + (two_j3 - two_j2 + two_m1) / 2,
+             (two_j2 + two_m2) / 2 - k_min, (two_j1 - two_m1) / 2 - k_min, (two_j1 + two_j2 - two_j3) / 2 - k_min});
+
+  const int plus[9] = {delta[0],
+                       delta[1],
+                       delta[2],
+                       (two_j1 - two_m1) / 2,
+                       (two_j1 + two_m1) / 2,
+                       (two_j2 - two_m2) / 2,
+                       (two_j2 + two_m2) / 2,
+                       (two_j3 - two_m3) / 2,
+                       (two_j3 + two_m3) / 2};
+  for (int t = 0; t < 9; ++t) {
+    lanes.plus[t][l] = plus[t];
+  }
+  return Lane::kernel;
+}
+
+/* follows Calculator::calc_6j and calcsum_6j, symbols with a zero argument take the closed form of the Calculator */
+template <int W>
+WIGCPP_BATCH_INLINE Lane setup_6j(const GlobalFactorialPool &pool, Lanes6j<W> &lanes, int l, const int *s) noexcept {
+  if (TrivialZero::is_zero_6j(s[0], s[1], s[2], s[3], s[4], s[5])) {
+    return Lane::zero;
+  }
+  if (!s[0] || !s[1] || !s[2] || !s[3] || !s[4] || !s[5] || std::max({s[0], s[1], s[2], s[3], s[4], s[5]}) > max_two_j) {
+    return Lane::calculator;
+  }
+  const int two_a = s[0], two_b = s[1], two_c = s[4], two_d = s[3], two_e = s[2], two_f = s[5];
+
+  const int alpha1 = two_a + two_b + two_e;
+  const int alpha2 = two_c + two_d + two_e;
+  const int alpha3 = two_a + two_c + two_f;
+  const int alpha4 = two_b + two_d + two_f;
+  const int beta1 = two_a + two_b + two_c + two_d;
+  const int beta2 = two_a + two_d + two_e + two_f;
+  const int beta3 = two_b + two_c + two_e + two_f;
+
+  const int k_min = std::max({alpha1, alpha2, alpha3, alpha4}) / 2;
+  const int k_max = std::min({beta1, beta2, beta3}) / 2;
+
+  const int max_fact = std::max({k_max + 1, beta1 / 2, beta2 / 2, beta3 / 2});
+  if (max_fact > static_cast<int>(pool.prime_table.max_factorial) || k_max - k_min >= max_terms) {
+    return Lane::calculator;
+  }
+  lanes.k_lim[l] = k_max - k_min;
+  lanes.sign[l] = k_min;
+
+  set_terms(lanes, l,
+            {k_min + 1, k_min - alpha1 / 2, k_min - alpha2 / 2, k_min - alpha3 / 2, k_min - alpha4 / 2,
+             beta1 / 2 - k_min, beta2 / 2 - k_min, beta3 / 2 - k_min});
+
+  const int triads[4][3] = {{two_a, two_b, two_e}, {two_c, two_d, two_e}, {two_a, two_c, two_f}, {two_b, two_d, two_f}};
+  for (int d = 0; d < 4; ++d) {
+    int delta[3];
+    set_delta(delta, lanes.minus[d][l], triads[d][0], triads[d][1], triads[d][2]);
+    for (int t = 0; t < 3; ++t) {
+      lanes.plus[3 * d + t][l] = delta[t];
+    }
+  }
+  return Lane::kernel;
+}
+
+/* The per-symbol part of calcsum_* and eval_calcsum_info for lane l. The exponents of term 0 are those of its
+ * factorials, those of the following terms are tracked through the factors of the ratio of consecutive terms. This
+ * gives the minimum exponents of all terms, i.e. their common factor, and the bit size of the largest term without a
+ * row per term. Leaves the first term over the common factor and the prefactor split into numerator, divisor and
+ * square root, or clears exact if any of them doesn't fit.
+ */
+template <int W, typename Sum> WIGCPP_BATCH_INLINE void prepare(Lanes<W, Sum> &lanes, int l) noexcept {
+  const int k_lim = lanes.k_lim[l];
+
+  exp_row first, cur, min_e;
+  for (int i = 0; i < exp_width; ++i) {
+    int e = exp_table.fact[lanes.base[0][l]][i];
+    for (int t = 1; t < Sum::terms; ++t) {
+      e -= exp_table.fact[lanes.base[t][l]][i];
+    }
+    first[i] = cur[i] = min_e[i] = static_cast<std::int16_t>(e);
+  }
+
+  const auto row_bits = [](const exp_row &row) {
+    int bits = 0;
+    for (int i = 0; i < exp_width; ++i) {
+      bits += row[i] * exp_table.bits[i];
+    }
+    return bits;
+  };
+
+  int max_bits = row_bits(cur);
+  for (int k = 0; k < k_lim; ++k) {
+    /* term k + 1 over term k */
+    exp_row up{}, down{};
+    for (int t = 0; t < Sum::terms; ++t) {
+      if (!Sum::dir[t]) {
+        continue;
+      }
+      const int step = Sum::dir[t] > 0 ? k + 1 : -k;
+      const std::int16_t *f = exp_table.factor[lanes.base[t][l] + step];
+      std::int16_t *dest = (t == 0) == (Sum::dir[t] > 0) ? up : down;
+      for (int i = 0; i < exp_width; ++i) {
+        dest[i] = static_cast<std::int16_t>(dest[i] + f[i]);
+      }
+    }
+    for (int i = 0; i < exp_width; ++i) {
+      cur[i] = static_cast<std::int16_t>(cur[i] + up[i] - down[i]);
+    }
+    for (int i = 0; i < exp_width; ++i) {
+      min_e[i] = std::min(min_e[i], cur[i]);
+    }
+    max_bits = std::max(max_bits, row_bits(cur));
+  }
+
+  exp_row pre;
+  for (int i = 0; i < exp_width; ++i) {
+    int e = 0;
+    for (int t = 0; t < Sum::plus; ++t) {
+      e += exp_table.fact[lanes.plus[t][l]][i];
+    }
+    for (int t = 0; t < Sum::minus; ++t) {
+      e -= exp_table.fact[lanes.minus[t][l]][i];
+    }
+    pre[i] = static_cast<std::int16_t>(e);
+  }
+
+  /* split_sqrt_add */
+  exp_row odd, nume_e, div_e;
+  for (int i = 0; i < exp_width; ++i) {
+    odd[i] = static_cast<std::int16_t>(pre[i] & 1);
+    const int e = (pre[i] + odd[i]) / 2 + min_e[i];
+    nume_e[i] = static_cast<std::int16_t>(std::max(e, 0));
+    div_e[i] = static_cast<std::int16_t>(std::max(-e, 0));
+  }
+
+  const int term_bits = max_bits - row_bits(min_e) + std::bit_width(static_cast<unsigned>(k_lim + 1));
+  const int nume_bits = row_bits(nume_e), div_bits = row_bits(div_e), sqrt_bits = row_bits(odd);
+  constexpr int max_prod_bits = sizeof(def::dword_t) * 8 - 1;
+  lanes.exact[l] = term_bits <= max_exp && nume_bits <= max_exp && div_bits <= max_exp && sqrt_bits <= max_exp &&
+                   nume_bits + term_bits <= max_prod_bits;
+  if (!lanes.exact[l]) {
+    lanes.k_lim[l] = 0;
+    lanes.term[l] = 0;
+    return;
+  }
+
+  double term = 1, nume = 1, div = 1, sqrt = 1;
+  for (int i = 0; i < max_primes; ++i) {
+    term *= pow_table.pow[i][first[i] - min_e[i]];
+    nume *= pow_table.pow[i][nume_e[i]];
+    div *= pow_table.pow[i][div_e[i]];
+    sqrt *= odd[i] ? pow_table.prime[i] : 1.0;
+  }
+  lanes.term[l] = term;
+  lanes.nume[l] = nume;
+  lanes.div[l] = div;
+  lanes.sqrt[l] = sqrt;
+}
+
+/* t * n / d for a quotient known to be an integer below 2^53: the quotient rounded in doubles is off by at most 2,
+ * the remainder t * n - q * d is small and exact in wrap-around arithmetic */
+WIGCPP_BATCH_INLINE double exact_ratio(double t, std::int64_t n, std::int64_t d) noexcept {
+  const auto q = static_cast<std::int64_t>(t * static_cast<double>(n) / static_cast<double>(d));
+  const auto r = static_cast<std::uint64_t>(static_cast<std::int64_t>(t)) * static_cast<std::uint64_t>(n) -
+                 static_cast<std::uint64_t>(q) * static_cast<std::uint64_t>(d);
+  return static_cast<double>(
+      q + static_cast<std::int64_t>(static_cast<double>(static_cast<std::int64_t>(r)) / static_cast<double>(d)));
+}
+
+/* The lane-parallel part: every term from the one before and the alternating sum, masked past the last term of a
+ * lane. All terms are integers below 2^52, so the sum is exact too. */
+template <int W, typename Sum>
+WIGCPP_BATCH_INLINE void sum_terms(Lanes<W, Sum> &lanes, int num_terms) noexcept {
+  double term[W];
+  for (int l = 0; l < W; ++l) {
+    term[l] = lanes.term[l];
+    lanes.sum[l] = 0;
+  }
+  for (int k = 0; k < num_terms; ++k) {
+    for (int l = 0; l < W; ++l) {
+      const double signed_term = ((k ^ lanes.sign[l]) & 1) ? -term[l] : term[l];
+      lanes.sum[l] += k <= lanes.k_lim[l] ? signed_term : 0.0;
+
+      const bool next = k < lanes.k_lim[l];
+      std::int64_t n = 1, d = 1;
+      for (int t = 0; t < Sum::terms; ++t) {
+        if (t == 0 && Sum::dir[t] > 0) {
+          n *= next ? lanes.base[t][l] + k + 1 : 1;
+        } else if (t > 0 && Sum::dir[t] < 0) {
+          n *= next ? lanes.base[t][l] - k : 1;
+        } else if (t > 0 && Sum::dir[t] > 0) {
+          d *= next ? lanes.base[t][l] + k + 1 : 1;
+        }
+      }
+      term[l] = exact_ratio(term[l], n, d);
+    }
+  }
+}
+
+/* the roundings of eval_fixed in calc.cpp */
+double finish(double sum, double nume, double div, double sqrt) noexcept {
+  const auto nume_prod = static_cast<def::dword_t>(static_cast<std::int64_t>(nume)) * static_cast<std::int64_t>(sum);
+  const def::eval_type result =
+      (static_cast<def::eval_type>(nume_prod) / static_cast<def::eval_type>(static_cast<std::uint64_t>(div))) /
+      std::sqrt(static_cast<def::eval_type>(static_cast<std::uint64_t>(sqrt)));
+  return static_cast<double>(result);
+}
+
+template <int W, typename L, typename Setup, typename Fallback>
+WIGCPP_BATCH_INLINE void run(const int *two_j, std::size_t count, double *results, Setup setup,
+                             Fallback fallback) noexcept {
+  for (std::size_t first = 0; first < count; first += W) {
+    const int n = static_cast<int>(std::min<std::size_t>(W, count - first));
+    L lanes;
+    Lane state[W];
+    int num_terms = 0;
+    for (int l = 0; l < W; ++l) {
+      lanes.clear(l);
+      state[l] = l < n ? setup(lanes, l, two_j + 6 * (first + l)) : Lane::zero;
+      if (state[l] != Lane::kernel) {
+        lanes.clear(l);
+        lanes.term[l] = 0;
+        continue;
+      }
+      prepare(lanes, l);
+      num_terms = std::max(num_terms, lanes.k_lim[l] + 1);
+    }
+
+    sum_terms(lanes, num_terms);
+
+    for (int l = 0; l < n; ++l) {
+      const int *s = two_j + 6 * (first + l);
+      double &result = results[first + l];
+      if (state[l] == Lane::zero) {
+        result = 0;
+      } else if (state[l] == Lane::kernel && lanes.exact[l]) {
+        result = finish(lanes.sum[l], lanes.nume[l], lanes.div[l], lanes.sqrt[l]);
+      } else {
+        result = fallback(s);
+      }
+    }
+  }
+}
+
+template <int W>
+WIGCPP_BATCH_INLINE void run_3j(const GlobalFactorialPool &pool, TempStorage &csi, const int *two_j, std::size_t count,
+                                double *results) noexcept {
+  const auto setup = [&](Lanes3j<W> &lanes, int l, const int *s) { return setup_3j(pool, lanes, l, s); };
+  run<W, Lanes3j<W>>(two_j, count, results, setup, [&](const int *s) {
+    return static_cast<double>(Calculator::calc_3j(pool, csi, s[0], s[1], s[2], s[3], s[4], s[5]));
+  });
+}
+
+template <int W>
+WIGCPP_BATCH_INLINE void run_6j(const GlobalFactorialPool &pool, TempStorage &csi, const int *two_j, std::size_t count,
+                                double *results) noexcept {
+  const auto setup = [&](Lanes6j<W> &lanes, int l, const int *s) { return setup_6j(pool, lanes, l, s); };
+  run<W, Lanes6j<W>>(two_j, count, results, setup, [&](const int *s) {
+    return static_cast<double>(Calculator::calc_6j(pool, csi, s[0], s[1], s[2], s[3], s[4], s[5]));
+  });
+}
+
+#ifdef WIGCPP_BATCH_X86
+[[gnu::target("avx2,fma")]] void run_3j_avx2(const GlobalFactorialPool &pool, TempStorage &csi, const int *two_j,
+                                             std::size_t count, double *results) noexcept {
+  run_3j<8>(pool, csi, two_j, count, results);
+}
+
+[[gnu::target("avx2,fma")]] void run_6j_avx2(const GlobalFactorialPool &pool, TempStorage &csi, const int *two_j,
+                                             std::size_t count, double *results) noexcept {
+  run_6j<8>(pool, csi, two_j, count, results);
+}
+
+[[gnu::target("avx512f,avx512vl,avx512dq")]] void run_3j_avx512(const GlobalFactorialPool &pool, TempStorage &csi,
+                                                               const int *two_j, std::size_t count,
+                                                               double *results) noexcept {
+  run_3j<16>(pool, csi, two_j, count, results);
+}
+
+[[gnu::target("avx512f,avx512vl,avx512dq")]] void run_6j_avx512(const GlobalFactorialPool &pool, TempStorage &csi,
+                                                               const int *two_j, std::size_t count,
+                                                               double *results) noexcept {
+  run_6j<16>(pool, csi, two_j, count, results);
+}
+#endif
+} // namespace
+
+Isa native_isa() noexcept {
+#ifdef WIGCPP_BATCH_X86
+  static const Isa isa = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+        __builtin_cpu_supports("avx512dq")) {
+      return Isa::avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+      return Isa::avx2;
+    }
+    return Isa::scalar;
+  }();
+  return isa;
+#else
+  return Isa::scalar;
+#endif
+}
+
+int lane_count(Isa isa) noexcept {
+  switch (isa) {
+  case Isa::avx512:
+    return 16;
+  case Isa::avx2:
+    return 8;
+  default:
+    return 4;
+  }
+}
+
+void batch_3j(const GlobalFactorialPool &pool, TempStorage &csi, const int *two_j, std::size_t count, double *results,
+              Isa isa) noexcept {
+  switch (isa) {
+#ifdef WIGCPP_BATCH_X86
+  case Isa::avx512:
+    run_3j_avx512(pool, csi, two_j, count, results);
+    break;
+  case Isa::avx2:
+    run_3j_avx2(pool, csi, two_j, count, results);
+    break;
+#endif
+  default:
+    run_3j<4>(pool, csi, two_j, count, results);
+  }
+}
+
+void batch_6j(const GlobalFactorialPool &pool, TempStorage &csi, const int *two_j, std::size_t count, double *results,
+              Isa isa) noexcept {
+  switch (isa) {
+#ifdef WIGCPP_BATCH_X86
+  case Isa::avx512:
+    run_6j_avx512(pool, csi, two_j, count, results);
+    break;
+  case Isa::avx2:
+    run_6j_avx2(pool, csi, two_j, count, results);
+    break;
+#endif
+  default:
+    run_6j<4>(pool, csi, two_j, count, results);
+  }
+}
+
+} // namespace wigcpp::internal::batch
@@ -1,15 +1,67 @@
 #include "internal/big_int.hpp"
 #include "internal/definitions.hpp"
+#include "internal/mwi_kernels.hpp"
 #include <cstddef>
+#include <cassert>
 #include <cstring>
 #include <utility>
 #include <cmath>
 #include <string_view>
 #include <array>
+#ifdef WIGCPP_USE_GMP
+#include <gmp.h>
+#endif
 
 namespace wigcpp::internal::mwi {
 
-std::pair<def::double_type, int> big_int::to_floating_point() const noexcept {
+namespace {
+/* drops the words that only repeat the sign of the word below */
+void trim_sign_words(word_vector &words) noexcept {
+  const def::uword_t *first_free = words.cend();
+  const def::uword_t *begin = words.cbegin();
+  std::size_t i = words.size();
+
+  while (first_free - begin > 1 && *(first_free - 1) == def::full_sign_word(*(first_free - 2))) {
+    --first_free;
+    --i;
+  }
+  if (i != words.size()) {
+    words.resize(i);
+  }
+}
+} // namespace
+
+#ifdef WIGCPP_USE_GMP
+static_assert(sizeof(mp_limb_t) == sizeof(def::uword_t) && GMP_NAIL_BITS == 0, "GMP limbs must be the words of big_int");
+
+namespace {
+inline mp_limb_t *limbs(def::uword_t *p) noexcept {
+  return reinterpret_cast<mp_limb_t *>(p);
+}
+
+inline const mp_limb_t *limbs(const def::uword_t *p) noexcept {
+  return reinterpret_cast<const mp_limb_t *>(p);
+}
+
+/* the absolute value of src, in place unless it is negative and then negated into buffer. size receives its size
+ * without leading zero words */
+const def::uword_t *magnitude(const word_vector &src, bool negative, word_vector &buffer, std::size_t &size) noexcept {
+  size = src.size();
+  const def::uword_t *p = src.cbegin();
+  if (negative) {
+    buffer.resize(size);
+    mpn_neg(limbs(buffer.begin()), limbs(p), static_cast<mp_size_t>(size));
+    p = buffer.cbegin();
+  }
+  while (size > 1 && !p[size - 1]) {
+    --size;
+  }
+  return p;
+}
+} // namespace
+#endif
+
+template <typename Float> std::pair<Float, int> big_int::to_floating_point() const noexcept {
   std::size_t high = size() - 1;
 
   /* protective check: avoid existing extra sign bits */
@@ -18,23 +70,26 @@ std::pair<def::double_type, int> big_int::to_floating_point() const noexcept {
     high--;
   }
 
-  def::double_type ds = 0;
+  Float ds = 0;
 
   for (std::size_t i = 2; i >= 1; i--) {
     def::uword_t wi = (high >= i) ? data[high - i] : 0;
-    auto di = static_cast<def::double_type>(wi);
+    auto di = static_cast<Float>(wi);
     di = std::ldexp(di, -(static_cast<int>(i) * static_cast<int>(def::shift_bits)));
     ds += di;
   }
 
   def::uword_t wi = data[high];
-  auto di = static_cast<def::double_type>(static_cast<def::word_t>(wi));
+  auto di = static_cast<Float>(static_cast<def::word_t>(wi));
   ds += di;
 
   int exp = static_cast<int>(high * def::shift_bits);
   return {ds, exp};
 }
 
+template std::pair<double, int> big_int::to_floating_point<double>() const noexcept;
+template std::pair<long double, int> big_int::to_floating_point<long double>() const noexcept;
+
 big_int &big_int::operator+=(def::uword_t scalar) noexcept {
   const std::size_t this_oldsz = size();
 
@@ -65,22 +120,17 @@ big_int &big_int::operator+=(def::uword_t scalar) noexcept {
   return *this;
 }
 
-big_int &big_int::operator+=(const big_int &rhs) noexcept {
+big_int &big_int::add(const word_vector &rhs, def::uword_t rhs_sign_bits) noexcept {
   const std::size_t this_oldsz = size();
   const std::size_t rhs_sz = rhs.size();
 
   const def::uword_t this_sign_bits = def::full_sign_word(data.back());
-  const def::uword_t rhs_sign_bits = def::full_sign_word(rhs.data.back());
 
   def::uword_t carry = 0;
 
   if (rhs_sz <= this_oldsz) {
     data.reserve(this_oldsz + 1);
-    for (std::size_t i = 0; i < rhs_sz; i++) {
-      auto [s, overflow] = add_kernel(this->data[i], rhs[i], carry);
-      this->data[i] = s;
-      carry = overflow;
-    }
+    carry = kernel::native().add_n(data.begin(), data.cbegin(), rhs.cbegin(), rhs_sz, carry);
     for (std::size_t i = rhs_sz; i < this_oldsz; i++) {
       auto [s, overflow] = add_kernel(this->data[i], rhs_sign_bits, carry);
       this->data[i] = s;
@@ -89,11 +139,7 @@ big_int &big_int::operator+=(const big_int &rhs) noexcept {
   } else {
     data.reserve(rhs_sz + 1);
     data.resize(rhs_sz);
-    for (std::size_t i = 0; i < this_oldsz; i++) {
-      auto [s, overflow] = add_kernel(this->data[i], rhs[i], carry);
-      this->data[i] = s;
-      carry = overflow;
-    }
+    carry = kernel::native().add_n(data.begin(), data.cbegin(), rhs.cbegin(), this_oldsz, carry);
     for (std::size_t i = this_oldsz; i < rhs_sz; i++) {
       auto [s, overflow] = add_kernel(this_sign_bits, rhs[i], carry);
       this->data[i] = s;
@@ -115,6 +161,14 @@ big_int &big_int::operator+=(const big_int &rhs) noexcept {
   return *this;
 }
 
+big_int &big_int::operator+=(const big_int &rhs) noexcept {
+  return add(rhs.data, def::full_sign_word(rhs.data.back()));
+}
+
+big_int &big_int::operator+=(const big_nat &rhs) noexcept {
+  return add(rhs.data, 0);
+}
+
 big_int &big_int::operator-=(def::uword_t scalar) noexcept {
   const std::size_t this_oldsz = size();
 
@@ -146,21 +200,16 @@ big_int &big_int::operator-=(def::uword_t scalar) noexcept {
   return *this;
 }
 
-big_int &big_int::operator-=(const big_int &rhs) noexcept {
+big_int &big_int::sub(const word_vector &rhs, def::uword_t rhs_sign_bits) noexcept {
   const std::size_t this_oldsz = size();
   const std::size_t rhs_sz = rhs.size();
 
   const def::uword_t this_sign_bits = def::full_sign_word(data.back());
-  const def::uword_t rhs_sign_bits = def::full_sign_word(rhs.data.back());
 
   def::uword_t carry = 0;
   if (rhs_sz <= this_oldsz) {
     data.reserve(this_oldsz + 1);
-    for (std::size_t i = 0; i < rhs_sz; i++) {
-      auto [s, borrow] = sub_kernel(this->data[i], rhs[i], carry);
-      this->data[i] = s;
-      carry = borrow;
-    }
+    carry = kernel::native().sub_n(data.begin(), data.cbegin(), rhs.cbegin(), rhs_sz, carry);
     for (std::size_t i = rhs_sz; i < this_oldsz; i++) {
       auto [s, borrow] = sub_kernel(this->data[i], rhs_sign_bits, carry);
       this->data[i] = s;
@@ -169,11 +218,7 @@ big_int &big_int::operator-=(const big_int &rhs) noexcept {
   } else {
     data.reserve(rhs_sz + 1);
     data.resize(rhs_sz);
-    for (std::size_t i = 0; i < this_oldsz; i++) {
-      auto [s, borrow] = sub_kernel(this->data[i], rhs[i], carry);
-      this->data[i] = s;
-      carry = borrow;
-    }
+    carry = kernel::native().sub_n(data.begin(), data.cbegin(), rhs.cbegin(), this_oldsz, carry);
     for (std::size_t i = this_oldsz; i < rhs_sz; i++) {
       auto [s, borrow] = sub_kernel(this_sign_bits, rhs[i], carry);
       this->data[i] = s;
@@ -191,16 +236,27 @@ big_int &big_int::operator-=(const big_int &rhs) noexcept {
   return *this;
 }
 
+big_int &big_int::operator-=(const big_int &rhs) noexcept {
+  return sub(rhs.data, def::full_sign_word(rhs.data.back()));
+}
+
+big_int &big_int::operator-=(const big_nat &rhs) noexcept {
+  return sub(rhs.data, 0);
+}
+
 big_int &big_int::operator*=(def::uword_t factor) noexcept {
-  data.reserve(size() + 1);
-  def::uword_t from_lower = 0;
-  for (std::size_t i = 0; i < size(); ++i) {
-    auto [p, next_lower] = mul_kernel(this->data[i], factor, from_lower, 0);
-    this->data[i] = p;
-    from_lower = next_lower;
-  }
-  if (from_lower || data.back() & def::sign_bit) {
-    data.push_back(from_lower);
+  const std::size_t sz = size();
+  const def::uword_t sign_bits = def::full_sign_word(data.back());
+  data.reserve(sz + 1);
+#ifdef WIGCPP_USE_GMP
+  const def::uword_t from_lower = mpn_mul_1(limbs(data.begin()), limbs(data.cbegin()), static_cast<mp_size_t>(sz), factor);
+#else
+  const def::uword_t from_lower = kernel::native().mul_1(data.begin(), data.cbegin(), sz, factor);
+#endif
+  /* a negative number is the unsigned value of its words less the unit above them, so its high word loses factor */
+  const def::uword_t high = from_lower - (sign_bits & factor);
+  if (high != def::full_sign_word(data.back())) {
+    data.push_back(high);
   }
   return *this;
 }
@@ -210,6 +266,11 @@ big_int &big_int::operator*=(const big_int &rhs) noexcept {
   return *this;
 }
 
+big_int &big_int::operator*=(const big_nat &rhs) noexcept {
+  *this = *this * rhs;
+  return *this;
+}
+
 big_int big_int::operator-() const noexcept {
   big_int tmp = *this;
   for (std::size_t i = 0; i < size(); ++i) {
@@ -268,28 +329,48 @@ big_int operator*(def::uword_t factor, const big_int &src) noexcept {
 }
 
 big_int operator*(const big_int &src, const big_int &factor) noexcept {
+  return big_int::multiply(src.data, factor.data, def::full_sign_word(factor.data.back()));
+}
 
+big_int operator*(const big_int &src, const big_nat &factor) noexcept {
+  return big_int::multiply(src.data, factor.data, 0);
+}
+
+big_int big_int::multiply(const word_vector &src, const word_vector &factor, def::uword_t factor_sign_bits) noexcept {
+  const def::uword_t src_sign_bits = def::full_sign_word(src.cend()[-1]);
+#ifdef WIGCPP_USE_GMP
+  /* mpn_mul multiplies magnitudes, with Karatsuba, Toom-Cook or FFT multiplication by size */
+  word_vector src_abs, factor_abs;
+  std::size_t u_size, v_size;
+  const def::uword_t *u = magnitude(src, src_sign_bits, src_abs, u_size);
+  const def::uword_t *v = magnitude(factor, factor_sign_bits, factor_abs, v_size);
+  if (u_size < v_size) {
+    std::swap(u, v);
+    std::swap(u_size, v_size);
+  }
+
+  /* one more word for the sign */
+  const std::size_t result_size = u_size + v_size + 1;
+  word_vector result(result_size);
+  mpn_mul(limbs(result.begin()), limbs(u), static_cast<mp_size_t>(u_size), limbs(v), static_cast<mp_size_t>(v_size));
+  if (src_sign_bits != factor_sign_bits) {
+    mpn_neg(limbs(result.begin()), limbs(result.cbegin()), static_cast<mp_size_t>(result_size));
+  }
+#else
   const std::size_t src_size = src.size();
   const std::size_t factor_size = factor.size();
   const std::size_t result_size = src_size + factor_size;
 
-  container::vector<def::uword_t> result(result_size);
+  word_vector result(result_size);
 
-  const def::uword_t src_sign_bits = def::full_sign_word(src.data.back());
-  const def::uword_t factor_sign_bits = def::full_sign_word(factor.data.back());
+  const kernel::Kernels &kernels = kernel::native();
 
   for (std::size_t j = 0; j < factor_size; j++) {
     const std::size_t lim_i = result_size - j;
     const std::size_t lim_i2 = lim_i < src_size ? lim_i : src_size;
     const def::uword_t factor_j = factor[j];
 
-    def::uword_t from_lower = 0;
-
-    for (std::size_t i = 0; i < lim_i2; i++) {
-      auto [p, next_lower] = big_int::mul_kernel(src[i], factor_j, from_lower, result[i + j]);
-      result[i + j] = p;
-      from_lower = next_lower;
-    }
+    def::uword_t from_lower = kernels.addmul_1(result.begin() + j, src.cbegin(), lim_i2, factor_j);
 
     if (src_sign_bits) {
       for (std::size_t i = lim_i2; i < lim_i; i++) {
@@ -311,13 +392,7 @@ big_int operator*(const big_int &src, const big_int &factor) noexcept {
       const std::size_t lim_i = result_size - j;
       const std::size_t lim_i2 = lim_i < src_size ? lim_i : src_size;
 
-      def::uword_t from_lower = 0;
-
-      for (std::size_t i = 0; i < lim_i2; i++) {
-        auto [p, next_lower] = big_int::mul_kernel(src[i], factor_sign_bits, from_lower, result[i + j]);
-        result[i + j] = p;
-        from_lower = next_lower;
-      }
+      def::uword_t from_lower = kernels.addmul_1(result.begin() + j, src.cbegin(), lim_i2, factor_sign_bits);
 
       if (src_sign_bits) {
         for (std::size_t i = lim_i2; i < lim_i; i++) {
@@ -334,19 +409,9 @@ big_int operator*(const big_int &src, const big_int &factor) noexcept {
       }
     }
   }
+#endif
 
-  const def::uword_t *first_free = result.cend();
-  const def::uword_t *begin = result.cbegin();
-  std::size_t i = result_size;
-
-  while (first_free - begin > 1 && *(first_free - 1) == def::full_sign_word(*(first_free - 2))) {
-    --first_free;
-    --i;
-  }
-  if (i != result_size) {
-    result.resize(i);
-  }
-
+  trim_sign_words(result);
   return big_int(std::move(result));
 }
 
@@ -425,4 +490,32 @@ std::string big_int::to_hex_str() const {
   return std::string(it, length);
 }
 
-} // namespace wigcpp::internal::mwi
\ No newline at end of file
+void big_sum::reset(std::size_t words) noexcept {
+  pos.resize(words);
+  neg.resize(words);
+  std::memset(pos.begin(), 0, words * sizeof(def::uword_t));
+  std::memset(neg.begin(), 0, words * sizeof(def::uword_t));
+}
+
+void big_sum::accumulate(word_vector &sum, const big_nat &term) noexcept {
+  const std::size_t n = term.size();
+  assert(n <= sum.size());
+  def::uword_t *words = sum.begin();
+  def::uword_t carry = kernel::native().add_n(words, words, &term[0], n, 0);
+  for (std::size_t i = n; carry; ++i) {
+    assert(i < sum.size());
+    carry = !++words[i];
+  }
+}
+
+void big_sum::result(big_int &sum) const noexcept {
+  const std::size_t n = pos.size();
+  /* one more word for the sign */
+  word_vector words(n + 1);
+  const def::uword_t borrow = kernel::native().sub_n(words.begin(), pos.cbegin(), neg.cbegin(), n, 0);
+  words.begin()[n] = borrow ? ~def::uword_t(0) : 0;
+  trim_sign_words(words);
+  sum = big_int(std::move(words));
+}
+
+} // namespace wigcpp::internal::mwi
@@ -0,0 +1,115 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "internal/big_nat.hpp"
+#include "internal/definitions.hpp"
+#include "internal/mwi_kernels.hpp"
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#ifdef WIGCPP_USE_GMP
+#include <gmp.h>
+#endif
+
+namespace wigcpp::internal::mwi {
+
+#ifdef WIGCPP_USE_GMP
+namespace {
+inline mp_limb_t *limbs(def::uword_t *p) noexcept {
+  return reinterpret_cast<mp_limb_t *>(p);
+}
+
+inline const mp_limb_t *limbs(const def::uword_t *p) noexcept {
+  return reinterpret_cast<const mp_limb_t *>(p);
+}
+} // namespace
+#endif
+
+template <typename Float> std::pair<Float, int> big_nat::to_floating_point() const noexcept {
+  const std::size_t high = size() - 1;
+
+  Float ds = 0;
+  for (std::size_t i = 2; i >= 1; i--) {
+    const def::uword_t wi = (high >= i) ? data[high - i] : 0;
+    ds += std::ldexp(static_cast<Float>(wi), -(static_cast<int>(i) * static_cast<int>(def::shift_bits)));
+  }
+  ds += static_cast<Float>(data[high]);
+
+  return {ds, static_cast<int>(high * def::shift_bits)};
+}
+
+template std::pair<double, int> big_nat::to_floating_point<double>() const noexcept;
+template std::pair<long double, int> big_nat::to_floating_point<long double>() const noexcept;
+
+big_nat &big_nat::operator*=(def::uword_t factor) noexcept {
+  if (!factor) {
+    return *this = 0;
+  }
+  const std::size_t sz = size();
+  data.reserve(sz + 1);
+#ifdef WIGCPP_USE_GMP
+  const def::uword_t high = mpn_mul_1(limbs(data.begin()), limbs(data.cbegin()), static_cast<mp_size_t>(sz), factor);
+#else
+  const def::uword_t high = kernel::native().mul_1(data.begin(), data.cbegin(), sz, factor);
+#endif
+  if (high) {
+    data.push_back(high);
+  }
+  return *this;
+}
+
+big_nat &big_nat::operator*=(const big_nat &rhs) noexcept {
+  *this = *this * rhs;
+  return *this;
+}
+
+big_nat operator*(const big_nat &src, const big_nat &factor) noexcept {
+  if (src.is_zero() || factor.is_zero()) {
+    return big_nat(0);
+  }
+  const big_nat &u = src.size() >= factor.size() ? src : factor;
+  const big_nat &v = src.size() >= factor.size() ? factor : src;
+  const std::size_t u_size = u.size(), v_size = v.size();
+
+  big_nat result;
+  result.data.resize(u_size + v_size);
+#ifdef WIGCPP_USE_GMP
+  mpn_mul(limbs(result.data.begin()), limbs(u.data.cbegin()), static_cast<mp_size_t>(u_size),
+          limbs(v.data.cbegin()), static_cast<mp_size_t>(v_size));
+#else
+  const kernel::Kernels &kernels = kernel::native();
+  def::uword_t *r = result.data.begin();
+  r[u_size] = kernels.mul_1(r, u.data.cbegin(), u_size, v[0]);
+  for (std::size_t j = 1; j < v_size; ++j) {
+    r[u_size + j] = kernels.addmul_1(r + j, u.data.cbegin(), u_size, v[j]);
+  }
+#endif
+  if (!result.data.cend()[-1]) {
+    result.data.resize(u_size + v_size - 1);
+  }
+  return result;
+}
+
+std::string big_nat::to_hex_str() const {
+  constexpr std::size_t digits_per_word = sizeof(def::uword_t) * 2;
+  std::string buffer;
+  buffer.reserve(size() * digits_per_word);
+  for (std::size_t i = size(); i-- > 0;) {
+    for (std::size_t d = digits_per_word; d-- > 0;) {
+      const unsigned nibble = (data[i] >> (d * 4)) & 0xF;
+      if (buffer.empty() && !nibble) {
+        continue;
+      }
+      buffer.push_back(static_cast<char>(nibble < 10 ? '0' + nibble : 'a' + (nibble - 10)));
+    }
+  }
+  return buffer.empty() ? "0" : buffer;
+}
+
+} // namespace wigcpp::internal::mwi
@@ -8,10 +8,24 @@
  */
 
 #include "wigcpp/wigcpp.h"
+#include "internal/asymptotic.hpp"
+#include "internal/batch.hpp"
 #include "internal/global_pool.hpp"
 #include "internal/tmp_pool.hpp"
 #include "internal/error.hpp"
+#include "internal/executor.hpp"
+#include "internal/memory_plan.hpp"
+#include "internal/nothrow_allocator.hpp"
+#include "internal/parallel.hpp"
 #include "internal/calc.hpp"
+#include "internal/dedup.hpp"
+#include "internal/recurrence.hpp"
+#include "internal/symbol_cache.hpp"
+#include "internal/table.hpp"
+#include "internal/table_file.hpp"
+#include "internal/tiered.hpp"
+#include <cstdio>
+#include <new>
 
 #ifdef _WIN32
 #define API_EXPORT
@@ -19,6 +33,10 @@
 #define API_EXPORT __attribute__((visibility("default")))
 #endif
 
+API_EXPORT int wigcpp_set_allocator(wigcpp_alloc_fn alloc, wigcpp_free_fn dealloc, void *user) {
+  return wigcpp::internal::allocator::hooks::set(alloc, dealloc, user);
+}
+
 API_EXPORT void wigcpp_ensure_global(int max_two_j, int wigner_type) {
   if (wigner_type == 3 || wigner_type == 6 || wigner_type == 9) {
     wigcpp::internal::global::PoolManager::ensure(max_two_j, wigner_type);
@@ -27,10 +45,246 @@ API_EXPORT void wigcpp_ensure_global(int max_two_j, int wigner_type) {
   }
 }
 
+API_EXPORT long long wigcpp_plan_memory(int max_two_j, int wigner_type, int num_threads, long long cache_bytes,
+                                        long long *pool_bytes, long long *thread_bytes) {
+  const auto plan = wigcpp::internal::memory::plan(max_two_j, wigner_type, num_threads,
+                                                   cache_bytes > 0 ? static_cast<std::size_t>(cache_bytes) : 0);
+  if (pool_bytes) {
+    *pool_bytes = static_cast<long long>(plan.pool_bytes);
+  }
+  if (thread_bytes) {
+    *thread_bytes = static_cast<long long>(plan.thread_bytes);
+  }
+  return static_cast<long long>(plan.total());
+}
+
+API_EXPORT int wigcpp_ensure_global_budget(int max_two_j, int wigner_type, int num_threads, long long budget_bytes) {
+  return wigcpp::internal::memory::ensure_budget(max_two_j, wigner_type, num_threads,
+                                                 budget_bytes > 0 ? static_cast<std::size_t>(budget_bytes) : 0);
+}
+
+API_EXPORT void wigcpp_release() {
+  wigcpp::internal::memory::release();
+}
+
 API_EXPORT void wigcpp_reset_tls() {
   wigcpp::internal::tmp::TempManager::reset();
 }
 
+API_EXPORT void wigcpp_recycle_tls(int max_storages) {
+  wigcpp::internal::tmp::FreeList::set_cap(max_storages);
+}
+
+API_EXPORT void wigcpp_shrink_tls() {
+  wigcpp::internal::tmp::TempManager::shrink();
+}
+
+API_EXPORT void wigcpp_cache_enable(long long max_bytes) {
+  wigcpp::internal::cache::CacheManager::enable(max_bytes > 0 ? static_cast<std::size_t>(max_bytes) : 0);
+}
+
+API_EXPORT void wigcpp_cache_disable() {
+  wigcpp::internal::cache::CacheManager::disable();
+}
+
+API_EXPORT void wigcpp_cache_stats(long long *hits, long long *misses) {
+  const auto &stats = wigcpp::internal::cache::CacheManager::thread_stats();
+  if (hits) {
+    *hits = static_cast<long long>(stats.hits);
+  }
+  if (misses) {
+    *misses = static_cast<long long>(stats.misses);
+  }
+}
+
+API_EXPORT void wigcpp_cache_reset_stats() {
+  wigcpp::internal::cache::CacheManager::thread_stats() = {0, 0};
+}
+
+API_EXPORT void wigcpp_parallel_sums(int num_threads) {
+  wigcpp::internal::parallel::set_sum_threads(num_threads);
+}
+
+API_EXPORT long long wigcpp_table_size(int wigner_type, int max_two_j) {
+  return static_cast<long long>(wigcpp::internal::table::table_size(wigner_type, max_two_j));
+}
+
+API_EXPORT void wigcpp_table_fill(int wigner_type, int max_two_j, double *table, int num_threads) {
+  const auto &pool = wigcpp::internal::global::PoolManager::get();
+  wigcpp::internal::table::fill_table(pool, wigner_type, max_two_j, table, num_threads);
+}
+
+API_EXPORT long long wigcpp_table_index_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3,
+                                           int *sign) {
+  int s;
+  const auto index = wigcpp::internal::table::index_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3, s);
+  if (sign) {
+    *sign = s;
+  }
+  return index;
+}
+
+API_EXPORT long long wigcpp_table_index_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) {
+  return wigcpp::internal::table::index_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
+}
+
+struct wigcpp_table_file {
+  wigcpp::internal::table::TableFile file;
+};
+
+namespace {
+/* the file of table, aborting on a NULL table such as a failed wigcpp_table_open returns */
+const wigcpp::internal::table::TableFile &opened_file(const wigcpp_table_file *table, const char *caller) noexcept {
+  if (!table) [[unlikely]] {
+    std::fprintf(stderr, "error in %s: the table is NULL.\n", caller);
+    wigcpp::internal::error::error_process(wigcpp::internal::error::ErrorCode::NULL_TABLE);
+  }
+  return table->file;
+}
+} // namespace
+
+API_EXPORT wigcpp_table_file *wigcpp_table_open(const char *path, int verify) {
+  auto *table = new (std::nothrow) wigcpp_table_file;
+  if (!table) [[unlikely]] {
+    std::fprintf(stderr, "error in wigcpp_table_open: failed to allocate the table handle.\n");
+    wigcpp::internal::error::error_process(wigcpp::internal::error::ErrorCode::Bad_Alloc);
+  }
+  if (!path || !table->file.open(path, verify != 0)) {
+    delete table;
+    return nullptr;
+  }
+  return table;
+}
+
+API_EXPORT void wigcpp_table_close(wigcpp_table_file *table) {
+  delete table;
+}
+
+API_EXPORT double wigcpp_table_lookup_3j(const wigcpp_table_file *table, int two_j1, int two_j2, int two_j3,
+                                         int two_m1, int two_m2, int two_m3) {
+  return opened_file(table, "wigcpp_table_lookup_3j").lookup_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3);
+}
+
+API_EXPORT double wigcpp_table_lookup_6j(const wigcpp_table_file *table, int two_j1, int two_j2, int two_j3,
+                                         int two_j4, int two_j5, int two_j6) {
+  return opened_file(table, "wigcpp_table_lookup_6j").lookup_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
+}
+
+API_EXPORT double wigcpp_table_lookup_9j(const wigcpp_table_file *table, int two_j1, int two_j2, int two_j3,
+                                         int two_j4, int two_j5, int two_j6, int two_j7, int two_j8, int two_j9) {
+  return opened_file(table, "wigcpp_table_lookup_9j")
+      .lookup_9j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9);
+}
+
+API_EXPORT void wigcpp_batch_3j(const int *two_j, long long count, double *results) {
+  const auto &pool = wigcpp::internal::global::PoolManager::get();
+  auto &tmp = wigcpp::internal::tmp::TempManager::get(pool.max_two_j, pool.stride());
+  wigcpp::internal::dedup::eval_unique(3, two_j, count > 0 ? static_cast<std::size_t>(count) : 0, results,
+                                       [&](const int *unique, std::size_t size, double *out) {
+                                         wigcpp::internal::batch::batch_3j(pool, tmp, unique, size, out);
+                                       });
+}
+
+API_EXPORT void wigcpp_batch_6j(const int *two_j, long long count, double *results) {
+  const auto &pool = wigcpp::internal::global::PoolManager::get();
+  auto &tmp = wigcpp::internal::tmp::TempManager::get(pool.max_two_j, pool.stride());
+  wigcpp::internal::dedup::eval_unique(6, two_j, count > 0 ? static_cast<std::size_t>(count) : 0, results,
+                                       [&](const int *unique, std::size_t size, double *out) {
+                                         wigcpp::internal::batch::batch_6j(pool, tmp, unique, size, out);
+                                       });
+}
+
+API_EXPORT void wigcpp_batch_dedup(int enable) {
+  wigcpp::internal::dedup::set_enabled(enable != 0);
+}
+
+API_EXPORT void wigcpp_executor_init(int num_threads, int pin_threads) {
+  wigcpp::internal::exec::ExecutorManager::init(num_threads, pin_threads != 0);
+}
+
+API_EXPORT void wigcpp_executor_shutdown() {
+  wigcpp::internal::exec::ExecutorManager::shutdown();
+}
+
+API_EXPORT double wigcpp_estimate_cost(int wigner_type, const int *two_j) {
+  const auto &pool = wigcpp::internal::global::PoolManager::get();
+  return wigcpp::internal::exec::symbol_cost(pool, wigner_type, two_j);
+}
+
+API_EXPORT void wigcpp_eval_batch_parallel(int wigner_type, const int *two_j, long long count, double *results) {
+  const auto &pool = wigcpp::internal::global::PoolManager::get();
+  /* the lease keeps the executor alive until the batch is done */
+  const auto executor = wigcpp::internal::exec::ExecutorManager::get();
+  wigcpp::internal::exec::eval_batch(*executor, pool, wigner_type, two_j,
+                                     count > 0 ? static_cast<std::size_t>(count) : 0, results);
+}
+
+API_EXPORT double wigcpp_tiered_cg(int two_j1, int two_j2, int two_m1, int two_m2, int two_J, int two_M) {
+  const auto &pool = wigcpp::internal::global::PoolManager::get();
+  auto &tmp = wigcpp::internal::tmp::TempManager::get(pool.max_two_j, pool.stride());
+  return wigcpp::internal::tiered::calc_cg(pool, tmp, two_j1, two_j2, two_m1, two_m2, two_J, two_M);
+}
+
+API_EXPORT double wigcpp_tiered_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3) {
+  const auto &pool = wigcpp::internal::global::PoolManager::get();
+  auto &tmp = wigcpp::internal::tmp::TempManager::get(pool.max_two_j, pool.stride());
+  return wigcpp::internal::tiered::calc_3j(pool, tmp, two_j1, two_j2, two_j3, two_m1, two_m2, two_m3);
+}
+
+API_EXPORT double wigcpp_tiered_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) {
+  const auto &pool = wigcpp::internal::global::PoolManager::get();
+  auto &tmp = wigcpp::internal::tmp::TempManager::get(pool.max_two_j, pool.stride());
+  return wigcpp::internal::tiered::calc_6j(pool, tmp, two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
+}
+
+API_EXPORT double wigcpp_asymptotic_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3,
+                                       double *error) {
+  double e;
+  const double value = wigcpp::internal::asymptotic::calc_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3, e);
+  if (error) {
+    *error = e;
+  }
+  return value;
+}
+
+API_EXPORT double wigcpp_asymptotic_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6,
+                                       double *error) {
+  double e;
+  const double value = wigcpp::internal::asymptotic::calc_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, e);
+  if (error) {
+    *error = e;
+  }
+  return value;
+}
+
+API_EXPORT int wigcpp_family_3j_j(int two_j2, int two_j3, int two_m2, int two_m3, int *two_j1_min, double *results) {
+  int two_min;
+  const int count = wigcpp::internal::recurrence::family_3j_j(two_j2, two_j3, two_m2, two_m3, two_min, results);
+  if (two_j1_min) {
+    *two_j1_min = two_min;
+  }
+  return count;
+}
+
+API_EXPORT int wigcpp_family_3j_m(int two_j1, int two_j2, int two_j3, int two_m1, int *two_m2_min, double *results) {
+  int two_min;
+  const int count = wigcpp::internal::recurrence::family_3j_m(two_j1, two_j2, two_j3, two_m1, two_min, results);
+  if (two_m2_min) {
+    *two_m2_min = two_min;
+  }
+  return count;
+}
+
+API_EXPORT int wigcpp_family_6j(int two_j2, int two_j3, int two_j4, int two_j5, int two_j6, int *two_j1_min,
+                                double *results) {
+  int two_min;
+  const int count = wigcpp::internal::recurrence::family_6j(two_j2, two_j3, two_j4, two_j5, two_j6, two_min, results);
+  if (two_j1_min) {
+    *two_j1_min = two_min;
+  }
+  return count;
+}
+
 API_EXPORT double clebsch_gordan(int two_j1, int two_j2, int two_m1, int two_m2, int two_J, int two_M) {
   const auto &pool = wigcpp::internal::global::PoolManager::get();
   auto &tmp = wigcpp::internal::tmp::TempManager::get(pool.max_two_j, pool.stride());
@@ -44,6 +298,10 @@ API_EXPORT double wigner3j(int two_j1, int two_j2, int two_j3, int two_m1, int t
   const auto &pool = wigcpp::internal::global::PoolManager::get();
   auto &tmp = wigcpp::internal::tmp::TempManager::get(pool.max_two_j, pool.stride());
 
+  if (auto *cache = wigcpp::internal::cache::CacheManager::get()) {
+    return cache->calc_3j(pool, tmp, two_j1, two_j2, two_j3, two_m1, two_m2, two_m3);
+  }
+
   auto result = wigcpp::internal::calc::Calculator::calc_3j(pool, tmp, two_j1, two_j2, two_j3, two_m1, two_m2, two_m3);
 
   return result;
@@ -53,6 +311,10 @@ API_EXPORT double wigner6j(int two_j1, int two_j2, int two_j3, int two_j4, int t
   const auto &pool = wigcpp::internal::global::PoolManager::get();
   auto &tmp = wigcpp::internal::tmp::TempManager::get(pool.max_two_j, pool.stride());
 
+  if (auto *cache = wigcpp::internal::cache::CacheManager::get()) {
+    return cache->calc_6j(pool, tmp, two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
+  }
+
   auto result = wigcpp::internal::calc::Calculator::calc_6j(pool, tmp, two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
 
   return result;
@@ -63,7 +325,44 @@ API_EXPORT double wigner9j(int two_j1, int two_j2, int two_j3, int two_j4, int t
   const auto &pool = wigcpp::internal::global::PoolManager::get();
   auto &tmp = wigcpp::internal::tmp::TempManager::get(pool.max_two_j, pool.stride());
 
+  if (auto *cache = wigcpp::internal::cache::CacheManager::get()) {
+    return cache->calc_9j(pool, tmp, two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9);
+  }
+
   auto result = wigcpp::internal::calc::Calculator::calc_9j(pool, tmp, two_j1, two_j2, two_j3, two_j4, two_j5, two_j6,
                                                             two_j7, two_j8, two_j9);
   return result;
+}
+
+API_EXPORT long double clebsch_gordan_l(int two_j1, int two_j2, int two_m1, int two_m2, int two_J, int two_M) {
+  const auto &pool = wigcpp::internal::global::PoolManager::get();
+  auto &tmp = wigcpp::internal::tmp::TempManager::get(pool.max_two_j, pool.stride());
+
+  return wigcpp::internal::calc::Calculator::calc_cg<long double>(pool, tmp, two_j1, two_j2, two_m1, two_m2, two_J,
+                                                                  two_M);
+}
+
+API_EXPORT long double wigner3j_l(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3) {
+  const auto &pool = wigcpp::internal::global::PoolManager::get();
+  auto &tmp = wigcpp::internal::tmp::TempManager::get(pool.max_two_j, pool.stride());
+
+  return wigcpp::internal::calc::Calculator::calc_3j<long double>(pool, tmp, two_j1, two_j2, two_j3, two_m1, two_m2,
+                                                                  two_m3);
+}
+
+API_EXPORT long double wigner6j_l(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) {
+  const auto &pool = wigcpp::internal::global::PoolManager::get();
+  auto &tmp = wigcpp::internal::tmp::TempManager::get(pool.max_two_j, pool.stride());
+
+  return wigcpp::internal::calc::Calculator::calc_6j<long double>(pool, tmp, two_j1, two_j2, two_j3, two_j4, two_j5,
+                                                                  two_j6);
+}
+
+API_EXPORT long double wigner9j_l(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6, int two_j7,
+                                  int two_j8, int two_j9) {
+  const auto &pool = wigcpp::internal::global::PoolManager::get();
+  auto &tmp = wigcpp::internal::tmp::TempManager::get(pool.max_two_j, pool.stride());
+
+  return wigcpp::internal::calc::Calculator::calc_9j<long double>(pool, tmp, two_j1, two_j2, two_j3, two_j4, two_j5,
+                                                                  two_j6, two_j7, two_j8, two_j9);
 }
\ No newline at end of file
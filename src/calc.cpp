@@ -10,59 +10,273 @@
 #include "internal/calc.hpp"
 #include "internal/prime_ops.hpp"
 #include "internal/error.hpp"
+#include "internal/modular.hpp"
+#include "internal/parallel.hpp"
 #include "internal/tmp_pool.hpp"
+#include "internal/pexpo_eval_ctx.hpp"
+#include "internal/vector.hpp"
 #include <algorithm>
+#include <bit>
 #include <cmath>
 #include <cstddef>
 #include <cstdio>
+#include <memory>
 
 namespace wigcpp::internal::calc {
 
 using namespace wigcpp::internal::prime;
 
-def::double_type Calculator::calc_cg(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2,
-                                     int two_m1, int two_m2, int two_J, int two_M) noexcept {
+namespace {
+/* the fewest terms of a split big_int sum in a part, and the fewest values of k of a split 9j sum, which evaluates
+ * three 6j sums per k, for 9j symbols with some two_j of at least min_split_two_j_9j */
+constexpr int min_split_terms = 16;
+constexpr int min_split_k_9j = 4;
+constexpr int min_split_two_j_9j = 100;
+
+/* sum of a single term, whose exponents became min_nume */
+void set_unit(mwi::big_int &sum_prod, bool negative) noexcept {
+  sum_prod = 1;
+  if (negative) {
+    sum_prod = -sum_prod;
+  }
+}
+
+/* Bits of the largest term, iteration row k / min_nume: a term with exponents e is below 2^bits, bits = sum of
+ * e * bit_width(prime) */
+int max_term_bits(const global::PrimeTable &prime_table, TempStorage &csi, view_type min_view, int k_lim) noexcept {
+  int max_bits = 0;
+  for (int k = 0; k <= k_lim; ++k) {
+    const exp_t *row = csi.data(iter_start + k);
+    int bits = 0;
+    for (auto i = 0u; i < min_view.used; ++i) {
+      bits += (row[i] - min_view.ptr[i]) * std::bit_width(prime_table.prime_list[i]);
+    }
+    max_bits = std::max(max_bits, bits);
+  }
+  return max_bits;
+}
+
+/* The big_int sum of sum_terms over num_parts threads, part p summing every num_parts-th term from k = p with its own
+ * scratch numbers. The rows of the terms are shared, each is only touched by its own part. */
+void sum_terms_split(const global::PrimeTable &prime_table, TempStorage &csi, view_type min_view, int k_lim, int sign,
+                     std::size_t words, int num_parts, mwi::big_int &sum_prod) noexcept {
+  struct sum_part {
+    prime::pexpo_eval_temp pexpo_tmp;
+    mwi::big_nat big_prod;
+    mwi::big_sum sum_acc;
+    mwi::big_int sum;
+  };
+  container::vector<sum_part> parts(static_cast<std::size_t>(num_parts));
+
+  parallel::run_parts(num_parts, [&](int p) {
+    sum_part &part = parts[p];
+    part.sum_acc.reset(words);
+    for (int k = p; k <= k_lim; k += num_parts) {
+      const std::uint32_t idx = iter_start + k;
+      expand_sub(csi.data(idx), csi.used(idx), min_view);
+      part.pexpo_tmp.evaluate(prime_table, part.big_prod, csi.view(idx));
+
+      if ((k ^ sign) & 1) {
+        part.sum_acc.sub(part.big_prod);
+      } else {
+        part.sum_acc.add(part.big_prod);
+      }
+    }
+    part.sum_acc.result(part.sum);
+  });
+
+  parallel::tree_reduce(num_parts, [&](int into, int from) {
+    parts[into].sum += parts[from].sum;
+  });
+  sum_prod = parts[0].sum;
+}
+
+/* Sums the terms (-1)^(k + sign) iteration row k / min_nume. k_lim + 1 terms below 2^max_term_bits are below
+ * 2^(max_term_bits + bit_width(k_lim + 1)): such sums are taken in a signed double word when they fit, from their
+ * residues when they fit the moduli of modular::sum_terms, and in a big_sum otherwise. */
+void sum_terms(const global::PrimeTable &prime_table, TempStorage &csi, view_type min_view,
+               const modular::racah_terms &terms, mwi::big_int &sum_prod) noexcept {
+  constexpr int max_fixed_bits = sizeof(def::dword_t) * 8 - 1;
+  const int k_lim = terms.k_lim, sign = terms.sign;
+  const int bits = max_term_bits(prime_table, csi, min_view, k_lim) + std::bit_width(static_cast<unsigned>(k_lim + 1));
+
+  if (bits <= max_fixed_bits) {
+    def::dword_t sum = 0;
+    for (int k = 0; k <= k_lim; ++k) {
+      const std::uint32_t idx = iter_start + k;
+      expand_sub(csi.data(idx), csi.used(idx), min_view);
+      const auto term = static_cast<def::dword_t>(evaluate_fixed<def::udword_t>(prime_table, csi.view(idx)));
+      sum += ((k ^ sign) & 1) ? -term : term;
+    }
+    sum_prod.assign(sum);
+    return;
+  }
+
+  if (modular::sum_terms(prime_table, csi.view(iter_start), min_view, terms, bits, sum_prod)) {
+    return;
+  }
+
+  /* bits also bounds the added and the subtracted terms apart */
+  const std::size_t words = static_cast<std::size_t>(bits) / def::shift_bits + 1;
+  const int num_parts = parallel::parts(k_lim + 1, min_split_terms);
+  if (num_parts > 1) {
+    sum_terms_split(prime_table, csi, min_view, k_lim, sign, words, num_parts, sum_prod);
+    return;
+  }
+
+  csi.sum_acc.reset(words);
+  for (int k = 0; k <= k_lim; ++k) {
+    const std::uint32_t idx = iter_start + k;
+    expand_sub(csi.data(idx), csi.used(idx), min_view);
+    csi.pexpo_tmp.evaluate(prime_table, csi.big_prod, csi.view(idx));
+
+    if ((k ^ sign) & 1) {
+      csi.sum_acc.sub(csi.big_prod);
+    } else {
+      csi.sum_acc.add(csi.big_prod);
+    }
+  }
+  csi.sum_acc.result(sum_prod);
+}
+
+/* the terms of the sums of calcsum_cg and calcsum_3j, 1 / ((k_min + k)! (offset1 + k)! (offset2 + k)! (fixed1 - k)!
+ * (fixed2 - k)! (fixed3 - k)!) */
+modular::racah_terms terms_3j(int k_min, int offset1, int offset2, int fixed1, int fixed2, int fixed3, int k_lim,
+                              int sign) noexcept {
+  return {k_lim, sign, 0, 3, 3, {}, {k_min, offset1, offset2, 0}, {fixed1, fixed2, fixed3}};
+}
+
+/* bits of prime_list[i]^e summed over the positive and over the negated negative exponents of a row */
+void exp_bits(const global::PrimeTable &prime_table, view_type in_fpf, int &pos_bits, int &neg_bits) noexcept {
+  pos_bits = 0;
+  neg_bits = 0;
+  for (auto i = 0u; i < in_fpf.used; ++i) {
+    const int bits = in_fpf.ptr[i] * std::bit_width(prime_table.prime_list[i]);
+    if (bits > 0) {
+      pos_bits += bits;
+    } else {
+      neg_bits -= bits;
+    }
+  }
+}
+
+/* The evaluation of eval_calcsum_info in double words, taken when the sum is a single word and the numerator times
+ * the sum and the divisor fit. Rounds once for each of the three floating-point conversions, like the big_int path */
+template <typename Int, typename UInt, typename Float>
+bool eval_fixed(const global::PrimeTable &prime_table, TempStorage &csi, Float &result) noexcept {
+  constexpr int max_bits = sizeof(Int) * 8 - 1;
+  if (!csi.sum_prod.is_single_word() || !csi.big_sqrt.is_single_word()) {
+    return false;
+  }
+  int pos_bits, neg_bits;
+  exp_bits(prime_table, csi.view(prefact), pos_bits, neg_bits);
+  if (pos_bits + static_cast<int>(def::shift_bits) - 1 > max_bits || neg_bits > max_bits) {
+    return false;
+  }
+
+  UInt nume, div;
+  evaluate2_fixed<UInt>(prime_table, nume, div, csi.view(prefact));
+  const Int nume_prod = static_cast<Int>(nume) * static_cast<def::word_t>(csi.sum_prod[0]);
+  result = (static_cast<Float>(nume_prod) / static_cast<Float>(div)) / std::sqrt(static_cast<Float>(csi.big_sqrt[0]));
+  return true;
+}
+
+/* {a b c; d e 0} = delta(a, e) delta(b, d) (-1)^(a + b + c) / sqrt((2a + 1)(2b + 1)), other positions of the zero are
+ * moved there by swapping upper and lower entries in two columns and permuting the columns */
+template <typename Float> Float zero_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) noexcept {
+  int upper[3] = {two_j1, two_j2, two_j3};
+  int lower[3] = {two_j4, two_j5, two_j6};
+  int col = 0;
+  while (upper[col] && lower[col]) {
+    ++col;
+  }
+  if (!upper[col]) {
+    std::swap(upper[col], lower[col]);
+    std::swap(upper[(col + 1) % 3], lower[(col + 1) % 3]);
+  }
+  const int two_a = upper[(col + 1) % 3], two_b = upper[(col + 2) % 3], two_c = upper[col];
+
+  const Float r = 1 / std::sqrt(static_cast<Float>(two_a + 1) * (two_b + 1));
+  return (((two_a + two_b + two_c) / 2) & 1) ? -r : r;
+}
+} // namespace
+
+template <typename Float>
+Float Calculator::calc_cg(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_m1,
+                          int two_m2, int two_J, int two_M) noexcept {
   if (TrivialZero::is_zero_3j(two_j1, two_j2, two_J, two_m1, two_m2, -two_M)) {
     return 0;
   }
+  const allocator::word_arena::scope scope(&csi.arena);
   calcsum_cg(pool, csi, two_j1, two_m1, two_j2, two_m2, two_J, two_M);
-  auto result = eval_calcsum_info(pool.prime_table, csi);
+  if (csi.sum_prod.is_zero()) {
+    return 0;
+  }
+  auto result = eval_calcsum_info<Float>(pool.prime_table, csi);
   return result;
 }
 
-def::double_type Calculator::calc_3j(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2,
-                                     int two_j3, int two_m1, int two_m2, int two_m3) noexcept {
+template <typename Float>
+Float Calculator::calc_3j(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3,
+                          int two_m1, int two_m2, int two_m3) noexcept {
   if (TrivialZero::is_zero_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3)) {
     return 0;
   }
-  calcsum_3j(pool, csi, two_j1, two_j2, two_j3, two_m1, two_m2, two_m3);
-  auto result = eval_calcsum_info(pool.prime_table, csi);
+  const allocator::word_arena::scope scope(&csi.arena);
+  if (!two_m1 && !two_m2 && !two_m3) {
+    if (((two_j1 + two_j2 + two_j3) / 2) & 1) {
+      return 0;
+    }
+    calcsum_3j_m0(pool, csi, two_j1, two_j2, two_j3);
+  } else {
+    calcsum_3j(pool, csi, two_j1, two_j2, two_j3, two_m1, two_m2, two_m3);
+  }
+  if (csi.sum_prod.is_zero()) {
+    return 0;
+  }
+  auto result = eval_calcsum_info<Float>(pool.prime_table, csi);
   return result;
 }
 
-def::double_type Calculator::calc_6j(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2,
-                                     int two_j3, int two_j4, int two_j5, int two_j6) noexcept {
+template <typename Float>
+Float Calculator::calc_6j(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3,
+                          int two_j4, int two_j5, int two_j6) noexcept {
   if (TrivialZero::is_zero_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6)) {
     return 0;
   }
+  if (!two_j1 || !two_j2 || !two_j3 || !two_j4 || !two_j5 || !two_j6) {
+    return zero_6j<Float>(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
+  }
+  const allocator::word_arena::scope scope(&csi.arena);
   calcsum_6j(pool, csi, two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
-  auto result = eval_calcsum_info(pool.prime_table, csi);
+  if (csi.sum_prod.is_zero()) {
+    return 0;
+  }
+  auto result = eval_calcsum_info<Float>(pool.prime_table, csi);
   return result;
 }
 
-def::double_type Calculator::calc_9j(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2,
-                                     int two_j3, int two_j4, int two_j5, int two_j6, int two_j7, int two_j8,
-                                     int two_j9) noexcept {
+template <typename Float>
+Float Calculator::calc_9j(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3,
+                          int two_j4, int two_j5, int two_j6, int two_j7, int two_j8, int two_j9) noexcept {
   if (TrivialZero::is_zero_9j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9)) {
     return 0;
   }
-  calcsum_9j(pool, csi, two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9);
-  auto result = eval_calcsum_info(pool.prime_table, csi);
+  const allocator::word_arena::scope scope(&csi.arena);
+  if (!two_j1 || !two_j2 || !two_j3 || !two_j4 || !two_j5 || !two_j6 || !two_j7 || !two_j8 || !two_j9) {
+    calcsum_9j_zero(pool, csi, two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9);
+  } else {
+    calcsum_9j(pool, csi, two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9);
+  }
+  if (csi.sum_prod.is_zero()) {
+    return 0;
+  }
+  auto result = eval_calcsum_info<Float>(pool.prime_table, csi);
   return result;
 }
 
 void Calculator::split_sqrt_add(const global::PrimeTable &prime_table, exp_t *__restrict src_dest_fpf,
-                                std::uint32_t &used_src, mwi::big_int &big_sqrt, exp_t *__restrict add_fpf,
+                                std::uint32_t &used_src, mwi::big_nat &big_sqrt, exp_t *__restrict add_fpf,
                                 std::uint32_t &used_add) noexcept {
   const auto &prime_list = prime_table.prime_list;
   big_sqrt = 1;
@@ -84,7 +298,7 @@ void Calculator::split_sqrt_add(const global::PrimeTable &prime_table, exp_t *__
   }
 }
 
-void Calculator::delta_coeff(const GlobalFactorialPool &pool, int two_a, int two_b, int two_c,
+void Calculator::delta_coeff(const GlobalFactorialPool &pool, TempStorage &csi, int two_a, int two_b, int two_c,
                              exp_t *__restrict prefact_fpf, std::uint32_t &used) noexcept {
   const std::size_t max_factorial = (two_a + two_b + two_c) / 2;
   if (max_factorial > pool.prime_table.max_factorial) {
@@ -92,17 +306,18 @@ void Calculator::delta_coeff(const GlobalFactorialPool &pool, int two_a, int two
     error::error_process(error::ErrorCode::TOO_LARGE_FACTORIAL);
   }
 
-  const auto v_n1 = pool[(two_a + two_b - two_c) / 2];
-  const auto v_n2 = pool[(two_a - two_b + two_c) / 2];
-  const auto v_n3 = pool[(-two_a + two_b + two_c) / 2];
+  const auto delta = csi.delta(two_a, two_b, two_c, [&](exp_t *row, std::uint32_t &row_used) {
+    const auto v_n1 = pool[(two_a + two_b - two_c) / 2];
+    const auto v_n2 = pool[(two_a - two_b + two_c) / 2];
+    const auto v_n3 = pool[(-two_a + two_b + two_c) / 2];
 
-  const auto v_d1 = pool[(two_a + two_b + two_c) / 2 + 1];
+    const auto v_d1 = pool[(two_a + two_b + two_c) / 2 + 1];
 
-  // prefact_fpf.expand_blocks(p_d1.block_used);
-  ensure_used(used, v_d1.used);
+    set_used(row, row_used, v_d1.used);
+    sum<OP::add, OP::add, OP::add, OP::sub>(row, row_used, v_n1, v_n2, v_n3, v_d1);
+  });
 
-  // prefact_fpf.add3_sub(p_n1, p_n2, p_n3, p_d1);
-  add3_sub(prefact_fpf, used, v_n1, v_n2, v_n3, v_d1);
+  expand_add(prefact_fpf, used, delta);
 }
 
 void Calculator::calcsum_cg(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_m1,
@@ -118,15 +333,10 @@ void Calculator::calcsum_cg(const global::GlobalFactorialPool &pool, TempStorage
   }
 
   const int max_used = pool[max_factorial].used;
-  // csi[min_nume)].set_max(max_used);
-  fill_max(csi.data(min_nume), csi.used(min_nume), max_used);
 
   const int k_lim = k_max - k_min;
 
-  if (k_lim + 1 > csi.max_iter) [[unlikely]] {
-    std::fprintf(stderr, "Error: k_lim [%d] exceeds maximum allowed iterations [%d]. \n", k_lim, csi.max_iter);
-    std::abort();
-  }
+  csi.reserve_iter(k_lim + 1, max_used, TempStorage::max_iter(pool.max_two_j));
 
   const int offset1 = k_min + (two_J - two_j1 - two_m2) / 2;
   const int offset2 = k_min + (two_J - two_j2 + two_m1) / 2;
@@ -135,40 +345,37 @@ void Calculator::calcsum_cg(const global::GlobalFactorialPool &pool, TempStorage
   const int fixed2 = (two_j1 - two_m1) / 2 - k_min;
   const int fixed3 = (two_j1 + two_j2 - two_J) / 2 - k_min;
 
-  for (int k = 0; k <= k_lim; ++k) {
-    const auto v_d1 = pool[k_min + k];
-    const auto v_d2 = pool[offset1 + k];
-    const auto v_d3 = pool[offset2 + k];
+  const int sign = k_min;
 
-    const auto v_d4 = pool[fixed1 - k];
-    const auto v_d5 = pool[fixed2 - k];
-    const auto v_d6 = pool[fixed3 - k];
+  if (k_lim == 0) {
+    sub6(csi.data(min_nume), csi.used(min_nume), pool[k_min], pool[offset1], pool[offset2], pool[fixed1],
+         pool[fixed2], pool[fixed3], max_used);
+    set_unit(csi.sum_prod, sign & 1);
+  } else {
+    // csi[min_nume)].set_max(max_used);
+    fill_max(csi.data(min_nume), csi.used(min_nume), max_used);
 
-    const auto idx = iter_start + static_cast<std::uint32_t>(k);
+    for (int k = 0; k <= k_lim; ++k) {
+      const auto v_d1 = pool[k_min + k];
+      const auto v_d2 = pool[offset1 + k];
+      const auto v_d3 = pool[offset2 + k];
 
-    exp_t *nume_fpf = csi.data(idx);
-    std::uint32_t &used = csi.used(idx);
+      const auto v_d4 = pool[fixed1 - k];
+      const auto v_d5 = pool[fixed2 - k];
+      const auto v_d6 = pool[fixed3 - k];
 
-    sub6(nume_fpf, used, v_d1, v_d2, v_d3, v_d4, v_d5, v_d6, max_used);
-    // csi[min_nume)].keep_min(nume_fpf);
-    store_min(csi.data(min_nume), csi.used(min_nume), csi.view(idx));
-  }
+      const auto idx = iter_start + static_cast<std::uint32_t>(k);
 
-  const int sign = k_min;
-  csi.sum_prod = 0;
-
-  for (int k = 0; k <= k_lim; ++k) {
-    const auto idx = iter_start + static_cast<uint32_t>(k);
-    exp_t *nume_fpf = csi.data(idx);
-    std::uint32_t &used = csi.used(idx);
-    expand_sub(nume_fpf, used, csi.view(min_nume));
-    csi.pexpo_tmp.evaluate(pool.prime_table, csi.big_prod, csi.view(idx));
+      exp_t *nume_fpf = csi.data(idx);
+      std::uint32_t &used = csi.used(idx);
 
-    if ((k ^ sign) & 1) {
-      csi.sum_prod -= csi.big_prod;
-    } else {
-      csi.sum_prod += csi.big_prod;
+      sub6(nume_fpf, used, v_d1, v_d2, v_d3, v_d4, v_d5, v_d6, max_used);
+      // csi[min_nume)].keep_min(nume_fpf);
+      store_min(csi.data(min_nume), csi.used(min_nume), csi.view(idx));
     }
+
+    sum_terms(pool.prime_table, csi, csi.view(min_nume),
+              terms_3j(k_min, offset1, offset2, fixed1, fixed2, fixed3, k_lim, sign), csi.sum_prod);
   }
 
   exp_t *dest = csi.data(prefact);
@@ -176,7 +383,7 @@ void Calculator::calcsum_cg(const global::GlobalFactorialPool &pool, TempStorage
   reset_row(dest, used);
 
   {
-    delta_coeff(pool, two_j1, two_j2, two_J, dest, used);
+    delta_coeff(pool, csi, two_j1, two_j2, two_J, dest, used);
 
     const auto v_n4 = pool[(two_j1 - two_m1) / 2];
     const auto v_n5 = pool[(two_j1 + two_m1) / 2];
@@ -205,14 +412,9 @@ void Calculator::calcsum_3j(const global::GlobalFactorialPool &pool, TempStorage
 
   const int max_used = pool[max_factorial].used;
 
-  fill_max(csi.data(min_nume), csi.used(min_nume), max_used);
-
   const int k_lim = k_max - k_min;
 
-  if (k_lim + 1 > csi.max_iter) [[unlikely]] {
-    std::fprintf(stderr, "Error: k_lim [%d] exceeds maximum allowed iterations [%d]. \n", k_lim, csi.max_iter);
-    std::abort();
-  }
+  csi.reserve_iter(k_lim + 1, max_used, TempStorage::max_iter(pool.max_two_j));
 
   const int offset1 = k_min + (two_j3 - two_j1 - two_m2) / 2;
   const int offset2 = k_min + (two_j3 - two_j2 + two_m1) / 2;
@@ -221,43 +423,40 @@ void Calculator::calcsum_3j(const global::GlobalFactorialPool &pool, TempStorage
   const int fixed2 = (two_j1 - two_m1) / 2 - k_min;
   const int fixed3 = (two_j1 + two_j2 - two_j3) / 2 - k_min;
 
-  for (int k = 0; k <= k_lim; ++k) {
-    const auto v_d1 = pool[k_min + k];
-    const auto v_d2 = pool[offset1 + k];
-    const auto v_d3 = pool[offset2 + k];
-
-    const auto v_d4 = pool[fixed1 - k];
-    const auto v_d5 = pool[fixed2 - k];
-    const auto v_d6 = pool[fixed3 - k];
-
-    exp_t *nume_fpf = csi.data(iter_start + k);
-    std::uint32_t &used = csi.used(iter_start + k);
-
-    sub6(nume_fpf, used, v_d1, v_d2, v_d3, v_d4, v_d5, v_d6, max_used);
-    // csi[min_nume].keep_min(nume_fpf);
-    store_min(csi.data(min_nume), csi.used(min_nume), csi.view(iter_start + k));
-  }
-
-  csi.sum_prod = 0;
-
   const int sign = k_min ^ ((two_j1 - two_j2 - two_m3) / 2);
 
-  for (int k = 0; k <= k_lim; ++k) {
-    const std::uint32_t idx = iter_start + k;
-    expand_sub(csi.data(idx), csi.used(idx), csi.view(min_nume));
-
-    csi.pexpo_tmp.evaluate(pool.prime_table, csi.big_prod, csi.view(idx));
-
-    if ((k ^ sign) & 1) {
-      csi.sum_prod -= csi.big_prod;
-    } else {
-      csi.sum_prod += csi.big_prod;
+  if (k_lim == 0) {
+    /* a single term, e.g. stretched symbols: it is min_nume itself */
+    sub6(csi.data(min_nume), csi.used(min_nume), pool[k_min], pool[offset1], pool[offset2], pool[fixed1],
+         pool[fixed2], pool[fixed3], max_used);
+    set_unit(csi.sum_prod, sign & 1);
+  } else {
+    fill_max(csi.data(min_nume), csi.used(min_nume), max_used);
+
+    for (int k = 0; k <= k_lim; ++k) {
+      const auto v_d1 = pool[k_min + k];
+      const auto v_d2 = pool[offset1 + k];
+      const auto v_d3 = pool[offset2 + k];
+
+      const auto v_d4 = pool[fixed1 - k];
+      const auto v_d5 = pool[fixed2 - k];
+      const auto v_d6 = pool[fixed3 - k];
+
+      exp_t *nume_fpf = csi.data(iter_start + k);
+      std::uint32_t &used = csi.used(iter_start + k);
+
+      sub6(nume_fpf, used, v_d1, v_d2, v_d3, v_d4, v_d5, v_d6, max_used);
+      // csi[min_nume].keep_min(nume_fpf);
+      store_min(csi.data(min_nume), csi.used(min_nume), csi.view(iter_start + k));
     }
+
+    sum_terms(pool.prime_table, csi, csi.view(min_nume),
+              terms_3j(k_min, offset1, offset2, fixed1, fixed2, fixed3, k_lim, sign), csi.sum_prod);
   }
 
   reset_row(csi.data(prefact), csi.used(prefact));
   {
-    delta_coeff(pool, two_j1, two_j2, two_j3, csi.data(prefact), csi.used(prefact));
+    delta_coeff(pool, csi, two_j1, two_j2, two_j3, csi.data(prefact), csi.used(prefact));
 
     const auto v_n4 = pool[(two_j1 - two_m1) / 2];
     const auto v_n5 = pool[(two_j1 + two_m1) / 2];
@@ -270,6 +469,28 @@ void Calculator::calcsum_3j(const global::GlobalFactorialPool &pool, TempStorage
   }
 }
 
+void Calculator::calcsum_3j_m0(const global::GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2,
+                               int two_j3) noexcept {
+  /* (j1 j2 j3; 0 0 0) = (-1)^g sqrt(delta(j1, j2, j3)) g! / ((g - j1)! (g - j2)! (g - j3)!), 2g = j1 + j2 + j3 */
+  const int g = (two_j1 + two_j2 + two_j3) / 4;
+
+  const std::size_t max_factorial = 2 * g + 1;
+  if (max_factorial > pool.prime_table.max_factorial) [[unlikely]] {
+    std::fprintf(stderr, "error in calcsum_3j_m0: \n");
+    error::error_process(error::ErrorCode::TOO_LARGE_FACTORIAL);
+  }
+
+  reset_row(csi.data(min_nume), csi.used(min_nume));
+  ensure_used(csi.used(min_nume), pool[g].used);
+  add_sub3(csi.data(min_nume), csi.used(min_nume), pool[g], pool[g - two_j1 / 2], pool[g - two_j2 / 2],
+           pool[g - two_j3 / 2]);
+
+  set_unit(csi.sum_prod, g & 1);
+
+  reset_row(csi.data(prefact), csi.used(prefact));
+  delta_coeff(pool, csi, two_j1, two_j2, two_j3, csi.data(prefact), csi.used(prefact));
+}
+
 void Calculator::factor_6j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3,
                            int two_j4, int two_j5, int two_j6, exp_t *__restrict min_nume_fpf, std::uint32_t &used,
                            mwi::big_int &sum_prod) noexcept {
@@ -294,13 +515,9 @@ void Calculator::factor_6j(const GlobalFactorialPool &pool, TempStorage &csi, in
   }
 
   const int max_used = pool[max_factorial].used;
-  fill_max(min_nume_fpf, used, max_used);
 
   const int k_lim = k_max - k_min;
-  if (k_lim + 1 > csi.max_iter) [[unlikely]] {
-    std::fprintf(stderr, "Error: k_lim [%d] exceeds maximum allowed iterations [%d]. \n", k_lim, csi.max_iter);
-    std::abort();
-  }
+  csi.reserve_iter(k_lim + 1, max_used, TempStorage::max_iter(pool.max_two_j));
 
   const int d1 = k_min - alpha1 / 2;
   const int d2 = k_min - alpha2 / 2;
@@ -311,6 +528,15 @@ void Calculator::factor_6j(const GlobalFactorialPool &pool, TempStorage &csi, in
   const int d6 = beta2 / 2 - k_min;
   const int d7 = beta3 / 2 - k_min;
 
+  if (k_lim == 0) {
+    sum_sub7(min_nume_fpf, used, pool[k_min + 1], pool[d1], pool[d2], pool[d3], pool[d4], pool[d5], pool[d6],
+             pool[d7], max_used);
+    set_unit(sum_prod, k_min & 1);
+    return;
+  }
+
+  fill_max(min_nume_fpf, used, max_used);
+
   for (int k = 0; k <= k_lim; ++k) {
     const auto v_n1 = pool[k_min + 1 + k];
 
@@ -331,22 +557,9 @@ void Calculator::factor_6j(const GlobalFactorialPool &pool, TempStorage &csi, in
     store_min(min_nume_fpf, used, csi.view(iter_start + k));
   }
 
-  sum_prod = 0;
-
-  for (int k = 0; k <= k_lim; ++k) {
-    exp_t *nume_fpf = csi.data(iter_start + k);
-    std::uint32_t &nume_used = csi.used(iter_start + k);
-
-    expand_sub(nume_fpf, nume_used, container::uniform_jagged_matrix<exp_t>::row_view{min_nume_fpf, used});
-
-    csi.pexpo_tmp.evaluate(pool.prime_table, csi.big_prod, csi.view(iter_start + k));
-
-    if ((k ^ k_min) & 1) {
-      sum_prod -= csi.big_prod;
-    } else {
-      sum_prod += csi.big_prod;
-    }
-  }
+  /* (k_min + 1 + k)! / ((d1 + k)! (d2 + k)! (d3 + k)! (d4 + k)! (d5 - k)! (d6 - k)! (d7 - k)!) */
+  const modular::racah_terms terms{k_lim, k_min, 1, 4, 3, {k_min + 1}, {d1, d2, d3, d4}, {d5, d6, d7}};
+  sum_terms(pool.prime_table, csi, view_type{min_nume_fpf, used}, terms, sum_prod);
 };
 
 void Calculator::calcsum_6j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3,
@@ -356,10 +569,10 @@ void Calculator::calcsum_6j(const GlobalFactorialPool &pool, TempStorage &csi, i
   factor_6j(pool, csi, two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, csi.data(min_nume), csi.used(min_nume),
             csi.sum_prod);
   reset_row(csi.data(prefact), csi.used(prefact));
-  delta_coeff(pool, two_a, two_b, two_e, csi.data(prefact), csi.used(prefact));
-  delta_coeff(pool, two_c, two_d, two_e, csi.data(prefact), csi.used(prefact));
-  delta_coeff(pool, two_a, two_c, two_f, csi.data(prefact), csi.used(prefact));
-  delta_coeff(pool, two_b, two_d, two_f, csi.data(prefact), csi.used(prefact));
+  delta_coeff(pool, csi, two_a, two_b, two_e, csi.data(prefact), csi.used(prefact));
+  delta_coeff(pool, csi, two_c, two_d, two_e, csi.data(prefact), csi.used(prefact));
+  delta_coeff(pool, csi, two_a, two_c, two_f, csi.data(prefact), csi.used(prefact));
+  delta_coeff(pool, csi, two_b, two_d, two_f, csi.data(prefact), csi.used(prefact));
 }
 
 void Calculator::calcsum_9j(const GlobalFactorialPool &pool, TempStorage &csi, int two_a, int two_b, int two_c,
@@ -367,11 +580,53 @@ void Calculator::calcsum_9j(const GlobalFactorialPool &pool, TempStorage &csi, i
   const int two_k_min = std::max({std::abs(two_h - two_d), std::abs(two_b - two_f), std::abs(two_a - two_i)});
   const int two_k_max = std::min({two_h + two_d, two_b + two_f, two_a + two_i});
 
+  const int num_k = (two_k_max - two_k_min) / 2 + 1;
+  const int max_two_j = std::max({two_a, two_b, two_c, two_d, two_e, two_f, two_g, two_h, two_i});
+  const int num_parts = max_two_j >= min_split_two_j_9j ? parallel::parts(num_k, min_split_k_9j) : 1;
+  if (num_parts == 1) {
+    sum_9j_range(pool, csi, two_a, two_b, two_c, two_d, two_e, two_f, two_g, two_h, two_i, two_k_min, two_k_max, 2);
+  } else {
+    /* Part p takes every num_parts-th k from two_k_min + 2p, as the terms in the middle of the range cost the most. Part 0
+     * sums into csi, the others into storage taken from the free list, whose rows grow to what the 6j sums of this symbol
+     * need, and put back after the merge. */
+    container::vector<TempStorage *> slices(static_cast<std::size_t>(num_parts));
+    const auto slice = [&](int p) -> TempStorage & {
+      return p ? *slices[p] : csi;
+    };
+    parallel::run_parts(num_parts, [&](int p) {
+      if (p) {
+        slices[p] = TempManager::acquire(csi.stride()).release();
+      }
+      const allocator::word_arena::scope scope(&slice(p).arena);
+      sum_9j_range(pool, slice(p), two_a, two_b, two_c, two_d, two_e, two_f, two_g, two_h, two_i, two_k_min + 2 * p,
+                   two_k_max, 2 * num_parts);
+    });
+    parallel::tree_reduce(num_parts, [&](int into, int from) {
+      merge_9j(pool.prime_table, slice(into), slice(from));
+    });
+    for (int p = 1; p < num_parts; ++p) {
+      FreeList::put(std::unique_ptr<TempStorage>(slices[p]));
+    }
+  }
+
+  reset_row(csi.data(prefact), csi.used(prefact));
+
+  delta_coeff(pool, csi, two_a, two_b, two_c, csi.data(prefact), csi.used(prefact));
+  delta_coeff(pool, csi, two_d, two_e, two_f, csi.data(prefact), csi.used(prefact));
+  delta_coeff(pool, csi, two_g, two_h, two_i, csi.data(prefact), csi.used(prefact));
+  delta_coeff(pool, csi, two_a, two_d, two_g, csi.data(prefact), csi.used(prefact));
+  delta_coeff(pool, csi, two_b, two_e, two_h, csi.data(prefact), csi.used(prefact));
+  delta_coeff(pool, csi, two_c, two_f, two_i, csi.data(prefact), csi.used(prefact));
+}
+
+void Calculator::sum_9j_range(const GlobalFactorialPool &pool, TempStorage &csi, int two_a, int two_b, int two_c,
+                              int two_d, int two_e, int two_f, int two_g, int two_h, int two_i, int two_k_first,
+                              int two_k_last, int two_k_step) noexcept {
   reset_row(csi.data(min_nume), csi.used(min_nume));
 
   csi.sum_prod = 0;
 
-  for (int two_k = two_k_min; two_k <= two_k_max; two_k += 2) {
+  for (int two_k = two_k_first; two_k <= two_k_last; two_k += two_k_step) {
 
     factor_6j(pool, csi, two_a, two_b, two_c, two_f, two_i, two_k, csi.data(triprod_Fx + 0), csi.used(triprod_Fx + 0),
               csi.triprod);
@@ -388,20 +643,21 @@ void Calculator::calcsum_9j(const GlobalFactorialPool &pool, TempStorage &csi, i
     sum3(csi.data(nume_triprod), csi.used(nume_triprod), csi.view(triprod_Fx + 0), csi.view(triprod_Fx + 1),
          csi.view(triprod_Fx + 2));
 
-    delta_coeff(pool, two_a, two_i, two_k, csi.data(nume_triprod), csi.used(nume_triprod));
-    delta_coeff(pool, two_f, two_b, two_k, csi.data(nume_triprod), csi.used(nume_triprod));
-    delta_coeff(pool, two_h, two_d, two_k, csi.data(nume_triprod), csi.used(nume_triprod));
+    delta_coeff(pool, csi, two_a, two_i, two_k, csi.data(nume_triprod), csi.used(nume_triprod));
+    delta_coeff(pool, csi, two_f, two_b, two_k, csi.data(nume_triprod), csi.used(nume_triprod));
+    delta_coeff(pool, csi, two_h, two_d, two_k, csi.data(nume_triprod), csi.used(nume_triprod));
 
     const auto v_f1 = pool.prime_factor(two_k + 1);
 
     expand_add(csi.data(nume_triprod), csi.used(nume_triprod), v_f1);
 
-    if (two_k == two_k_min) {
+    if (two_k == two_k_first) {
       copy(csi.data(min_nume), csi.used(min_nume), csi.view(nume_triprod));
       csi.big_nume = 1;
       csi.big_div = 1;
     } else {
-      ensure_used(csi.used(min_nume), csi.view(nume_triprod).used);
+      ensure_used(csi.used(min_nume), csi.used(nume_triprod));
+      ensure_used(csi.used(nume_triprod), csi.used(min_nume));
       store_min_and_diff(csi.data(min_nume), csi.used(min_nume), csi.data(nume_triprod), csi.used(nume_triprod));
       csi.pexpo_tmp.evaluate2(pool.prime_table, csi.big_div, csi.big_nume, csi.view(nume_triprod));
     }
@@ -416,33 +672,100 @@ void Calculator::calcsum_9j(const GlobalFactorialPool &pool, TempStorage &csi, i
       csi.sum_prod += csi.triprod_tmp;
     }
   }
+}
 
-  reset_row(csi.data(prefact), csi.used(prefact));
+void Calculator::merge_9j(const global::PrimeTable &prime_table, TempStorage &into, TempStorage &from) noexcept {
+  const std::uint32_t used = std::max(into.used(min_nume), from.used(min_nume));
+  ensure_used(into.used(min_nume), used);
+  ensure_used(from.used(min_nume), used);
+  store_min_and_diff(into.data(min_nume), into.used(min_nume), from.data(min_nume), from.used(min_nume));
+  into.pexpo_tmp.evaluate2(prime_table, into.big_div, into.big_nume, from.view(min_nume));
 
-  delta_coeff(pool, two_a, two_b, two_c, csi.data(prefact), csi.used(prefact));
-  delta_coeff(pool, two_d, two_e, two_f, csi.data(prefact), csi.used(prefact));
-  delta_coeff(pool, two_g, two_h, two_i, csi.data(prefact), csi.used(prefact));
-  delta_coeff(pool, two_a, two_d, two_g, csi.data(prefact), csi.used(prefact));
-  delta_coeff(pool, two_b, two_e, two_h, csi.data(prefact), csi.used(prefact));
-  delta_coeff(pool, two_c, two_f, two_i, csi.data(prefact), csi.used(prefact));
+  into.triprod_tmp = from.sum_prod * into.big_div;
+  into.sum_prod *= into.big_nume;
+  into.sum_prod += into.triprod_tmp;
 }
 
-def::double_type Calculator::eval_calcsum_info(const global::PrimeTable &prime_table, TempStorage &csi) noexcept {
+void Calculator::calcsum_9j_zero(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2,
+                                 int two_j3, int two_j4, int two_j5, int two_j6, int two_j7, int two_j8,
+                                 int two_j9) noexcept {
+  int m[3][3] = {{two_j1, two_j2, two_j3}, {two_j4, two_j5, two_j6}, {two_j7, two_j8, two_j9}};
+
+  /* an odd permutation of rows or columns gives (-1)^(sum of all j) */
+  const int odd_perm = ((two_j1 + two_j2 + two_j3 + two_j4 + two_j5 + two_j6 + two_j7 + two_j8 + two_j9) / 2) & 1;
+  int sign = 0;
+
+  int row = 0, col = 0;
+  while (m[row][col]) {
+    if (++col == 3) {
+      col = 0;
+      ++row;
+    }
+  }
+  if (row != 2) {
+    std::swap(m[row], m[2]);
+    sign ^= odd_perm;
+  }
+  if (col != 2) {
+    for (auto &r : m) {
+      std::swap(r[col], r[2]);
+    }
+    sign ^= odd_perm;
+  }
+
+  /* {a b c; d e c; g g 0} = (-1)^(b + c + d + g) / sqrt((2c + 1)(2g + 1)) {a b c; e d g} */
+  const int two_a = m[0][0], two_b = m[0][1], two_c = m[0][2];
+  const int two_d = m[1][0], two_e = m[1][1], two_g = m[2][0];
+  sign ^= ((two_b + two_c + two_d + two_g) / 2) & 1;
+
+  calcsum_6j(pool, csi, two_a, two_b, two_c, two_e, two_d, two_g);
+
+  expand_sub(csi.data(prefact), csi.used(prefact), pool.prime_factor(two_c + 1));
+  expand_sub(csi.data(prefact), csi.used(prefact), pool.prime_factor(two_g + 1));
+
+  if (sign) {
+    csi.sum_prod = -csi.sum_prod;
+  }
+}
+
+template <typename Float>
+Float Calculator::eval_calcsum_info(const global::PrimeTable &prime_table, TempStorage &csi) noexcept {
 
   split_sqrt_add(prime_table, csi.data(prefact), csi.used(prefact), csi.big_sqrt, csi.data(min_nume),
                  csi.used(min_nume));
 
+  if (Float r; eval_fixed<def::dword_t, def::udword_t>(prime_table, csi, r)) {
+    return r;
+  }
+
   csi.pexpo_tmp.evaluate2(prime_table, csi.big_nume, csi.big_div, csi.view(prefact));
 
-  csi.big_nume *= csi.sum_prod;
-  std::swap(csi.big_nume_prod, csi.big_nume);
+  csi.big_nume_prod = csi.sum_prod * csi.big_nume;
 
-  const auto [d_nume_prod, exp_nume_prod] = csi.big_nume_prod.to_floating_point();
-  const auto [d_div, exp_div] = csi.big_div.to_floating_point();
-  const auto [d_sqrt, exp_sqrt] = csi.big_sqrt.to_floating_point();
+  const auto [d_nume_prod, exp_nume_prod] = csi.big_nume_prod.to_floating_point<Float>();
+  const auto [d_div, exp_div] = csi.big_div.to_floating_point<Float>();
+  const auto [d_sqrt, exp_sqrt] = csi.big_sqrt.to_floating_point<Float>();
 
-  const def::double_type r = (d_nume_prod / d_div) / std::sqrt(d_sqrt);
+  const Float r = (d_nume_prod / d_div) / std::sqrt(d_sqrt);
   const int res_exponent = exp_nume_prod - exp_div - exp_sqrt / 2;
   return std::ldexp(r, res_exponent);
 }
+
+template double Calculator::calc_cg<double>(const global::GlobalFactorialPool &, TempStorage &, int, int, int, int,
+                                            int, int) noexcept;
+template double Calculator::calc_3j<double>(const global::GlobalFactorialPool &, TempStorage &, int, int, int, int,
+                                            int, int) noexcept;
+template double Calculator::calc_6j<double>(const global::GlobalFactorialPool &, TempStorage &, int, int, int, int,
+                                            int, int) noexcept;
+template double Calculator::calc_9j<double>(const global::GlobalFactorialPool &, TempStorage &, int, int, int, int,
+                                            int, int, int, int, int) noexcept;
+
+template long double Calculator::calc_cg<long double>(const global::GlobalFactorialPool &, TempStorage &, int, int,
+                                                      int, int, int, int) noexcept;
+template long double Calculator::calc_3j<long double>(const global::GlobalFactorialPool &, TempStorage &, int, int,
+                                                      int, int, int, int) noexcept;
+template long double Calculator::calc_6j<long double>(const global::GlobalFactorialPool &, TempStorage &, int, int,
+                                                      int, int, int, int) noexcept;
+template long double Calculator::calc_9j<long double>(const global::GlobalFactorialPool &, TempStorage &, int, int,
+                                                      int, int, int, int, int, int, int) noexcept;
 } // namespace wigcpp::internal::calc
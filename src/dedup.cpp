@@ -0,0 +1,129 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "internal/dedup.hpp"
+#include "internal/calc.hpp"
+#include "internal/symmetry.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+namespace wigcpp::internal::dedup {
+
+namespace {
+using calc::TrivialZero;
+
+constexpr std::size_t empty = ~std::size_t{0};
+
+std::atomic<bool> dedup_on{false};
+
+std::uint64_t hash(const int *two_j, int args) noexcept {
+  std::uint64_t h = 0;
+  for (int i = 0; i < args; ++i) {
+    h = (h ^ static_cast<std::uint32_t>(two_j[i])) * 0x9e3779b97f4a7c15ull;
+  }
+  return h ^ (h >> 29);
+}
+
+/* the representative of the class of a symbol and its sign, false for a trivial zero */
+bool canonical(int wigner_type, const int *s, std::array<int, 9> &rep, int &sign) noexcept {
+  sign = 1;
+  switch (wigner_type) {
+  case 3: {
+    if (TrivialZero::is_zero_3j(s[0], s[1], s[2], s[3], s[4], s[5])) {
+      return false;
+    }
+    const auto canon = symmetry::canonicalize_3j(s[0], s[1], s[2], s[3], s[4], s[5]);
+    const auto a = symmetry::representative_3j(canon);
+    std::copy(a.begin(), a.end(), rep.begin());
+    sign = canon.sign;
+    return true;
+  }
+  case 6: {
+    if (TrivialZero::is_zero_6j(s[0], s[1], s[2], s[3], s[4], s[5])) {
+      return false;
+    }
+    const auto a = symmetry::representative_6j(symmetry::canonicalize_6j(s[0], s[1], s[2], s[3], s[4], s[5]));
+    std::copy(a.begin(), a.end(), rep.begin());
+    return true;
+  }
+  default: {
+    if (TrivialZero::is_zero_9j(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[8])) {
+      return false;
+    }
+    const auto canon = symmetry::canonicalize_9j({s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[8]});
+    rep = canon.two_j;
+    sign = canon.sign;
+    return true;
+  }
+  }
+}
+} // namespace
+
+void set_enabled(bool enable) noexcept {
+  dedup_on.store(enable, std::memory_order_relaxed);
+}
+
+bool enabled() noexcept {
+  return dedup_on.load(std::memory_order_relaxed);
+}
+
+UniqueSymbols unique_symbols(int wigner_type, const int *two_j, std::size_t count) noexcept {
+  UniqueSymbols unique;
+  unique.args = wigner_type == 9 ? 9 : 6;
+  unique.index.resize(count);
+  unique.sign.resize(count);
+  const int args = unique.args;
+  unique.two_j.reserve(args * count);
+
+  /* open addressing over the representatives, at most half full */
+  const std::size_t slots = std::bit_ceil(std::max<std::size_t>(2 * count, 16));
+  container::vector<std::size_t> table(slots, empty);
+
+  std::array<int, 9> rep{};
+  for (std::size_t n = 0; n < count; ++n) {
+    int sign;
+    if (!canonical(wigner_type, two_j + args * n, rep, sign)) {
+      unique.index[n] = 0;
+      unique.sign[n] = 0;
+      continue;
+    }
+    unique.sign[n] = static_cast<signed char>(sign);
+
+    std::size_t slot = hash(rep.data(), args) & (slots - 1);
+    for (;; slot = (slot + 1) & (slots - 1)) {
+      const std::size_t u = table[slot];
+      if (u == empty) {
+        table[slot] = unique.size();
+        unique.index[n] = unique.size();
+        for (int a = 0; a < args; ++a) {
+          unique.two_j.push_back(rep[a]);
+        }
+        break;
+      }
+      if (std::equal(rep.begin(), rep.begin() + args, unique.two_j.begin() + args * u)) {
+        unique.index[n] = u;
+        break;
+      }
+    }
+  }
+  return unique;
+}
+
+void scatter(const UniqueSymbols &unique, const double *unique_results, double *results) noexcept {
+  /* accidental zeros stay +0.0 whatever the sign, as the Calculator returns them */
+  for (std::size_t n = 0; n < unique.index.size(); ++n) {
+    const double value = unique.sign[n] ? unique_results[unique.index[n]] : 0.0;
+    results[n] = value != 0.0 ? unique.sign[n] * value : 0.0;
+  }
+}
+
+} // namespace wigcpp::internal::dedup
@@ -26,6 +26,15 @@ void error_process(ErrorCode code) noexcept {
   case ErrorCode::BAD_WIGNER_TYPE:
     std::fprintf(stderr, "Wigner type must be 3, 6 or 9.\nwigcpp: aborted.\n");
     std::abort();
+  case ErrorCode::OUT_OF_TABLE_RANGE:
+    std::fprintf(stderr, "Symbol is out of the range of the table.\nwigcpp: aborted.\n");
+    std::abort();
+  case ErrorCode::BAD_MAX_TWO_J:
+    std::fprintf(stderr, "max_two_j is out of the range the table supports.\nwigcpp: aborted.\n");
+    std::abort();
+  case ErrorCode::NULL_TABLE:
+    std::fprintf(stderr, "Table file is NULL, it was not opened.\nwigcpp: aborted.\n");
+    std::abort();
   default:
     std::fprintf(stderr, "Unknown error occurred.\nwigcpp: aborted.\n");
     std::abort();
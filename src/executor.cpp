@@ -0,0 +1,422 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "internal/executor.hpp"
+#include "internal/batch.hpp"
+#include "internal/calc.hpp"
+#include "internal/dedup.hpp"
+#include "internal/error.hpp"
+#include "internal/parallel.hpp"
+#include "internal/tmp_pool.hpp"
+#include "internal/vector.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <numeric>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace wigcpp::internal::exec {
+
+namespace {
+using calc::TrivialZero;
+
+/* Chunks per worker, so the stealing evens out the costs the model gets wrong. A chunk of cheap symbols holds at least
+ * min_chunk_symbols of them, which fill the lanes of the batch kernels and outweigh taking the chunk, unless they cost
+ * min_chunk_cost together. */
+constexpr int chunks_per_worker = 16;
+constexpr std::size_t min_chunk_symbols = 32;
+constexpr double min_chunk_cost = 1e4;
+
+/* Batches run the classes of cost, each a power of 2, from the heaviest one, so the heavy symbols don't start last and
+ * leave a few workers busy at the end. Within a class the symbols go by their largest argument, so those of a chunk
+ * meet the same factorial rows and triangle coefficients. */
+constexpr std::uint64_t max_cost_class = 1023;
+
+/* the used length of the row of n!, past the pool the last row */
+double row_used(const GlobalFactorialPool &pool, std::size_t n) noexcept {
+  return pool[std::min<std::size_t>(n, pool.prime_table.max_factorial)].used;
+}
+
+/* the terms of the sum of factor_6j and its largest factorial */
+int terms_6j(int two_a, int two_b, int two_e, int two_d, int two_c, int two_f, std::size_t &max_factorial) noexcept {
+  const int k_min = std::max({two_a + two_b + two_e, two_c + two_d + two_e, two_a + two_c + two_f,
+                              two_b + two_d + two_f}) / 2;
+  const int beta1 = two_a + two_b + two_c + two_d;
+  const int beta2 = two_a + two_d + two_e + two_f;
+  const int beta3 = two_b + two_c + two_e + two_f;
+  const int k_max = std::min({beta1, beta2, beta3}) / 2;
+  max_factorial = std::max({k_max + 1, beta1 / 2, beta2 / 2, beta3 / 2});
+  return std::max(k_max - k_min + 1, 1);
+}
+
+double cost_3j(const GlobalFactorialPool &pool, const int *s) noexcept {
+  if (TrivialZero::is_zero_3j(s[0], s[1], s[2], s[3], s[4], s[5])) {
+    return 1;
+  }
+  const int k_min = std::max({s[0] + s[4] - s[2], s[1] - s[3] - s[2], 0}) / 2;
+  const int k_max = std::min({s[1] + s[4], s[0] - s[3], s[0] + s[1] - s[2]}) / 2;
+  const double used = row_used(pool, (s[0] + s[1] + s[2]) / 2 + 1);
+  if (!s[3] && !s[4] && !s[5]) {
+    return used;
+  }
+  return (k_max - k_min + 2) * used;
+}
+
+double cost_6j(const GlobalFactorialPool &pool, const int *s) noexcept {
+  if (TrivialZero::is_zero_6j(s[0], s[1], s[2], s[3], s[4], s[5]) || !(s[0] && s[1] && s[2] && s[3] && s[4] && s[5])) {
+    return 1;
+  }
+  std::size_t max_factorial;
+  const int terms = terms_6j(s[0], s[1], s[2], s[3], s[4], s[5], max_factorial);
+  return (terms + 1) * row_used(pool, max_factorial);
+}
+
+/* the three 6j sums of every k of calcsum_9j */
+double cost_9j(const GlobalFactorialPool &pool, const int *s) noexcept {
+  if (TrivialZero::is_zero_9j(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[8])) {
+    return 1;
+  }
+  const int two_a = s[0], two_b = s[1], two_c = s[2], two_d = s[3], two_e = s[4], two_f = s[5], two_g = s[6],
+            two_h = s[7], two_i = s[8];
+  if (!(two_a && two_b && two_c && two_d && two_e && two_f && two_g && two_h && two_i)) {
+    /* a single 6j symbol, whose cost its largest entries bound */
+    const int two_j = *std::max_element(s, s + 9);
+    const int six[6] = {two_j, two_j, two_j, two_j, two_j, two_j};
+    return cost_6j(pool, six);
+  }
+  const int two_k_min = std::max({std::abs(two_h - two_d), std::abs(two_b - two_f), std::abs(two_a - two_i)});
+  const int two_k_max = std::min({two_h + two_d, two_b + two_f, two_a + two_i});
+
+  double terms = 0;
+  std::size_t max_factorial = 0, n;
+  for (int two_k = two_k_min; two_k <= two_k_max; two_k += 2) {
+    terms += terms_6j(two_a, two_b, two_c, two_f, two_i, two_k, n) + 1;
+    max_factorial = std::max(max_factorial, n);
+    terms += terms_6j(two_f, two_d, two_e, two_h, two_b, two_k, n) + 1;
+    max_factorial = std::max(max_factorial, n);
+    terms += terms_6j(two_h, two_i, two_g, two_a, two_d, two_k, n) + 1;
+    max_factorial = std::max(max_factorial, n);
+  }
+  return std::max(terms, 1.0) * row_used(pool, max_factorial);
+}
+
+int arguments(int wigner_type) noexcept {
+  return wigner_type == 9 ? 9 : 6;
+}
+
+void evaluate(const GlobalFactorialPool &pool, int wigner_type, const int *two_j, std::size_t count,
+              double *results) noexcept {
+  auto &csi = tmp::TempManager::get(pool.max_two_j, pool.stride());
+  switch (wigner_type) {
+  case 3:
+    batch::batch_3j(pool, csi, two_j, count, results);
+    break;
+  case 6:
+    batch::batch_6j(pool, csi, two_j, count, results);
+    break;
+  default:
+    for (std::size_t n = 0; n < count; ++n) {
+      const int *s = two_j + 9 * n;
+      results[n] = static_cast<double>(
+          calc::Calculator::calc_9j(pool, csi, s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[8]));
+    }
+  }
+}
+
+/* the symbols of a batch, the heavy ones first, in chunks of about equal cost */
+void run_batch(Executor &executor, const GlobalFactorialPool &pool, int wigner_type, const int *two_j,
+               std::size_t count, double *results) noexcept {
+  if (!count) {
+    return;
+  }
+  const int args = arguments(wigner_type);
+
+  double total = 0;
+  container::vector<double> costs(count);
+  container::vector<std::uint64_t> keys(count);
+  for (std::size_t n = 0; n < count; ++n) {
+    const int *s = two_j + args * n;
+    costs[n] = symbol_cost(pool, wigner_type, s);
+    total += costs[n];
+    const auto cost_class = static_cast<std::uint64_t>(std::ilogb(costs[n]));
+    const auto max_two_j = static_cast<std::uint64_t>(*std::max_element(s, s + (wigner_type == 3 ? 3 : args)));
+    keys[n] = (max_cost_class - cost_class) << 32 | (std::numeric_limits<std::uint32_t>::max() - max_two_j);
+  }
+
+  /* the symbols by keys, the heavy ones first, unless they already are */
+  container::vector<std::size_t> order;
+  const bool sorted = std::is_sorted(keys.begin(), keys.end());
+  if (!sorted) {
+    order.resize(count);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+      return keys[lhs] < keys[rhs] || (keys[lhs] == keys[rhs] && lhs < rhs);
+    });
+  }
+  auto symbol = [&](std::size_t n) { return sorted ? n : order[n]; };
+
+  /* a chunk ends once it reaches the target cost */
+  const double target = total / (static_cast<double>(executor.size()) * chunks_per_worker);
+  container::vector<std::size_t> bounds(1, std::size_t{0});
+  double acc = 0;
+  for (std::size_t n = 0; n < count; ++n) {
+    acc += costs[symbol(n)];
+    if (acc >= target && (n + 1 - bounds.back() >= min_chunk_symbols || acc >= min_chunk_cost)) {
+      bounds.push_back(n + 1);
+      acc = 0;
+    }
+  }
+  if (bounds.back() != count) {
+    bounds.push_back(count);
+  }
+
+  executor.run(static_cast<std::int64_t>(bounds.size() - 1), [&](std::int64_t chunk) {
+    const std::size_t first = bounds[chunk], size = bounds[chunk + 1] - first;
+    if (sorted) {
+      evaluate(pool, wigner_type, two_j + args * first, size, results + first);
+      return;
+    }
+    /* gathered into a contiguous chunk for the batch kernels, and scattered back */
+    container::vector<int> chunk_two_j(args * size);
+    container::vector<double> chunk_results(size);
+    for (std::size_t n = 0; n < size; ++n) {
+      std::copy_n(two_j + args * order[first + n], args, chunk_two_j.begin() + args * n);
+    }
+    evaluate(pool, wigner_type, chunk_two_j.data(), size, chunk_results.data());
+    for (std::size_t n = 0; n < size; ++n) {
+      results[order[first + n]] = chunk_results[n];
+    }
+  });
+}
+} // namespace
+
+double symbol_cost(const GlobalFactorialPool &pool, int wigner_type, const int *two_j) noexcept {
+  switch (wigner_type) {
+  case 3:
+    return cost_3j(pool, two_j);
+  case 6:
+    return cost_6j(pool, two_j);
+  case 9:
+    return cost_9j(pool, two_j);
+  default:
+    std::fprintf(stderr, "error in symbol_cost: wigner_type must be 3, 6 or 9.\n");
+    error::error_process(error::ErrorCode::BAD_WIGNER_TYPE);
+  }
+}
+
+Executor::Executor(int num_threads, bool pin) noexcept {
+  if (num_threads <= 0) {
+    num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  }
+  num_workers = num_threads;
+  deques = std::make_unique<Deque[]>(num_workers);
+  for (int w = 0; w < num_workers; ++w) {
+    deques[w].top.store(0, std::memory_order_relaxed);
+    deques[w].bottom.store(0, std::memory_order_relaxed);
+    deques[w].first = deques[w].count = 0;
+  }
+  /* workers whose thread fails to start are left out, the started ones only read num_workers in a batch */
+  try {
+    threads.reserve(num_workers - 1);
+    for (int w = 1; w < num_workers; ++w) {
+      threads.emplace_back([this, w, pin] { loop(w, pin); });
+    }
+  } catch (...) {
+  }
+  num_workers = 1 + static_cast<int>(threads.size());
+}
+
+Executor::~Executor() noexcept {
+  {
+    std::lock_guard lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (auto &t : threads) {
+    t.join();
+  }
+}
+
+/* the owner takes from the back, and races the thieves only for the last chunk */
+bool Executor::pop(int worker, std::int64_t &chunk) noexcept {
+  Deque &d = deques[worker];
+  const std::int64_t b = d.bottom.load(std::memory_order_relaxed) - 1;
+  d.bottom.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::int64_t t = d.top.load(std::memory_order_relaxed);
+  if (t > b) {
+    d.bottom.store(b + 1, std::memory_order_relaxed);
+    return false;
+  }
+  chunk = chunk_at(worker, b);
+  if (t < b) {
+    return true;
+  }
+  const bool won = d.top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+  d.bottom.store(b + 1, std::memory_order_relaxed);
+  return won;
+}
+
+/* thieves take from the front of the deques of the other workers, starting after their own */
+bool Executor::steal(int worker, std::int64_t &chunk) noexcept {
+  for (int i = 1; i < num_workers; ++i) {
+    const int victim = (worker + i) % num_workers;
+    Deque &d = deques[victim];
+    for (;;) {
+      std::int64_t t = d.top.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const std::int64_t b = d.bottom.load(std::memory_order_acquire);
+      if (t >= b) {
+        break;
+      }
+      if (d.top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        chunk = chunk_at(victim, t);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void Executor::work(int worker) noexcept {
+  /* the symbols of a batch keep their sums serial, the workers already fill the cores */
+  parallel::PartScope scope;
+  std::int64_t chunk;
+  while (pop(worker, chunk) || steal(worker, chunk)) {
+    task(context, chunk);
+  }
+}
+
+void Executor::loop(int worker, bool pin) noexcept {
+#ifdef __linux__
+  if (pin) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(worker % static_cast<int>(std::max(1u, std::thread::hardware_concurrency())), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  }
+#else
+  (void)pin;
+#endif
+  std::uint64_t seen = 0;
+  for (;;) {
+    {
+      std::unique_lock lock(mutex);
+      wake.wait(lock, [&] { return stopping || generation != seen; });
+      if (stopping) {
+        return;
+      }
+      seen = generation;
+      ++busy;
+    }
+    work(worker);
+    {
+      std::lock_guard lock(mutex);
+      --busy;
+    }
+    done.notify_one();
+  }
+}
+
+void Executor::run_chunks(std::int64_t num_chunks, void (*fn)(void *, std::int64_t) noexcept, void *ctx) noexcept {
+  if (num_chunks <= 0) {
+    return;
+  }
+  std::lock_guard run_lock(run_mutex);
+  {
+    /* a worker that woke too late for the last batch may still look at its empty deques */
+    std::unique_lock lock(mutex);
+    done.wait(lock, [&] { return !busy; });
+    task = fn;
+    context = ctx;
+    std::int64_t first = 0;
+    for (int w = 0; w < num_workers; ++w) {
+      Deque &d = deques[w];
+      d.first = first;
+      d.count = w < num_chunks ? (num_chunks - w + num_workers - 1) / num_workers : 0;
+      first += d.count;
+      d.top.store(d.first, std::memory_order_relaxed);
+      d.bottom.store(d.first + d.count, std::memory_order_relaxed);
+    }
+    ++generation;
+  }
+  wake.notify_all();
+  work(0);
+
+  /* a worker may still run the last chunk it took, and must not see the deques of the next batch */
+  std::unique_lock lock(mutex);
+  done.wait(lock, [&] { return !busy; });
+}
+
+namespace {
+std::unique_ptr<Executor> start(int num_threads, bool pin) noexcept {
+  std::unique_ptr<Executor> executor(new (std::nothrow) Executor(num_threads, pin));
+  if (!executor) [[unlikely]] {
+    std::fprintf(stderr, "error in ExecutorManager: failed to allocate the executor.\n");
+    error::error_process(error::ErrorCode::Bad_Alloc);
+  }
+  return executor;
+}
+} // namespace
+
+void ExecutorManager::put_back() noexcept {
+  std::lock_guard lock(mutex);
+  if (!--leases) {
+    idle.notify_all();
+  }
+}
+
+void ExecutorManager::replace(std::unique_ptr<Executor> executor) noexcept {
+  std::unique_lock lock(mutex);
+  idle.wait(lock, [] { return !replacing; });
+  replacing = true;
+  idle.wait(lock, [] { return !leases; });
+  ptr = std::move(executor);
+  replacing = false;
+  idle.notify_all();
+}
+
+void ExecutorManager::init(int num_threads, bool pin) noexcept {
+  /* the workers of the old executor are stopped before the new ones start */
+  replace(nullptr);
+  replace(start(num_threads, pin));
+}
+
+void ExecutorManager::shutdown() noexcept {
+  replace(nullptr);
+}
+
+ExecutorManager::lease ExecutorManager::get() noexcept {
+  std::unique_lock lock(mutex);
+  idle.wait(lock, [] { return !replacing; });
+  if (!ptr) [[unlikely]] {
+    ptr = start(0, false);
+  }
+  ++leases;
+  return lease(*ptr);
+}
+
+void eval_batch(Executor &executor, const GlobalFactorialPool &pool, int wigner_type, const int *two_j,
+                std::size_t count, double *results) noexcept {
+  if (wigner_type != 3 && wigner_type != 6 && wigner_type != 9) [[unlikely]] {
+    std::fprintf(stderr, "error in eval_batch: wigner_type must be 3, 6 or 9.\n");
+    error::error_process(error::ErrorCode::BAD_WIGNER_TYPE);
+  }
+  dedup::eval_unique(wigner_type, two_j, count, results, [&](const int *unique, std::size_t size, double *out) {
+    run_batch(executor, pool, wigner_type, unique, size, out);
+  });
+}
+
+} // namespace wigcpp::internal::exec
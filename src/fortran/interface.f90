@@ -3,17 +3,249 @@ module wigcpp
   implicit none
   private
 
-  public :: wigcpp_ensure_global, wigcpp_reset_tls, clebsch_gordan, wigner3j, wigner6j, wigner9j
+  public :: wigcpp_set_allocator
+  public :: wigcpp_plan_memory, wigcpp_ensure_global_budget, wigcpp_release
+  public :: wigcpp_ensure_global, wigcpp_reset_tls, wigcpp_recycle_tls, wigcpp_shrink_tls
+  public :: clebsch_gordan, wigner3j, wigner6j, wigner9j
+  public :: wigcpp_cache_enable, wigcpp_cache_disable, wigcpp_cache_stats, wigcpp_cache_reset_stats
+  public :: wigcpp_parallel_sums
+  public :: wigcpp_table_size, wigcpp_table_fill, wigcpp_table_index_3j, wigcpp_table_index_6j
+  public :: wigcpp_table_open, wigcpp_table_close, wigcpp_table_lookup_3j, wigcpp_table_lookup_6j, wigcpp_table_lookup_9j
+  public :: wigcpp_batch_3j, wigcpp_batch_6j, wigcpp_batch_dedup
+  public :: wigcpp_executor_init, wigcpp_executor_shutdown, wigcpp_estimate_cost, wigcpp_eval_batch_parallel
+  public :: wigcpp_tiered_cg, wigcpp_tiered_3j, wigcpp_tiered_6j
+  public :: wigcpp_asymptotic_3j, wigcpp_asymptotic_6j
+  public :: wigcpp_family_3j_j, wigcpp_family_3j_m, wigcpp_family_6j
+  public :: clebsch_gordan_l, wigner3j_l, wigner6j_l, wigner9j_l
 
   interface
+    function wigcpp_set_allocator(alloc, dealloc, user) bind(c, name="wigcpp_set_allocator")
+      import c_funptr, c_ptr, c_int
+      type(c_funptr), value :: alloc, dealloc
+      type(c_ptr), value :: user
+      integer(c_int) :: wigcpp_set_allocator
+    end function
+
     subroutine wigcpp_ensure_global(max_two_j, wigner_type) bind(c, name="wigcpp_ensure_global")
       import c_int
       integer(c_int), value :: max_two_j, wigner_type
     end subroutine
 
+    function wigcpp_plan_memory(max_two_j, wigner_type, num_threads, cache_bytes, pool_bytes, thread_bytes) &
+        bind(c, name="wigcpp_plan_memory")
+      import c_int, c_long_long
+      integer(c_int), value :: max_two_j, wigner_type, num_threads
+      integer(c_long_long), value :: cache_bytes
+      integer(c_long_long) :: pool_bytes, thread_bytes
+      integer(c_long_long) :: wigcpp_plan_memory
+    end function
+
+    function wigcpp_ensure_global_budget(max_two_j, wigner_type, num_threads, budget_bytes) &
+        bind(c, name="wigcpp_ensure_global_budget")
+      import c_int, c_long_long
+      integer(c_int), value :: max_two_j, wigner_type, num_threads
+      integer(c_long_long), value :: budget_bytes
+      integer(c_int) :: wigcpp_ensure_global_budget
+    end function
+
+    subroutine wigcpp_release() bind(c, name="wigcpp_release")
+    end subroutine
+
     subroutine wigcpp_reset_tls() bind(c, name="wigcpp_reset_tls")
     end subroutine
 
+    subroutine wigcpp_recycle_tls(max_storages) bind(c, name="wigcpp_recycle_tls")
+      import c_int
+      integer(c_int), value :: max_storages
+    end subroutine
+
+    subroutine wigcpp_shrink_tls() bind(c, name="wigcpp_shrink_tls")
+    end subroutine
+
+    subroutine wigcpp_cache_enable(max_bytes) bind(c, name="wigcpp_cache_enable")
+      import c_long_long
+      integer(c_long_long), value :: max_bytes
+    end subroutine
+
+    subroutine wigcpp_cache_disable() bind(c, name="wigcpp_cache_disable")
+    end subroutine
+
+    subroutine wigcpp_cache_stats(hits, misses) bind(c, name="wigcpp_cache_stats")
+      import c_long_long
+      integer(c_long_long) :: hits, misses
+    end subroutine
+
+    subroutine wigcpp_cache_reset_stats() bind(c, name="wigcpp_cache_reset_stats")
+    end subroutine
+
+    subroutine wigcpp_parallel_sums(num_threads) bind(c, name="wigcpp_parallel_sums")
+      import c_int
+      integer(c_int), value :: num_threads
+    end subroutine
+
+    function wigcpp_table_size(wigner_type, max_two_j) bind(c, name="wigcpp_table_size")
+      import c_int, c_long_long
+      integer(c_int), value :: wigner_type, max_two_j
+      integer(c_long_long) :: wigcpp_table_size
+    end function
+
+    subroutine wigcpp_table_fill(wigner_type, max_two_j, table, num_threads) bind(c, name="wigcpp_table_fill")
+      import c_int, c_double
+      integer(c_int), value :: wigner_type, max_two_j, num_threads
+      real(c_double) :: table(*)
+    end subroutine
+
+    function wigcpp_table_index_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3, sign) &
+        bind(c, name="wigcpp_table_index_3j")
+      import c_int, c_long_long
+      integer(c_int), value :: two_j1, two_j2, two_j3, two_m1, two_m2, two_m3
+      integer(c_int) :: sign
+      integer(c_long_long) :: wigcpp_table_index_3j
+    end function
+
+    function wigcpp_table_index_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6) bind(c, name="wigcpp_table_index_6j")
+      import c_int, c_long_long
+      integer(c_int), value :: two_j1, two_j2, two_j3, two_j4, two_j5, two_j6
+      integer(c_long_long) :: wigcpp_table_index_6j
+    end function
+
+    function wigcpp_table_open(path, verify) bind(c, name="wigcpp_table_open")
+      import c_char, c_int, c_ptr
+      character(kind=c_char) :: path(*)
+      integer(c_int), value :: verify
+      type(c_ptr) :: wigcpp_table_open
+    end function
+
+    subroutine wigcpp_table_close(table) bind(c, name="wigcpp_table_close")
+      import c_ptr
+      type(c_ptr), value :: table
+    end subroutine
+
+    function wigcpp_table_lookup_3j(table, two_j1, two_j2, two_j3, two_m1, two_m2, two_m3) &
+        bind(c, name="wigcpp_table_lookup_3j")
+      import c_ptr, c_int, c_double
+      type(c_ptr), value :: table
+      integer(c_int), value :: two_j1, two_j2, two_j3, two_m1, two_m2, two_m3
+      real(c_double) :: wigcpp_table_lookup_3j
+    end function
+
+    function wigcpp_table_lookup_6j(table, two_j1, two_j2, two_j3, two_j4, two_j5, two_j6) &
+        bind(c, name="wigcpp_table_lookup_6j")
+      import c_ptr, c_int, c_double
+      type(c_ptr), value :: table
+      integer(c_int), value :: two_j1, two_j2, two_j3, two_j4, two_j5, two_j6
+      real(c_double) :: wigcpp_table_lookup_6j
+    end function
+
+    function wigcpp_table_lookup_9j(table, two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9) &
+        bind(c, name="wigcpp_table_lookup_9j")
+      import c_ptr, c_int, c_double
+      type(c_ptr), value :: table
+      integer(c_int), value :: two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9
+      real(c_double) :: wigcpp_table_lookup_9j
+    end function
+
+    subroutine wigcpp_batch_3j(two_j, count, results) bind(c, name="wigcpp_batch_3j")
+      import c_int, c_long_long, c_double
+      integer(c_int) :: two_j(*)
+      integer(c_long_long), value :: count
+      real(c_double) :: results(*)
+    end subroutine
+
+    subroutine wigcpp_batch_6j(two_j, count, results) bind(c, name="wigcpp_batch_6j")
+      import c_int, c_long_long, c_double
+      integer(c_int) :: two_j(*)
+      integer(c_long_long), value :: count
+      real(c_double) :: results(*)
+    end subroutine
+
+    subroutine wigcpp_batch_dedup(enable) bind(c, name="wigcpp_batch_dedup")
+      import c_int
+      integer(c_int), value :: enable
+    end subroutine
+
+    subroutine wigcpp_executor_init(num_threads, pin_threads) bind(c, name="wigcpp_executor_init")
+      import c_int
+      integer(c_int), value :: num_threads, pin_threads
+    end subroutine
+
+    subroutine wigcpp_executor_shutdown() bind(c, name="wigcpp_executor_shutdown")
+    end subroutine
+
+    function wigcpp_estimate_cost(wigner_type, two_j) bind(c, name="wigcpp_estimate_cost")
+      import c_int, c_double
+      integer(c_int), value :: wigner_type
+      integer(c_int) :: two_j(*)
+      real(c_double) :: wigcpp_estimate_cost
+    end function
+
+    subroutine wigcpp_eval_batch_parallel(wigner_type, two_j, count, results) bind(c, name="wigcpp_eval_batch_parallel")
+      import c_int, c_long_long, c_double
+      integer(c_int), value :: wigner_type
+      integer(c_int) :: two_j(*)
+      integer(c_long_long), value :: count
+      real(c_double) :: results(*)
+    end subroutine
+
+    function wigcpp_tiered_cg(two_j1, two_j2, two_m1, two_m2, two_J, two_M) bind(c, name="wigcpp_tiered_cg")
+      import c_int, c_double
+      integer(c_int), value :: two_j1, two_j2, two_m1, two_m2, two_J, two_M
+      real(c_double) :: wigcpp_tiered_cg
+    end function
+
+    function wigcpp_tiered_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3) bind(c, name="wigcpp_tiered_3j")
+      import c_int, c_double
+      integer(c_int), value :: two_j1, two_j2, two_j3, two_m1, two_m2, two_m3
+      real(c_double) :: wigcpp_tiered_3j
+    end function
+
+    function wigcpp_tiered_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6) bind(c, name="wigcpp_tiered_6j")
+      import c_int, c_double
+      integer(c_int), value :: two_j1, two_j2, two_j3, two_j4, two_j5, two_j6
+      real(c_double) :: wigcpp_tiered_6j
+    end function
+
+    function wigcpp_asymptotic_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3, error) &
+        bind(c, name="wigcpp_asymptotic_3j")
+      import c_int, c_double
+      integer(c_int), value :: two_j1, two_j2, two_j3, two_m1, two_m2, two_m3
+      real(c_double) :: error
+      real(c_double) :: wigcpp_asymptotic_3j
+    end function
+
+    function wigcpp_asymptotic_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, error) &
+        bind(c, name="wigcpp_asymptotic_6j")
+      import c_int, c_double
+      integer(c_int), value :: two_j1, two_j2, two_j3, two_j4, two_j5, two_j6
+      real(c_double) :: error
+      real(c_double) :: wigcpp_asymptotic_6j
+    end function
+
+    function wigcpp_family_3j_j(two_j2, two_j3, two_m2, two_m3, two_j1_min, results) bind(c, name="wigcpp_family_3j_j")
+      import c_int, c_double
+      integer(c_int), value :: two_j2, two_j3, two_m2, two_m3
+      integer(c_int) :: two_j1_min
+      real(c_double) :: results(*)
+      integer(c_int) :: wigcpp_family_3j_j
+    end function
+
+    function wigcpp_family_3j_m(two_j1, two_j2, two_j3, two_m1, two_m2_min, results) bind(c, name="wigcpp_family_3j_m")
+      import c_int, c_double
+      integer(c_int), value :: two_j1, two_j2, two_j3, two_m1
+      integer(c_int) :: two_m2_min
+      real(c_double) :: results(*)
+      integer(c_int) :: wigcpp_family_3j_m
+    end function
+
+    function wigcpp_family_6j(two_j2, two_j3, two_j4, two_j5, two_j6, two_j1_min, results) &
+        bind(c, name="wigcpp_family_6j")
+      import c_int, c_double
+      integer(c_int), value :: two_j2, two_j3, two_j4, two_j5, two_j6
+      integer(c_int) :: two_j1_min
+      real(c_double) :: results(*)
+      integer(c_int) :: wigcpp_family_6j
+    end function
+
     function clebsch_gordan(two_j1, two_j2, two_m1, two_m2, two_J, two_M) bind(c, name="clebsch_gordan")
       import c_int, c_double
       integer(c_int), value :: two_j1, two_j2, two_m1, two_m2, two_J, two_M
@@ -37,5 +269,29 @@ module wigcpp
       integer(c_int), value :: two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9
       real(c_double) :: wigner9j
     end function
+
+    function clebsch_gordan_l(two_j1, two_j2, two_m1, two_m2, two_J, two_M) bind(c, name="clebsch_gordan_l")
+      import c_int, c_long_double
+      integer(c_int), value :: two_j1, two_j2, two_m1, two_m2, two_J, two_M
+      real(c_long_double) :: clebsch_gordan_l
+    end function
+
+    function wigner3j_l(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3) bind(c, name="wigner3j_l")
+      import c_int, c_long_double
+      integer(c_int), value :: two_j1, two_j2, two_j3, two_m1, two_m2, two_m3
+      real(c_long_double) :: wigner3j_l
+    end function
+
+    function wigner6j_l(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6) bind(c, name="wigner6j_l")
+      import c_int, c_long_double
+      integer(c_int), value :: two_j1, two_j2, two_j3, two_j4, two_j5, two_j6
+      real(c_long_double) :: wigner6j_l
+    end function
+
+    function wigner9j_l(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9) bind(c, name="wigner9j_l")
+      import c_int, c_long_double
+      integer(c_int), value :: two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9
+      real(c_long_double) :: wigner9j_l
+    end function
   end interface
 end module wigcpp
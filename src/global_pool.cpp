@@ -95,7 +95,7 @@ GlobalFactorialPool::GlobalFactorialPool(int max_two_j, int wigner_type) noexcep
   fill_factorial_pool();
 }
 
-void PoolManager::ensure(int max_two_j, int wigner_type) noexcept {
+std::uint32_t PoolManager::max_factorial(int max_two_j, int wigner_type) noexcept {
   std::size_t max_factorial = (wigner_type / 3 + 2) * (max_two_j / 2) + 1;
   if (max_factorial < 2)
     max_factorial = 2;
@@ -104,6 +104,11 @@ void PoolManager::ensure(int max_two_j, int wigner_type) noexcept {
     std::fprintf(stderr, "Error: Factorial pool size exceeds maximum allowed size.\n");
     error::error_process(error::ErrorCode::TOO_LARGE_FACTORIAL);
   }
+  return static_cast<std::uint32_t>(max_factorial);
+}
+
+void PoolManager::ensure(int max_two_j, int wigner_type) noexcept {
+  const std::size_t max_factorial = PoolManager::max_factorial(max_two_j, wigner_type);
 
   if (!ptr) [[unlikely]] {
     ptr = std::make_unique<GlobalFactorialPool>(max_two_j, wigner_type);
@@ -112,6 +117,16 @@ void PoolManager::ensure(int max_two_j, int wigner_type) noexcept {
   }
 }
 
+void PoolManager::replace(int max_two_j, int wigner_type) noexcept {
+  max_factorial(max_two_j, wigner_type);
+  ptr.reset();
+  ptr = std::make_unique<GlobalFactorialPool>(max_two_j, wigner_type);
+}
+
+void PoolManager::release() noexcept {
+  ptr.reset();
+}
+
 const GlobalFactorialPool &PoolManager::get() noexcept {
   if (!ptr) [[unlikely]] {
     std::fprintf(stderr, "Error: can't operate any function calls before initialization.\n");
@@ -0,0 +1,113 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "internal/memory_plan.hpp"
+#include "internal/error.hpp"
+#include "internal/executor.hpp"
+#include "internal/global_pool.hpp"
+#include "internal/symbol_cache.hpp"
+#include "internal/tmp_pool.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+
+namespace wigcpp::internal::memory {
+
+namespace {
+using global::GlobalFactorialPool;
+using global::PoolManager;
+using tmp::TempStorage;
+
+void check_type(int wigner_type) noexcept {
+  if (wigner_type != 3 && wigner_type != 6 && wigner_type != 9) [[unlikely]] {
+    std::fprintf(stderr, "error in memory plan: wigner_type must be 3, 6 or 9.\n");
+    error::error_process(error::ErrorCode::BAD_WIGNER_TYPE);
+  }
+}
+
+int resolve_threads(int num_threads) noexcept {
+  return num_threads > 0 ? num_threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+std::size_t thread_bytes_of(std::size_t stride, std::uint32_t max_iter, std::uint32_t max_factorial) noexcept {
+  return TempStorage::row_bytes(stride, max_iter) + TempStorage::number_bytes(max_factorial);
+}
+
+std::size_t cache_bytes_of(std::size_t max_bytes) noexcept {
+  return max_bytes < cache::SymbolCache::bytes_per_shard()
+             ? 0
+             : cache::SymbolCache::shards_for(max_bytes) * cache::SymbolCache::bytes_per_shard();
+}
+} // namespace
+
+Plan plan(int max_two_j, int wigner_type, int num_threads, std::size_t cache_bytes) noexcept {
+  check_type(wigner_type);
+  const global::PrimeTable prime_table(static_cast<int>(PoolManager::max_factorial(max_two_j, wigner_type)));
+  return {GlobalFactorialPool::bytes(prime_table),
+          thread_bytes_of(prime_table.stride, TempStorage::max_iter(max_two_j), prime_table.max_factorial),
+          cache_bytes_of(cache_bytes), resolve_threads(num_threads), tmp::FreeList::capacity()};
+}
+
+bool ensure_budget(int max_two_j, int wigner_type, int num_threads, std::size_t budget) noexcept {
+  check_type(wigner_type);
+  const std::uint32_t max_factorial = PoolManager::max_factorial(max_two_j, wigner_type);
+  num_threads = resolve_threads(num_threads);
+  const cache::SymbolCache *cache = cache::CacheManager::get();
+  const std::size_t cache_bytes = cache ? cache->bytes() : 0;
+
+  /* the present pool serves these symbols as ensure_global would keep it, its storages size for both */
+  const GlobalFactorialPool *pool = PoolManager::current();
+  Plan need{};
+  if (pool && pool->prime_table.max_factorial >= max_factorial) {
+    const std::uint32_t max_iter = TempStorage::max_iter(std::max(pool->max_two_j, max_two_j));
+    need = {pool->bytes(), thread_bytes_of(pool->stride(), max_iter, pool->prime_table.max_factorial), cache_bytes,
+            num_threads, 0};
+  }
+
+  if (!need.pool_bytes || need.total() > budget) {
+    need = plan(max_two_j, wigner_type, num_threads, 0);
+    need.kept_storages = 0;
+    if (need.total() > budget) {
+      return false;
+    }
+
+    if (!pool || pool->max_two_j != max_two_j || pool->wigner_type != wigner_type) {
+      /* storages of the old pool would only be freed one by one as threads meet them */
+      PoolManager::replace(max_two_j, wigner_type);
+      tmp::TempManager::release();
+    }
+
+    if (cache) {
+      const std::size_t left = budget - need.total();
+      if (left < cache::SymbolCache::bytes_per_shard()) {
+        cache::CacheManager::disable();
+      } else if (cache_bytes > left) {
+        cache::CacheManager::enable(left);
+      }
+      cache = cache::CacheManager::get();
+      need.cache_bytes = cache ? cache->bytes() : 0;
+    }
+  }
+
+  /* the storages kept for new threads take what is left */
+  const std::size_t kept = (budget - need.total()) / need.thread_bytes;
+  if (kept < static_cast<std::size_t>(tmp::FreeList::capacity())) {
+    tmp::FreeList::set_cap(static_cast<int>(kept));
+  }
+  return true;
+}
+
+void release() noexcept {
+  exec::ExecutorManager::shutdown();
+  cache::CacheManager::disable();
+  tmp::TempManager::release();
+  PoolManager::release();
+}
+
+} // namespace wigcpp::internal::memory
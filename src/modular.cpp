@@ -0,0 +1,289 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "internal/modular.hpp"
+#include "internal/definitions.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace wigcpp::internal::modular {
+
+#if defined(__SIZEOF_INT128__) && (__SIZEOF_INT128__ == 16)
+
+namespace {
+using u64 = std::uint64_t;
+using u128 = def::multi_word_traits<8>::udword_t;
+
+/* q odd with 2^61 < q < 2^62, so that products of residues below 2q stay below q 2^64 */
+struct modulus {
+  u64 q;
+  u64 q_neg_inv; /* -q^-1 mod 2^64 */
+  u64 r2;        /* 2^128 mod q */
+};
+
+/* Montgomery reduction, t / 2^64 mod q in [0, 2q) for t < q 2^64 */
+inline u64 redc(u128 t, const modulus &m) noexcept {
+  const u64 k = static_cast<u64>(t) * m.q_neg_inv;
+  return static_cast<u64>((t + static_cast<u128>(k) * m.q) >> 64);
+}
+
+inline u64 mul(u64 a, u64 b, const modulus &m) noexcept {
+  return redc(static_cast<u128>(a) * b, m);
+}
+
+inline u64 to_montgomery(u64 a, const modulus &m) noexcept {
+  return mul(a, m.r2, m);
+}
+
+inline u64 reduce(u64 a, const modulus &m) noexcept {
+  return a >= m.q ? a - m.q : a;
+}
+
+/* a^e for a in Montgomery form */
+u64 pow(u64 a, u64 e, const modulus &m) noexcept {
+  u64 r = to_montgomery(1, m);
+  for (;;) {
+    if (e & 1) {
+      r = mul(r, a, m);
+    }
+    e >>= 1;
+    if (!e) {
+      return r;
+    }
+    a = mul(a, a, m);
+  }
+}
+
+modulus make_modulus(u64 q) noexcept {
+  u64 inv = q; /* q^-1 mod 2^3, each Newton step doubles the bits */
+  for (int i = 0; i < 5; ++i) {
+    inv *= 2 - q * inv;
+  }
+  const u64 r = static_cast<u64>((static_cast<u128>(1) << 64) % q);
+  return {q, ~inv + 1, static_cast<u64>(static_cast<u128>(r) * r % q)};
+}
+
+/* Miller-Rabin, deterministic below 2^64 with the first twelve prime bases */
+bool is_prime(u64 n) noexcept {
+  constexpr u64 bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+  for (const u64 p : bases) {
+    if (n % p == 0) {
+      return n == p;
+    }
+  }
+  const int s = std::countr_zero(n - 1);
+  const u64 d = (n - 1) >> s;
+  const auto mulmod = [n](u64 a, u64 b) { return static_cast<u64>(static_cast<u128>(a) * b % n); };
+  for (const u64 a : bases) {
+    u64 x = 1, base = a;
+    for (u64 e = d; e; e >>= 1) {
+      if (e & 1) {
+        x = mulmod(x, base);
+      }
+      base = mulmod(base, base);
+    }
+    if (x == 1 || x == n - 1) {
+      continue;
+    }
+    bool composite = true;
+    for (int r = 1; r < s && composite; ++r) {
+      x = mulmod(x, x);
+      composite = x != n - 1;
+    }
+    if (composite) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* the largest primes below 2^62, and q_j^-1 mod q_i in the Montgomery form of q_i for Garner's algorithm */
+struct moduli_table {
+  modulus moduli[max_moduli];
+  u64 garner[max_moduli][max_moduli];
+
+  moduli_table() noexcept {
+    u64 q = (u64(1) << 62) - 1;
+    for (auto &m : moduli) {
+      while (!is_prime(q)) {
+        q -= 2;
+      }
+      m = make_modulus(q);
+      q -= 2;
+    }
+    for (int i = 0; i < max_moduli; ++i) {
+      const modulus &m = moduli[i];
+      for (int j = 0; j < i; ++j) {
+        garner[i][j] = pow(to_montgomery(moduli[j].q % m.q, m), m.q - 2, m);
+      }
+    }
+  }
+};
+
+const moduli_table &table() noexcept {
+  static const moduli_table t;
+  return t;
+}
+
+constexpr int max_factor_bits = 21;
+
+/* the ratio t_(k+1) / t_k as products of four factors each, padded with ones */
+void ratio(const racah_terms &terms, int k, u64 (&n)[4], u64 (&d)[4]) noexcept {
+  int nn = 0, nd = 0;
+  for (int i = 0; i < terms.num_count; ++i) {
+    n[nn++] = static_cast<u64>(terms.num[i] + k + 1);
+  }
+  for (int i = 0; i < terms.down_count; ++i) {
+    n[nn++] = static_cast<u64>(terms.down[i] - k);
+  }
+  for (int i = 0; i < terms.up_count; ++i) {
+    d[nd++] = static_cast<u64>(terms.up[i] + k + 1);
+  }
+  std::fill(n + nn, n + 4, 1);
+  std::fill(d + nd, d + 4, 1);
+}
+
+/* mixed-radix digits of the residues, v_0 + v_1 q_0 + v_2 q_0 q_1 + ... */
+void garner(const moduli_table &t, const u64 *residue, int count, u64 *digit) noexcept {
+  for (int i = 0; i < count; ++i) {
+    const modulus &m = t.moduli[i];
+    u64 x = residue[i];
+    for (int j = 0; j < i; ++j) {
+      x = x + m.q - reduce(digit[j], m);
+      x = reduce(mul(x, t.garner[i][j], m), m);
+    }
+    digit[i] = x;
+  }
+}
+} // namespace
+
+bool sum_terms(const global::PrimeTable &prime_table, view_type first, view_type min_view, const racah_terms &terms,
+               int bits, mwi::big_int &sum_prod) noexcept {
+  /* the product of all moduli but the last exceeds twice the sum, the last one tells its sign */
+  const int count = (bits + 61) / 61 + 1;
+  if (count > max_moduli) {
+    return false;
+  }
+  int largest = 0;
+  for (int i = 0; i < terms.num_count; ++i) {
+    largest = std::max(largest, terms.num[i] + terms.k_lim + 1);
+  }
+  for (int i = 0; i < terms.up_count; ++i) {
+    largest = std::max(largest, terms.up[i] + terms.k_lim + 1);
+  }
+  for (int i = 0; i < terms.down_count; ++i) {
+    largest = std::max(largest, terms.down[i]);
+  }
+  if (std::bit_width(static_cast<unsigned>(largest)) > max_factor_bits) {
+    return false;
+  }
+
+  const moduli_table &t = table();
+
+  /* sum_k (-1)^k t_k / t_0 = a / b, by Horner's scheme from the last term with a_k / b_k = 1 - r_k a_(k+1) / b_(k+1).
+   * Reducing the products of the factors of r_k divides a and b by 2^64 alike, which leaves a / b unchanged */
+  u64 a[max_moduli], b[max_moduli];
+  std::fill(a, a + count, 1);
+  std::fill(b, b + count, 1);
+  for (int k = terms.k_lim - 1; k >= 0; --k) {
+    u64 n[4], d[4];
+    ratio(terms, k, n, d);
+    const u128 n_prod = static_cast<u128>(n[0] * n[1]) * (n[2] * n[3]);
+    const u128 d_prod = static_cast<u128>(d[0] * d[1]) * (d[2] * d[3]);
+    for (int i = 0; i < count; ++i) {
+      const modulus &m = t.moduli[i];
+      const u64 bd = mul(b[i], redc(d_prod, m), m);
+      const u64 an = mul(a[i], redc(n_prod, m), m);
+      const u64 x = bd + 2 * m.q - an;
+      a[i] = x >= 2 * m.q ? x - 2 * m.q : x;
+      b[i] = bd;
+    }
+  }
+
+  /* t_0 and b are units modulo each q, so the sum vanishes modulo q exactly when a does */
+  bool zero = true;
+  for (int i = 0; i < count; ++i) {
+    a[i] = reduce(a[i], t.moduli[i]);
+    zero = zero && !a[i];
+  }
+  if (zero) {
+    sum_prod = 0;
+    return true;
+  }
+
+  /* t_0 / min_view as products of prime powers below 2^63, shared by all moduli */
+  u64 residue[max_moduli];
+  for (int i = 0; i < count; ++i) {
+    residue[i] = to_montgomery(1, t.moduli[i]);
+  }
+  const auto flush = [&](u64 chunk) {
+    for (int i = 0; i < count; ++i) {
+      const modulus &m = t.moduli[i];
+      residue[i] = mul(residue[i], to_montgomery(chunk, m), m);
+    }
+  };
+  u64 chunk = 1;
+  int chunk_bits = 0;
+  for (auto j = 0u; j < first.used; ++j) {
+    const u64 p = prime_table.prime_list[j];
+    const int p_bits = std::bit_width(p);
+    for (exp_t e = first.ptr[j] - (j < min_view.used ? min_view.ptr[j] : 0); e > 0; --e) {
+      if (chunk_bits + p_bits > 63) {
+        flush(chunk);
+        chunk = 1;
+        chunk_bits = 0;
+      }
+      chunk *= p;
+      chunk_bits += p_bits;
+    }
+  }
+  flush(chunk);
+
+  for (int i = 0; i < count; ++i) {
+    const modulus &m = t.moduli[i];
+    const u64 b_inv = pow(to_montgomery(reduce(b[i], m), m), m.q - 2, m);
+    const u64 r = reduce(mul(mul(residue[i], b_inv, m), a[i], m), m);
+    residue[i] = (terms.sign & 1) && r ? m.q - r : r;
+  }
+
+  u64 digit[max_moduli];
+  garner(t, residue, count, digit);
+  const bool negative = digit[count - 1] != 0;
+  if (negative) {
+    for (int i = 0; i < count; ++i) {
+      residue[i] = residue[i] ? t.moduli[i].q - residue[i] : 0;
+    }
+    garner(t, residue, count, digit);
+  }
+
+  int top = count - 1;
+  while (top > 0 && !digit[top]) {
+    --top;
+  }
+  sum_prod = digit[top];
+  for (int i = top - 1; i >= 0; --i) {
+    sum_prod *= t.moduli[i].q;
+    sum_prod += digit[i];
+  }
+  if (negative) {
+    sum_prod = -sum_prod;
+  }
+  return true;
+}
+
+#else
+
+bool sum_terms(const global::PrimeTable &, view_type, view_type, const racah_terms &, int, mwi::big_int &) noexcept {
+  return false;
+}
+
+#endif
+
+} // namespace wigcpp::internal::modular
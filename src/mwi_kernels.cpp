@@ -0,0 +1,197 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "internal/mwi_kernels.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__) && defined(__SIZEOF_INT128__)
+#define WIGCPP_MWI_ADX
+#endif
+
+namespace wigcpp::internal::mwi::kernel {
+namespace {
+using def::udword_t;
+using def::shift_bits;
+
+uword_t add_n_generic(uword_t *rp, const uword_t *up, const uword_t *vp, std::size_t n, uword_t carry) noexcept {
+  for (std::size_t i = 0; i < n; ++i) {
+    const udword_t s = static_cast<udword_t>(up[i]) + vp[i] + carry;
+    rp[i] = static_cast<uword_t>(s);
+    carry = static_cast<uword_t>(s >> shift_bits);
+  }
+  return carry;
+}
+
+uword_t sub_n_generic(uword_t *rp, const uword_t *up, const uword_t *vp, std::size_t n, uword_t borrow) noexcept {
+  for (std::size_t i = 0; i < n; ++i) {
+    const udword_t s = static_cast<udword_t>(up[i]) - vp[i] - borrow;
+    rp[i] = static_cast<uword_t>(s);
+    borrow = static_cast<uword_t>(s >> shift_bits) & 1;
+  }
+  return borrow;
+}
+
+uword_t mul_1_generic(uword_t *rp, const uword_t *up, std::size_t n, uword_t v) noexcept {
+  uword_t high = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    const udword_t p = static_cast<udword_t>(up[i]) * v + high;
+    rp[i] = static_cast<uword_t>(p);
+    high = static_cast<uword_t>(p >> shift_bits);
+  }
+  return high;
+}
+
+uword_t addmul_1_generic(uword_t *rp, const uword_t *up, std::size_t n, uword_t v) noexcept {
+  uword_t high = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    const udword_t p = static_cast<udword_t>(up[i]) * v + rp[i] + high;
+    rp[i] = static_cast<uword_t>(p);
+    high = static_cast<uword_t>(p >> shift_bits);
+  }
+  return high;
+}
+
+constexpr Kernels generic_kernels{add_n_generic, sub_n_generic, mul_1_generic, addmul_1_generic};
+
+#ifdef WIGCPP_MWI_ADX
+/* The compilers keep a carry of _addcarry_u64 in a register between words, so the loops are written in assembly to
+ * keep it in the flags. The loop counter sits in rcx for jrcxz, and lea advances the pointers, neither touches the
+ * flags. */
+uword_t add_n_adx(uword_t *rp, const uword_t *up, const uword_t *vp, std::size_t n, uword_t carry) noexcept {
+  uword_t t;
+  __asm__("add $-1, %[carry]\n\t" /* CF = carry */
+          "1:\n\t"
+          "mov (%[up]), %[t]\n\t"
+          "adc (%[vp]), %[t]\n\t"
+          "mov %[t], (%[rp])\n\t"
+          "lea 8(%[up]), %[up]\n\t"
+          "lea 8(%[vp]), %[vp]\n\t"
+          "lea 8(%[rp]), %[rp]\n\t"
+          "lea -1(%[n]), %[n]\n\t"
+          "jrcxz 2f\n\t"
+          "jmp 1b\n\t"
+          "2:\n\t"
+          "mov $0, %[carry]\n\t"
+          "adc $0, %[carry]"
+          : [rp] "+r"(rp), [up] "+r"(up), [vp] "+r"(vp), [n] "+c"(n), [carry] "+r"(carry), [t] "=&r"(t)
+          :
+          : "cc", "memory");
+  return carry;
+}
+
+uword_t sub_n_adx(uword_t *rp, const uword_t *up, const uword_t *vp, std::size_t n, uword_t borrow) noexcept {
+  uword_t t;
+  __asm__("add $-1, %[borrow]\n\t" /* CF = borrow */
+          "1:\n\t"
+          "mov (%[up]), %[t]\n\t"
+          "sbb (%[vp]), %[t]\n\t"
+          "mov %[t], (%[rp])\n\t"
+          "lea 8(%[up]), %[up]\n\t"
+          "lea 8(%[vp]), %[vp]\n\t"
+          "lea 8(%[rp]), %[rp]\n\t"
+          "lea -1(%[n]), %[n]\n\t"
+          "jrcxz 2f\n\t"
+          "jmp 1b\n\t"
+          "2:\n\t"
+          "mov $0, %[borrow]\n\t"
+          "adc $0, %[borrow]"
+          : [rp] "+r"(rp), [up] "+r"(up), [vp] "+r"(vp), [n] "+c"(n), [borrow] "+r"(borrow), [t] "=&r"(t)
+          :
+          : "cc", "memory");
+  return borrow;
+}
+
+/* the high word of each product is added to the low word of the next one, the final carry goes to the last high word,
+ * as up[i] * v + 2^64 - 1 never overflows two words */
+uword_t mul_1_adx(uword_t *rp, const uword_t *up, std::size_t n, uword_t v) noexcept {
+  uword_t high = 0, low, next;
+  __asm__("xor %k[low], %k[low]\n\t" /* clears CF */
+          "1:\n\t"
+          "mulx (%[up]), %[low], %[next]\n\t"
+          "adcx %[high], %[low]\n\t"
+          "mov %[low], (%[rp])\n\t"
+          "mov %[next], %[high]\n\t"
+          "lea 8(%[up]), %[up]\n\t"
+          "lea 8(%[rp]), %[rp]\n\t"
+          "lea -1(%[n]), %[n]\n\t"
+          "jrcxz 2f\n\t"
+          "jmp 1b\n\t"
+          "2:\n\t"
+          "mov $0, %[low]\n\t"
+          "adcx %[low], %[high]"
+          : [rp] "+r"(rp), [up] "+r"(up), [n] "+c"(n), [high] "+r"(high), [low] "=&r"(low), [next] "=&r"(next)
+          : "d"(v)
+          : "cc", "memory");
+  return high;
+}
+
+/* two carry chains, adcx adds the high word of the previous product on CF and adox adds rp[i] on OF, so the two
+ * additions of a word don't wait for each other. Two words per iteration, after a single one for odd n */
+uword_t addmul_1_adx(uword_t *rp, const uword_t *up, std::size_t n, uword_t v) noexcept {
+  uword_t high = 0, low, next;
+  __asm__("xor %k[low], %k[low]\n\t" /* clears CF and OF */
+          "test $1, %b[n]\n\t"
+          "jz 1f\n\t"
+          "mulx (%[up]), %[low], %[high]\n\t"
+          "add (%[rp]), %[low]\n\t" /* can't carry out of the high word */
+          "mov %[low], (%[rp])\n\t"
+          "adc $0, %[high]\n\t"
+          "xor %k[low], %k[low]\n\t"
+          "lea 8(%[up]), %[up]\n\t"
+          "lea 8(%[rp]), %[rp]\n\t"
+          "lea -1(%[n]), %[n]\n\t"
+          "1:\n\t"
+          "jrcxz 2f\n\t"
+          "mulx (%[up]), %[low], %[next]\n\t"
+          "adcx %[high], %[low]\n\t"
+          "adox (%[rp]), %[low]\n\t"
+          "mov %[low], (%[rp])\n\t"
+          "mulx 8(%[up]), %[low], %[high]\n\t"
+          "adcx %[next], %[low]\n\t"
+          "adox 8(%[rp]), %[low]\n\t"
+          "mov %[low], 8(%[rp])\n\t"
+          "lea 16(%[up]), %[up]\n\t"
+          "lea 16(%[rp]), %[rp]\n\t"
+          "lea -2(%[n]), %[n]\n\t"
+          "jmp 1b\n\t"
+          "2:\n\t"
+          "mov $0, %[low]\n\t"
+          "adcx %[low], %[high]\n\t"
+          "adox %[low], %[high]"
+          : [rp] "+r"(rp), [up] "+r"(up), [n] "+c"(n), [high] "+r"(high), [low] "=&r"(low), [next] "=&r"(next)
+          : "d"(v)
+          : "cc", "memory");
+  return high;
+}
+
+constexpr Kernels adx_kernels{add_n_adx, sub_n_adx, mul_1_adx, addmul_1_adx};
+#endif
+} // namespace
+
+const Kernels &generic() noexcept {
+  return generic_kernels;
+}
+
+const Kernels *adx() noexcept {
+#ifdef WIGCPP_MWI_ADX
+  static const bool supported = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("adx") && __builtin_cpu_supports("bmi2");
+  }();
+  return supported ? &adx_kernels : nullptr;
+#else
+  return nullptr;
+#endif
+}
+
+const Kernels &native() noexcept {
+  static const Kernels &kernels = adx() ? *adx() : generic_kernels;
+  return kernels;
+}
+
+} // namespace wigcpp::internal::mwi::kernel
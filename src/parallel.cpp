@@ -0,0 +1,35 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "internal/parallel.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace wigcpp::internal::parallel {
+
+namespace {
+std::atomic<int> sum_threads{1};
+} // namespace
+
+void set_sum_threads(int num_threads) noexcept {
+  if (num_threads <= 0) {
+    num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  }
+  sum_threads.store(num_threads, std::memory_order_relaxed);
+}
+
+int parts(int count, int min_per_part) noexcept {
+  const int num_threads = sum_threads.load(std::memory_order_relaxed);
+  if (num_threads <= 1 || PartScope::inside()) {
+    return 1;
+  }
+  return std::max(1, std::min(num_threads, count / min_per_part));
+}
+
+} // namespace wigcpp::internal::parallel
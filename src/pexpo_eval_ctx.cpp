@@ -8,7 +8,7 @@
  */
 
 #include "internal/pexpo_eval_ctx.hpp"
-#include "internal/big_int.hpp"
+#include "internal/big_nat.hpp"
 #include "internal/global_pool.hpp"
 #include "internal/uniform_jagged_matrix.hpp"
 #include <utility>
@@ -62,7 +62,7 @@ full_mult: {
 }
 }
 
-int pexpo_eval_temp::merge_factor(int factor_active, int active, std::array<mwi::big_int, 2> &prod) noexcept {
+int pexpo_eval_temp::merge_factor(int factor_active, int active, std::array<mwi::big_nat, 2> &prod) noexcept {
   if (factor[factor_active].is_single_word()) {
     prod[active] *= factor[factor_active][0];
     return active;
@@ -75,7 +75,7 @@ int pexpo_eval_temp::merge_factor(int factor_active, int active, std::array<mwi:
   return new_active;
 }
 
-void pexpo_eval_temp::evaluate(const global::PrimeTable &prime_table, mwi::big_int &big_prod,
+void pexpo_eval_temp::evaluate(const global::PrimeTable &prime_table, mwi::big_nat &big_prod,
                                uniform_jagged_matrix<exp_t>::row_view in_fpf) noexcept {
   int active = 0;
   prod_pos[active] = 1;
@@ -96,8 +96,8 @@ void pexpo_eval_temp::evaluate(const global::PrimeTable &prime_table, mwi::big_i
   std::swap(this->prod_pos[active], big_prod);
 }
 
-void pexpo_eval_temp::evaluate2(const global::PrimeTable &prime_table, mwi::big_int &big_prod_pos,
-                                mwi::big_int &big_prod_neg, uniform_jagged_matrix<exp_t>::row_view in_fpf) noexcept {
+void pexpo_eval_temp::evaluate2(const global::PrimeTable &prime_table, mwi::big_nat &big_prod_pos,
+                                mwi::big_nat &big_prod_neg, uniform_jagged_matrix<exp_t>::row_view in_fpf) noexcept {
   int active_pos = 0, active_neg = 0;
   prod_pos[active_pos] = 1;
   prod_neg[active_neg] = 1;
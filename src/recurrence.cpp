@@ -0,0 +1,232 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "internal/recurrence.hpp"
+#include "internal/definitions.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace wigcpp::internal::recurrence {
+
+namespace {
+using real = def::double_type;
+
+/* the partial solutions are rescaled past 2^300, far from overflow in the recurrence and in the norm */
+constexpr real huge = 0x1p300;
+constexpr real tiny = 0x1p-300;
+
+/* Solves x(n) f(n + 1) + y(n) f(n) + z(n) f(n - 1) = 0 for 0 <= n < count up to normalization, with z(0) = 0 and
+ * x(count - 1) = 0 at the ends of the family. coefficients(n, x, y, z) gives the row n.
+ *
+ * The wanted solution grows away from both ends through the classically forbidden regions, where y^2 > 4 x z, and
+ * oscillates in the allowed region between them. The forward recurrence is stable from the lower end up to the upper
+ * turning point and the backward one from the upper end down to it, so they meet there, or at the peak of the forward
+ * solution in a family without an allowed region. */
+template <typename Coefficients>
+void solve(int count, Coefficients &&coefficients, double *f) noexcept {
+  f[0] = 1;
+  if (count == 1) {
+    return;
+  }
+
+  int top = count - 1;
+  bool allowed_seen = false;
+  for (int n = 0; n < count - 1; ++n) {
+    real x, y, z;
+    coefficients(n, x, y, z);
+    const bool allowed = y * y < 4 * x * z;
+    if (!allowed_seen && n > 0 && std::fabs(f[n]) < std::fabs(f[n - 1])) {
+      top = n - 1;
+      break;
+    }
+    f[n + 1] = static_cast<double>(-(y * f[n] + (n > 0 ? z * f[n - 1] : 0)) / x);
+    if (std::fabs(f[n + 1]) > huge) {
+      std::for_each(f, f + n + 2, [](double &v) { v *= static_cast<double>(tiny); });
+    }
+    if (allowed_seen && !allowed) {
+      top = n;
+      break;
+    }
+    allowed_seen = allowed_seen || allowed;
+  }
+  if (top == count - 1) {
+    return;
+  }
+
+  /* the forward solution on the overlap lo..top + 1 */
+  const int lo = std::max(top - 1, 0);
+  double forward[3];
+  std::copy(f + lo, f + top + 2, forward);
+
+  f[count - 1] = 1;
+  for (int n = count - 1; n > lo; --n) {
+    real x, y, z;
+    coefficients(n, x, y, z);
+    f[n - 1] = static_cast<double>(-(y * f[n] + (n < count - 1 ? x * f[n + 1] : 0)) / z);
+    if (std::fabs(f[n - 1]) > huge) {
+      std::for_each(f + n - 1, f + count, [](double &v) { v *= static_cast<double>(tiny); });
+    }
+  }
+
+  real fg = 0, gg = 0;
+  for (int n = lo; n <= top + 1; ++n) {
+    fg += real(forward[n - lo]) * f[n];
+    gg += real(f[n]) * f[n];
+  }
+  const real scale = fg / gg;
+  std::for_each(f + top + 1, f + count, [scale](double &v) { v = static_cast<double>(scale * v); });
+  std::copy(forward, forward + (top + 1 - lo), f + lo);
+}
+
+/* scales the family to sum_n weight(n) f(n)^2 = 1, with the sign of the last symbol (-1)^(two_phase / 2) */
+template <typename Weight>
+void normalize(int count, Weight &&weight, int two_phase, double *f) noexcept {
+  real largest = 0;
+  for (int n = 0; n < count; ++n) {
+    largest = std::max(largest, real(std::fabs(f[n])));
+  }
+  real sum = 0;
+  for (int n = 0; n < count; ++n) {
+    const real v = f[n] / largest;
+    sum += weight(n) * v * v;
+  }
+  real scale = 1 / (largest * std::sqrt(sum));
+  if ((f[count - 1] < 0) != ((two_phase / 2) % 2 != 0)) {
+    scale = -scale;
+  }
+  std::for_each(f, f + count, [scale](double &v) { v = static_cast<double>(scale * v); });
+}
+
+/* j(j + 1) */
+real casimir(real j) noexcept { return j * (j + 1); }
+
+bool valid(int two_j, int two_m) noexcept { return two_j >= 0 && std::abs(two_m) <= two_j && (two_j + two_m) % 2 == 0; }
+
+bool triangle(int two_a, int two_b, int two_c) noexcept {
+  return two_a >= 0 && two_b >= 0 && two_c >= 0 && std::abs(two_a - two_b) <= two_c && two_c <= two_a + two_b &&
+         (two_a + two_b + two_c) % 2 == 0;
+}
+
+} // namespace
+
+int family_3j_j(int two_j2, int two_j3, int two_m2, int two_m3, int &two_min, double *results) noexcept {
+  const int two_m1 = -two_m2 - two_m3;
+  two_min = std::max(std::abs(two_j2 - two_j3), std::abs(two_m1));
+  const int two_max = two_j2 + two_j3;
+  if (!valid(two_j2, two_m2) || !valid(two_j3, two_m3) || two_min > two_max) {
+    return 0;
+  }
+  const int count = (two_max - two_min) / 2 + 1;
+  if (!results) {
+    return count;
+  }
+
+  const real j2 = real(two_j2) / 2, j3 = real(two_j3) / 2;
+  const real m1 = real(two_m1) / 2, m2 = real(two_m2) / 2, m3 = real(two_m3) / 2;
+  const auto a = [&](real j) {
+    return std::sqrt((j * j - (j2 - j3) * (j2 - j3)) * ((j2 + j3 + 1) * (j2 + j3 + 1) - j * j) * (j * j - m1 * m1));
+  };
+  const int first = two_min;
+  solve(
+      count,
+      [&](int n, real &x, real &y, real &z) {
+        const real j = real(first + 2 * n) / 2;
+        if (j == 0) {
+          /* the row divided by j */
+          x = a(1);
+          y = m3 - m2;
+          z = 0;
+          return;
+        }
+        x = j * a(j + 1);
+        y = -(2 * j + 1) * ((casimir(j2) - casimir(j3)) * m1 - casimir(j) * (m3 - m2));
+        z = (j + 1) * a(j);
+      },
+      results);
+  /* (j2 + j3 j2 j3; m1 m2 m3) has the sign (-1)^(j2 - j3 - m1) */
+  normalize(count, [&](int n) { return real(first + 2 * n + 1); }, two_j2 - two_j3 - two_m1, results);
+  return count;
+}
+
+int family_3j_m(int two_j1, int two_j2, int two_j3, int two_m1, int &two_min, double *results) noexcept {
+  two_min = std::max(-two_j2, -two_j3 - two_m1);
+  const int two_max = std::min(two_j2, two_j3 - two_m1);
+  if (!valid(two_j1, two_m1) || !triangle(two_j1, two_j2, two_j3) || two_min > two_max) {
+    return 0;
+  }
+  const int count = (two_max - two_min) / 2 + 1;
+  if (!results) {
+    return count;
+  }
+
+  const real j1 = real(two_j1) / 2, j2 = real(two_j2) / 2, j3 = real(two_j3) / 2, m1 = real(two_m1) / 2;
+  const auto c = [&](real m2) {
+    const real m3 = -m1 - m2;
+    return std::sqrt((j2 - m2 + 1) * (j2 + m2) * (j3 + m3 + 1) * (j3 - m3));
+  };
+  const int first = two_min;
+  solve(
+      count,
+      [&](int n, real &x, real &y, real &z) {
+        const real m2 = real(first + 2 * n) / 2;
+        x = c(m2 + 1);
+        y = casimir(j2) + casimir(j3) - casimir(j1) + 2 * m2 * (-m1 - m2);
+        z = c(m2);
+      },
+      results);
+  /* sum_m2 (2 j1 + 1) (j1 j2 j3; m1 m2 m3)^2 = 1, the symbol at the largest m2 has the sign (-1)^(j2 - j3 - m1) */
+  normalize(count, [&](int) { return real(two_j1 + 1); }, two_j2 - two_j3 - two_m1, results);
+  return count;
+}
+
+int family_6j(int two_j2, int two_j3, int two_j4, int two_j5, int two_j6, int &two_min, double *results) noexcept {
+  two_min = std::max(std::abs(two_j2 - two_j3), std::abs(two_j5 - two_j6));
+  const int two_max = std::min(two_j2 + two_j3, two_j5 + two_j6);
+  if (!triangle(two_j4, two_j2, two_j6) || !triangle(two_j4, two_j5, two_j3) || (two_j2 + two_j3 + two_j5 + two_j6) % 2 ||
+      two_min > two_max) {
+    return 0;
+  }
+  const int count = (two_max - two_min) / 2 + 1;
+  if (!results) {
+    return count;
+  }
+
+  const real j2 = real(two_j2) / 2, j3 = real(two_j3) / 2, l1 = real(two_j4) / 2, l2 = real(two_j5) / 2,
+             l3 = real(two_j6) / 2;
+  const auto e = [&](real j) {
+    return std::sqrt((j * j - (j2 - j3) * (j2 - j3)) * ((j2 + j3 + 1) * (j2 + j3 + 1) - j * j) *
+                     (j * j - (l2 - l3) * (l2 - l3)) * ((l2 + l3 + 1) * (l2 + l3 + 1) - j * j));
+  };
+  const int first = two_min;
+  solve(
+      count,
+      [&](int n, real &x, real &y, real &z) {
+        const real j = real(first + 2 * n) / 2;
+        if (j == 0) {
+          /* the row divided by j */
+          x = e(1);
+          y = 2 * (casimir(j2) + casimir(l2) - casimir(l1));
+          z = 0;
+          return;
+        }
+        const real jj = casimir(j);
+        x = j * e(j + 1);
+        y = (2 * j + 1) * (jj * (-jj + casimir(j2) + casimir(j3) - 2 * casimir(l1)) +
+                           casimir(l2) * (jj + casimir(j2) - casimir(j3)) + casimir(l3) * (jj - casimir(j2) + casimir(j3)));
+        z = (j + 1) * e(j);
+      },
+      results);
+  /* sum_j1 (2 j1 + 1) (2 j4 + 1) {j1 j2 j3; j4 j5 j6}^2 = 1, the stretched symbol has the sign (-1)^(j2 + j3 + j5 + j6) */
+  normalize(count, [&](int n) { return real(first + 2 * n + 1) * (two_j4 + 1); }, two_j2 + two_j3 + two_j5 + two_j6,
+            results);
+  return count;
+}
+
+} // namespace wigcpp::internal::recurrence
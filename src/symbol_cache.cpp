@@ -0,0 +1,238 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "internal/symbol_cache.hpp"
+#include "internal/calc.hpp"
+#include "internal/error.hpp"
+#include "internal/nothrow_allocator.hpp"
+#include "internal/symmetry.hpp"
+#include <bit>
+#include <cstdio>
+#include <memory>
+
+namespace wigcpp::internal::cache {
+
+namespace {
+constexpr std::uint64_t tag_3j = std::uint64_t{1} << 62;
+constexpr std::uint64_t tag_6j = std::uint64_t{2} << 62;
+constexpr std::uint64_t tag_9j = std::uint64_t{3} << 62;
+
+/* field widths of the packed keys, symbols with larger entries bypass the cache */
+constexpr int bits_3j = 12;
+constexpr int bits_6j = 10;
+constexpr int bits_9j = 14;
+
+template <std::size_t N> bool pack(const std::array<int, N> &v, int bits, CacheKey &key) noexcept {
+  key.lo = 0;
+  key.hi = 0;
+  int pos = 0;
+  for (const int x : v) {
+    if (x < 0 || x >= (1 << bits)) {
+      return false;
+    }
+    const auto ux = static_cast<std::uint64_t>(x);
+    if (pos < 64) {
+      key.lo |= ux << pos;
+      if (pos + bits > 64) {
+        key.hi |= ux >> (64 - pos);
+      }
+    } else {
+      key.hi |= ux << (pos - 64);
+    }
+    pos += bits;
+  }
+  return true;
+}
+
+std::uint64_t mix(std::uint64_t x) noexcept {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ull;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebull;
+  x ^= x >> 31;
+  return x;
+}
+} // namespace
+
+SymbolCache::SymbolCache(std::size_t max_bytes) noexcept : shards(nullptr), num_shards(shards_for(max_bytes)) {
+
+  allocator::nothrow_allocator<Shard, 64> alloc;
+  shards = alloc.allocate(num_shards);
+  if (!shards) [[unlikely]] {
+    std::fprintf(stderr, "error in SymbolCache: allocation of %zu bytes failed.\n", num_shards * sizeof(Shard));
+    error::error_process(error::ErrorCode::Bad_Alloc);
+  }
+  std::uninitialized_value_construct_n(shards, num_shards);
+}
+
+SymbolCache::~SymbolCache() noexcept {
+  std::destroy_n(shards, num_shards);
+  allocator::nothrow_allocator<Shard, 64> alloc;
+  alloc.deallocate(shards, num_shards);
+}
+
+SymbolCache::Shard &SymbolCache::shard_of(const CacheKey &key) noexcept {
+  return shards[mix(key.lo ^ mix(key.hi)) & (num_shards - 1)];
+}
+
+bool SymbolCache::find(const CacheKey &key, double &value) noexcept {
+  Shard &shard = shard_of(key);
+  for (auto &slot : shard.slots) {
+    const std::uint64_t seq = slot.seq.load(std::memory_order_acquire);
+    if (seq & 1) {
+      continue;
+    }
+    if (slot.key_lo.load(std::memory_order_relaxed) != key.lo || slot.key_hi.load(std::memory_order_relaxed) != key.hi) {
+      continue;
+    }
+    const std::uint64_t bits = slot.value.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != seq) {
+      continue;
+    }
+    if (!slot.referenced.load(std::memory_order_relaxed)) {
+      slot.referenced.store(1, std::memory_order_relaxed);
+    }
+    value = std::bit_cast<double>(bits);
+    return true;
+  }
+  return false;
+}
+
+void SymbolCache::insert(const CacheKey &key, double value) noexcept {
+  Shard &shard = shard_of(key);
+
+  Slot *victim = nullptr;
+  for (auto &slot : shard.slots) {
+    if (slot.key_hi.load(std::memory_order_relaxed) == 0) {
+      victim = &slot;
+      break;
+    }
+  }
+
+  /* CLOCK: clear reference bits under the hand until an unreferenced slot shows up */
+  for (std::uint32_t step = 0; !victim && step < 2 * ways; ++step) {
+    Slot &slot = shard.slots[shard.hand.fetch_add(1, std::memory_order_relaxed) % ways];
+    if (!slot.referenced.exchange(0, std::memory_order_relaxed)) {
+      victim = &slot;
+    }
+  }
+  if (!victim) [[unlikely]] {
+    return;
+  }
+
+  std::uint64_t seq = victim->seq.load(std::memory_order_relaxed);
+  if ((seq & 1) || !victim->seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) {
+    return;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+
+  victim->key_lo.store(key.lo, std::memory_order_relaxed);
+  victim->key_hi.store(key.hi, std::memory_order_relaxed);
+  victim->value.store(std::bit_cast<std::uint64_t>(value), std::memory_order_relaxed);
+  victim->referenced.store(1, std::memory_order_relaxed);
+
+  victim->seq.store(seq + 2, std::memory_order_release);
+}
+
+double SymbolCache::calc_3j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3,
+                            int two_m1, int two_m2, int two_m3) noexcept {
+  if (calc::TrivialZero::is_zero_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3)) {
+    return 0;
+  }
+  auto &stats = CacheManager::thread_stats();
+  const auto canon = symmetry::canonicalize_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3);
+
+  CacheKey key;
+  const bool cacheable = pack(canon.chain, bits_3j, key);
+  key.hi |= tag_3j;
+
+  double value;
+  if (cacheable && find(key, value)) {
+    ++stats.hits;
+    return canon.sign * value;
+  }
+  ++stats.misses;
+
+  const auto a = symmetry::representative_3j(canon);
+  value = static_cast<double>(calc::Calculator::calc_3j(pool, csi, a[0], a[1], a[2], a[3], a[4], a[5]));
+  if (cacheable) {
+    insert(key, value);
+  }
+  return canon.sign * value;
+}
+
+double SymbolCache::calc_6j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3,
+                            int two_j4, int two_j5, int two_j6) noexcept {
+  if (calc::TrivialZero::is_zero_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6)) {
+    return 0;
+  }
+  auto &stats = CacheManager::thread_stats();
+  const auto canon = symmetry::canonicalize_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
+
+  CacheKey key;
+  const bool cacheable = pack(canon.chain, bits_6j, key);
+  key.hi |= tag_6j;
+
+  double value;
+  if (cacheable && find(key, value)) {
+    ++stats.hits;
+    return value;
+  }
+  ++stats.misses;
+
+  const auto a = symmetry::representative_6j(canon);
+  value = static_cast<double>(calc::Calculator::calc_6j(pool, csi, a[0], a[1], a[2], a[3], a[4], a[5]));
+  if (cacheable) {
+    insert(key, value);
+  }
+  return value;
+}
+
+double SymbolCache::calc_9j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3,
+                            int two_j4, int two_j5, int two_j6, int two_j7, int two_j8, int two_j9) noexcept {
+  if (calc::TrivialZero::is_zero_9j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9)) {
+    return 0;
+  }
+  auto &stats = CacheManager::thread_stats();
+  const auto canon = symmetry::canonicalize_9j({two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9});
+
+  CacheKey key;
+  const bool cacheable = pack(canon.two_j, bits_9j, key);
+  key.hi |= tag_9j;
+
+  double value;
+  if (cacheable && find(key, value)) {
+    ++stats.hits;
+    return canon.sign * value;
+  }
+  ++stats.misses;
+
+  const auto &a = canon.two_j;
+  value = static_cast<double>(
+      calc::Calculator::calc_9j(pool, csi, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8]));
+  if (cacheable) {
+    insert(key, value);
+  }
+  return canon.sign * value;
+}
+
+void CacheManager::enable(std::size_t max_bytes) noexcept {
+  if (max_bytes < SymbolCache::bytes_per_shard()) {
+    ptr.reset();
+    return;
+  }
+  ptr = std::make_unique<SymbolCache>(max_bytes);
+}
+
+void CacheManager::disable() noexcept {
+  ptr.reset();
+}
+
+} // namespace wigcpp::internal::cache
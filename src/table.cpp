@@ -0,0 +1,249 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "internal/table.hpp"
+#include "internal/calc.hpp"
+#include "internal/error.hpp"
+#include "internal/tmp_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace wigcpp::internal::table {
+
+namespace {
+using tmp::TempStorage;
+
+/* consecutive ranks handed to a thread at once */
+constexpr std::uint64_t chunk_size = 1024;
+
+/* the largest Regge entry of a symbol is at most its largest two_j */
+std::uint64_t chain_count(std::size_t length, int max_two_j) noexcept {
+  if (length == 5) {
+    return chains_3j_below(static_cast<std::uint64_t>(max_two_j) + 1);
+  }
+  return binomial(static_cast<std::uint64_t>(max_two_j) + length, length);
+}
+
+/* The largest two_j of the member of the class of a 3j symbol whose largest two_j is the smallest. The two_j of a
+ * member are J - r over a row or a column r of the Regge square, whose lines all sum to J. */
+int class_two_j_3j(const std::array<int, 6> &a) noexcept {
+  const int J = (a[0] + a[1] + a[2]) / 2;
+  int r[3][3];
+  for (int i = 0; i < 3; ++i) {
+    r[0][i] = J - a[i];
+    r[1][i] = (a[i] - a[i + 3]) / 2;
+    r[2][i] = (a[i] + a[i + 3]) / 2;
+  }
+  int line_min = 0;
+  for (int k = 0; k < 3; ++k) {
+    line_min = std::max({line_min, std::min({r[k][0], r[k][1], r[k][2]}), std::min({r[0][k], r[1][k], r[2][k]})});
+  }
+  return J - line_min;
+}
+
+/* The same for a 6j symbol. The two_j of a member are alpha_i + alpha_l - beta over the pairs {i, l} of triads, the two
+ * pairs of disjoint triads sharing their beta, and the Regge symmetries assign the betas to these couples of pairs. */
+int class_two_j_6j(const std::array<int, 6> &a) noexcept {
+  const int alpha[4] = {(a[0] + a[1] + a[2]) / 2, (a[0] + a[4] + a[5]) / 2, (a[3] + a[1] + a[5]) / 2,
+                        (a[3] + a[4] + a[2]) / 2};
+  int beta[3] = {(a[0] + a[1] + a[3] + a[4]) / 2, (a[1] + a[2] + a[4] + a[5]) / 2, (a[2] + a[0] + a[5] + a[3]) / 2};
+  const int couples[3] = {std::max(alpha[0] + alpha[1], alpha[2] + alpha[3]),
+                          std::max(alpha[0] + alpha[2], alpha[1] + alpha[3]),
+                          std::max(alpha[0] + alpha[3], alpha[1] + alpha[2])};
+  std::sort(beta, beta + 3);
+  int smallest = couples[0] + couples[1] + couples[2];
+  do {
+    smallest = std::min(smallest, std::max({couples[0] - beta[0], couples[1] - beta[1], couples[2] - beta[2]}));
+  } while (std::next_permutation(beta, beta + 3));
+  return smallest;
+}
+
+void beyond_pool() noexcept {
+  std::fprintf(stderr, "error in fill_table: a symbol of the table needs factorials beyond the factorial pool.\n");
+  error::error_process(error::ErrorCode::TOO_LARGE_FACTORIAL);
+}
+
+/* chains of classes without a symbol of two_j <= max_two_j are outside the table range and left zero */
+double eval_3j(const GlobalFactorialPool &pool, TempStorage &csi, int max_two_j,
+               const std::array<int, 5> &chain) noexcept {
+  const auto a = symmetry::representative_3j({chain, 1});
+  if (class_two_j_3j(a) > max_two_j) {
+    return 0;
+  }
+  const std::uint32_t max_factorial = (a[0] + a[1] + a[2]) / 2 + 1;
+  if (max_factorial > pool.prime_table.max_factorial) [[unlikely]] {
+    beyond_pool();
+  }
+  return static_cast<double>(calc::Calculator::calc_3j(pool, csi, a[0], a[1], a[2], a[3], a[4], a[5]));
+}
+
+double eval_6j(const GlobalFactorialPool &pool, TempStorage &csi, int max_two_j,
+               const std::array<int, 6> &chain) noexcept {
+  const auto a = symmetry::representative_6j({chain});
+  if (class_two_j_6j(a) > max_two_j) {
+    return 0;
+  }
+  const int beta1 = (a[0] + a[1] + a[3] + a[4]) / 2;
+  const int beta2 = (a[1] + a[2] + a[4] + a[5]) / 2;
+  const int beta3 = (a[2] + a[0] + a[5] + a[3]) / 2;
+  const std::uint32_t max_factorial = std::max({std::min({beta1, beta2, beta3}) + 1, beta1, beta2, beta3});
+  if (max_factorial > pool.prime_table.max_factorial) [[unlikely]] {
+    beyond_pool();
+  }
+  return static_cast<double>(calc::Calculator::calc_6j(pool, csi, a[0], a[1], a[2], a[3], a[4], a[5]));
+}
+
+/* hands out chunks of [0, total) to num_threads threads, each owning its scratch storage */
+template <typename Fn>
+void run_chunks(const GlobalFactorialPool &pool, std::uint64_t total, int num_threads, Fn fn) noexcept {
+  if (num_threads <= 0) {
+    num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  }
+  const auto max_chunks = static_cast<int>(std::min<std::uint64_t>((total + chunk_size - 1) / chunk_size, 1 << 16));
+  num_threads = std::max(1, std::min(num_threads, max_chunks));
+
+  std::atomic<std::uint64_t> cursor{0};
+  auto worker = [&] {
+    TempStorage csi(pool.stride());
+    std::uint64_t begin;
+    while ((begin = cursor.fetch_add(chunk_size, std::memory_order_relaxed)) < total) {
+      fn(csi, begin, std::min(begin + chunk_size, total));
+    }
+  };
+
+  /* the chunks of threads that fail to start are taken by the others */
+  std::vector<std::thread> threads;
+  try {
+    threads.reserve(num_threads - 1);
+    for (int i = 1; i < num_threads; ++i) {
+      threads.emplace_back(worker);
+    }
+  } catch (...) {
+  }
+  worker();
+  for (auto &t : threads) {
+    t.join();
+  }
+}
+
+/* the largest factorial of symbols with two_j <= max_two_j, J + 1 for 3j and the largest beta + 1 for 6j */
+void check_pool(const GlobalFactorialPool &pool, int wigner_type, int max_two_j) noexcept {
+  const auto max_factorial = static_cast<std::uint32_t>(wigner_type == 3 ? 3 * max_two_j / 2 + 1 : 2 * max_two_j + 1);
+  if (max_factorial > pool.prime_table.max_factorial) [[unlikely]] {
+    std::fprintf(stderr, "error in fill_table: max_two_j %d is beyond the range of the factorial pool.\n", max_two_j);
+    error::error_process(error::ErrorCode::BAD_MAX_TWO_J);
+  }
+}
+
+bool is_canonical_9j(const std::array<int, 9> &two_j) noexcept {
+  return symmetry::canonicalize_9j(two_j).two_j == two_j;
+}
+} // namespace
+
+void ensure_pool(int wigner_type, int max_two_j) noexcept {
+  global::PoolManager::ensure(max_two_j + (max_two_j & 1), wigner_type);
+}
+
+std::uint64_t table_size(int wigner_type, int max_two_j) noexcept {
+  if (wigner_type != 3 && wigner_type != 6) [[unlikely]] {
+    std::fprintf(stderr, "error in table_size: tables are only available for 3j and 6j symbols.\n");
+    error::error_process(error::ErrorCode::BAD_WIGNER_TYPE);
+  }
+  return max_two_j < 0 ? 0 : chain_count(chain_length(wigner_type), max_two_j);
+}
+
+void fill_table(const GlobalFactorialPool &pool, int wigner_type, int max_two_j, double *table,
+                int num_threads) noexcept {
+  fill_table_range(pool, wigner_type, max_two_j, table, 0, table_size(wigner_type, max_two_j), num_threads);
+}
+
+void fill_table_range(const GlobalFactorialPool &pool, int wigner_type, int max_two_j, double *dest,
+                      std::uint64_t begin, std::uint64_t end, int num_threads) noexcept {
+  table_size(wigner_type, max_two_j);
+  check_pool(pool, wigner_type, max_two_j);
+
+  run_chunks(pool, end - begin, num_threads, [&](TempStorage &csi, std::uint64_t first, std::uint64_t last) {
+    if (wigner_type == 3) {
+      auto chain = unrank_3j(begin + first);
+      for (std::uint64_t r = first; r < last; ++r, next_3j(chain)) {
+        dest[r] = eval_3j(pool, csi, max_two_j, chain);
+      }
+    } else {
+      auto chain = unrank<6>(begin + first);
+      for (std::uint64_t r = first; r < last; ++r, next(chain)) {
+        dest[r] = eval_6j(pool, csi, max_two_j, chain);
+      }
+    }
+  });
+}
+
+container::vector<Slot9j> layout_9j(int max_two_j) noexcept {
+  if (max_two_j > max_two_j_9j) [[unlikely]] {
+    std::fprintf(stderr, "error in layout_9j: max_two_j of a 9j table can't exceed %d.\n", max_two_j_9j);
+    error::error_process(error::ErrorCode::BAD_MAX_TWO_J);
+  }
+
+  /* the smallest entry can be moved to the top left corner, so it is enough to enumerate matrices with a minimal j1 */
+  auto from = [](int lo, int min) { return lo >= min ? lo : lo + (min - lo + 1) / 2 * 2; };
+
+  container::vector<std::uint64_t> keys;
+  std::array<int, 9> m{};
+  auto &[a, b, c, d, e, f, g, h, i] = m;
+  for (a = 0; a <= max_two_j; ++a)
+    for (b = a; b <= max_two_j; ++b)
+      for (c = from(b - a, a); c <= std::min(a + b, max_two_j); c += 2)
+        for (d = a; d <= max_two_j; ++d)
+          for (e = a; e <= max_two_j; ++e)
+            for (f = from(std::abs(d - e), a); f <= std::min(d + e, max_two_j); f += 2)
+              for (g = from(d - a, a); g <= std::min(a + d, max_two_j); g += 2)
+                for (h = from(std::abs(b - e), a); h <= std::min(b + e, max_two_j); h += 2)
+                  for (i = from(std::max(std::abs(c - f), std::abs(g - h)), a); i <= std::min({c + f, g + h, max_two_j});
+                       i += 2) {
+                    if (calc::TrivialZero::is_zero_9j(a, b, c, d, e, f, g, h, i) || !is_canonical_9j(m)) {
+                      continue;
+                    }
+                    std::uint64_t key;
+                    pack_9j(m, key);
+                    keys.push_back(key);
+                  }
+
+  const std::uint64_t capacity = std::bit_ceil(std::max<std::uint64_t>(2 * keys.size(), 2));
+  container::vector<Slot9j> slots(capacity);
+  for (const auto key : keys) {
+    std::uint64_t pos = slot_hash(key) & (capacity - 1);
+    while (slots[pos].key) {
+      pos = (pos + 1) & (capacity - 1);
+    }
+    slots[pos].key = key;
+  }
+  return slots;
+}
+
+void fill_slots_9j(const GlobalFactorialPool &pool, int max_two_j, Slot9j *slots, std::uint64_t begin,
+                   std::uint64_t end, int num_threads) noexcept {
+  check_pool(pool, 9, max_two_j);
+
+  run_chunks(pool, end - begin, num_threads, [&](TempStorage &csi, std::uint64_t first, std::uint64_t last) {
+    for (std::uint64_t r = begin + first; r < begin + last; ++r) {
+      if (!slots[r].key) {
+        continue;
+      }
+      const auto m = unpack_9j(slots[r].key);
+      slots[r].value =
+          static_cast<double>(calc::Calculator::calc_9j(pool, csi, m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8]));
+    }
+  });
+}
+
+} // namespace wigcpp::internal::table
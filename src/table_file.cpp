@@ -0,0 +1,392 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "internal/table_file.hpp"
+#include "internal/error.hpp"
+#include "internal/symmetry.hpp"
+#include "internal/vector.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace wigcpp::internal::table {
+
+namespace {
+constexpr std::uint64_t default_shard_entries = std::uint64_t{1} << 20;
+
+int seek(std::FILE *fp, std::uint64_t offset) noexcept {
+#ifdef _WIN32
+  return _fseeki64(fp, static_cast<__int64>(offset), SEEK_SET);
+#else
+  return fseeko(fp, static_cast<off_t>(offset), SEEK_SET);
+#endif
+}
+
+bool write_at(std::FILE *fp, std::uint64_t offset, const void *data, std::size_t bytes) noexcept {
+  return seek(fp, offset) == 0 && std::fwrite(data, 1, bytes, fp) == bytes && std::fflush(fp) == 0;
+}
+
+bool read_at(std::FILE *fp, std::uint64_t offset, void *data, std::size_t bytes) noexcept {
+  return seek(fp, offset) == 0 && std::fread(data, 1, bytes, fp) == bytes;
+}
+
+FileHeader make_header(int wigner_type, int max_two_j, std::uint64_t entries) noexcept {
+  FileHeader header{};
+  std::memcpy(header.magic, file_magic, sizeof(file_magic));
+  header.version = file_version;
+  header.wigner_type = static_cast<std::uint32_t>(wigner_type);
+  header.max_two_j = max_two_j;
+  header.byte_order = file_byte_order;
+  header.entries = entries;
+  return header;
+}
+
+bool same_header(const FileHeader &a, const FileHeader &b) noexcept {
+  return std::memcmp(&a, &b, sizeof(FileHeader)) == 0;
+}
+} // namespace
+
+std::uint64_t checksum(std::uint64_t state, const std::uint64_t *words, std::size_t count) noexcept {
+  for (std::size_t i = 0; i < count; ++i) {
+    state = slot_hash(state ^ words[i]) + 0x9e3779b97f4a7c15ull;
+  }
+  return state;
+}
+
+std::uint64_t header_checksum(const FileHeader &header) noexcept {
+  std::uint64_t words[offsetof(FileHeader, header_checksum) / sizeof(std::uint64_t)];
+  std::memcpy(words, &header, sizeof(words));
+  return checksum(0, words, sizeof(words) / sizeof(std::uint64_t));
+}
+
+bool write_table_file(const GlobalFactorialPool &pool, int wigner_type, int max_two_j, const char *path,
+                      int num_threads, std::uint64_t shard_entries, progress_fn progress) noexcept {
+  if (wigner_type != 3 && wigner_type != 6 && wigner_type != 9) [[unlikely]] {
+    std::fprintf(stderr, "error in write_table_file: \n");
+    error::error_process(error::ErrorCode::BAD_WIGNER_TYPE);
+  }
+  if (!shard_entries) {
+    shard_entries = default_shard_entries;
+  }
+
+  container::vector<Slot9j> layout;
+  if (wigner_type == 9) {
+    layout = layout_9j(max_two_j);
+  }
+  const std::uint64_t entries = wigner_type == 9 ? layout.size() : table_size(wigner_type, max_two_j);
+  const std::uint64_t eb = entry_bytes(wigner_type);
+  const std::uint64_t shards = (entries + shard_entries - 1) / shard_entries;
+
+  const std::string partial_path = std::string(path) + ".partial";
+  const std::string progress_path = std::string(path) + ".progress";
+
+  /* the progress file starts with the header of the table, its payload checksum field holding the shard size */
+  FileHeader expected = make_header(wigner_type, max_two_j, entries);
+  expected.payload_checksum = shard_entries;
+  expected.header_checksum = header_checksum(expected);
+
+  container::vector<unsigned char> done(std::max<std::uint64_t>(shards, 1));
+  std::FILE *part = std::fopen(partial_path.c_str(), "r+b");
+  std::FILE *prog = std::fopen(progress_path.c_str(), "r+b");
+
+  bool resume = false;
+  if (part && prog) {
+    FileHeader found;
+    resume = read_at(prog, 0, &found, sizeof(found)) && same_header(found, expected) &&
+             (shards == 0 || read_at(prog, sizeof(FileHeader), done.data(), shards));
+  }
+
+  auto fail = [&](const char *what) {
+    std::fprintf(stderr, "error in write_table_file: %s failed.\n", what);
+    if (part) {
+      std::fclose(part);
+    }
+    if (prog) {
+      std::fclose(prog);
+    }
+    return false;
+  };
+
+  if (!resume) {
+    if (part) {
+      std::fclose(part);
+    }
+    if (prog) {
+      std::fclose(prog);
+    }
+    std::fill(done.begin(), done.end(), 0);
+    part = std::fopen(partial_path.c_str(), "w+b");
+    prog = std::fopen(progress_path.c_str(), "w+b");
+    if (!part || !prog) {
+      return fail("creating the partial files");
+    }
+
+    /* the header stays zero until the payload is complete, so a partial file is never mistaken for a table */
+    const unsigned char zero = 0;
+    if (!write_at(part, payload_offset + entries * eb - 1, &zero, 1) || !write_at(prog, 0, &expected, sizeof(expected)) ||
+        (shards && !write_at(prog, sizeof(FileHeader), done.data(), shards))) {
+      return fail("writing the partial files");
+    }
+  }
+
+  std::uint64_t finished = 0;
+  for (std::uint64_t s = 0; s < shards; ++s) {
+    if (done[s]) {
+      finished += std::min(shard_entries, entries - s * shard_entries);
+    }
+  }
+  if (progress) {
+    progress(finished, entries);
+  }
+
+  container::vector<double> buffer(wigner_type == 9 ? 1 : std::min(shard_entries, entries));
+  for (std::uint64_t s = 0; s < shards; ++s) {
+    if (done[s]) {
+      continue;
+    }
+    const std::uint64_t begin = s * shard_entries;
+    const std::uint64_t end = std::min(begin + shard_entries, entries);
+
+    const void *data;
+    if (wigner_type == 9) {
+      fill_slots_9j(pool, max_two_j, layout.data(), begin, end, num_threads);
+      data = layout.data() + begin;
+    } else {
+      fill_table_range(pool, wigner_type, max_two_j, buffer.data(), begin, end, num_threads);
+      data = buffer.data();
+    }
+
+    const unsigned char one = 1;
+    if (!write_at(part, payload_offset + begin * eb, data, (end - begin) * eb) ||
+        !write_at(prog, sizeof(FileHeader) + s, &one, 1)) {
+      return fail("writing a shard");
+    }
+    done[s] = 1;
+
+    finished += end - begin;
+    if (progress) {
+      progress(finished, entries);
+    }
+  }
+
+  /* checksum the payload as it is on disk, shards of an earlier run included */
+  container::vector<std::uint64_t> block(std::size_t{1} << 16);
+  const std::uint64_t total_words = entries * eb / sizeof(std::uint64_t);
+  std::uint64_t state = 0;
+  if (seek(part, payload_offset) != 0) {
+    return fail("seeking the partial file");
+  }
+  for (std::uint64_t w = 0; w < total_words; w += block.size()) {
+    const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(block.size(), total_words - w));
+    if (std::fread(block.data(), sizeof(std::uint64_t), n, part) != n) {
+      return fail("reading back the partial file");
+    }
+    state = checksum(state, block.data(), n);
+  }
+
+  FileHeader header = make_header(wigner_type, max_two_j, entries);
+  header.payload_checksum = state;
+  header.header_checksum = header_checksum(header);
+  if (!write_at(part, 0, &header, sizeof(header))) {
+    return fail("writing the header");
+  }
+
+  std::fclose(part);
+  std::fclose(prog);
+  part = prog = nullptr;
+
+  std::remove(path);
+  if (std::rename(partial_path.c_str(), path) != 0) {
+    return fail("renaming the partial file");
+  }
+  std::remove(progress_path.c_str());
+  return true;
+}
+
+TableFile::TableFile() noexcept
+    : base(nullptr), bytes(0),
+#ifdef _WIN32
+      file_handle(nullptr), mapping_handle(nullptr),
+#endif
+      header(nullptr) {
+}
+
+TableFile::~TableFile() noexcept {
+  close();
+}
+
+bool TableFile::open(const char *path, bool verify) noexcept {
+  close();
+
+  auto fail = [&](const char *reason) {
+    std::fprintf(stderr, "error in TableFile::open: %s: %s.\n", path, reason);
+    close();
+    return false;
+  };
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return fail("can't open the file");
+  }
+  file_handle = file;
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || static_cast<std::uint64_t>(size.QuadPart) < payload_offset) {
+    return fail("file is truncated");
+  }
+  mapping_handle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping_handle) {
+    return fail("can't map the file");
+  }
+  base = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+  if (!base) {
+    return fail("can't map the file");
+  }
+  bytes = static_cast<std::size_t>(size.QuadPart);
+#else
+  const int fd = ::open(path, O_RDONLY);
+  if (fd < 0) {
+    return fail("can't open the file");
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<std::uint64_t>(st.st_size) < payload_offset) {
+    ::close(fd);
+    return fail("file is truncated");
+  }
+  void *addr = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    return fail("can't map the file");
+  }
+  base = addr;
+  bytes = static_cast<std::size_t>(st.st_size);
+#endif
+
+  header = static_cast<const FileHeader *>(base);
+  if (std::memcmp(header->magic, file_magic, sizeof(file_magic)) != 0) {
+    return fail("not a wigcpp table file");
+  }
+  if (header->version != file_version || header->byte_order != file_byte_order) {
+    return fail("unsupported version or byte order");
+  }
+  if (header->header_checksum != header_checksum(*header)) {
+    return fail("header checksum mismatch");
+  }
+
+  const int type = wigner_type();
+  if (type != 3 && type != 6 && type != 9) {
+    return fail("bad Wigner type");
+  }
+  if ((type == 9 && (max_two_j() > max_two_j_9j || !std::has_single_bit(header->entries))) ||
+      (type != 9 && header->entries != table_size(type, max_two_j()))) {
+    return fail("bad number of entries");
+  }
+  if (bytes < payload_offset + header->entries * entry_bytes(type)) {
+    return fail("file is truncated");
+  }
+
+  if (verify) {
+    const auto *words = reinterpret_cast<const std::uint64_t *>(static_cast<const char *>(base) + payload_offset);
+    const std::uint64_t count = header->entries * entry_bytes(type) / sizeof(std::uint64_t);
+    if (checksum(0, words, count) != header->payload_checksum) {
+      return fail("payload checksum mismatch");
+    }
+  }
+  return true;
+}
+
+void TableFile::close() noexcept {
+#ifdef _WIN32
+  if (base) {
+    UnmapViewOfFile(base);
+  }
+  if (mapping_handle) {
+    CloseHandle(mapping_handle);
+  }
+  if (file_handle) {
+    CloseHandle(file_handle);
+  }
+  file_handle = nullptr;
+  mapping_handle = nullptr;
+#else
+  if (base) {
+    munmap(base, bytes);
+  }
+#endif
+  base = nullptr;
+  bytes = 0;
+  header = nullptr;
+}
+
+void TableFile::check(int wigner_type, std::initializer_list<int> two_j) const noexcept {
+  if (!header || this->wigner_type() != wigner_type) [[unlikely]] {
+    std::fprintf(stderr, "error in TableFile: the table doesn't hold %dj symbols.\n", wigner_type);
+    error::error_process(error::ErrorCode::BAD_WIGNER_TYPE);
+  }
+  for (const int x : two_j) {
+    if (x > max_two_j()) [[unlikely]] {
+      std::fprintf(stderr, "error in TableFile: two_j = %d exceeds max_two_j = %d of the table.\n", x, max_two_j());
+      error::error_process(error::ErrorCode::OUT_OF_TABLE_RANGE);
+    }
+  }
+}
+
+double TableFile::lookup_3j(int two_j1, int two_j2, int two_j3, int two_m1, int two_m2, int two_m3) const noexcept {
+  check(3, {two_j1, two_j2, two_j3});
+  int sign;
+  const auto index = index_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3, sign);
+  return index < 0 ? 0 : sign * values()[index];
+}
+
+double TableFile::lookup_6j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6) const noexcept {
+  check(6, {two_j1, two_j2, two_j3, two_j4, two_j5, two_j6});
+  const auto index = index_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
+  return index < 0 ? 0 : values()[index];
+}
+
+double TableFile::lookup_9j(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5, int two_j6, int two_j7,
+                            int two_j8, int two_j9) const noexcept {
+  check(9, {two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9});
+  if (calc::TrivialZero::is_zero_9j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9)) {
+    return 0;
+  }
+  const auto canon = symmetry::canonicalize_9j({two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7, two_j8, two_j9});
+  std::uint64_t key;
+  pack_9j(canon.two_j, key);
+
+  const std::uint64_t mask = header->entries - 1;
+  const Slot9j *table = slots();
+  for (std::uint64_t pos = slot_hash(key) & mask; table[pos].key; pos = (pos + 1) & mask) {
+    if (table[pos].key == key) {
+      return canon.sign * table[pos].value;
+    }
+  }
+  std::fprintf(stderr, "error in TableFile::lookup_9j: symbol is missing from the table.\n");
+  error::error_process(error::ErrorCode::OUT_OF_TABLE_RANGE);
+}
+
+} // namespace wigcpp::internal::table
@@ -0,0 +1,369 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "internal/tiered.hpp"
+#include "internal/calc.hpp"
+#include "internal/prime_ops.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+
+namespace wigcpp::internal::tiered {
+
+using namespace wigcpp::internal::prime;
+
+namespace {
+using calc::Calculator;
+using calc::TrivialZero;
+
+/* hi + lo with |lo| <= ulp(hi) / 2 */
+struct dd {
+  double hi, lo;
+};
+
+dd two_sum(double a, double b) noexcept {
+  const double s = a + b;
+  const double bb = s - a;
+  return {s, (a - (s - bb)) + (b - bb)};
+}
+
+/* requires |a| >= |b| */
+dd fast_two_sum(double a, double b) noexcept {
+  const double s = a + b;
+  return {s, b - (s - a)};
+}
+
+/* Without a hardware fma, Dekker's product. The splitting must not be contracted into an fma, which compilers only
+ * do when the target has one, and then the first branch is taken. */
+dd two_prod(double a, double b) noexcept {
+#if defined(FP_FAST_FMA) || defined(__FMA__) || defined(__ARM_FEATURE_FMA)
+  const double p = a * b;
+  return {p, std::fma(a, b, -p)};
+#else
+  constexpr double split = 134217729.0; /* 2^27 + 1 */
+  const double ca = split * a, a_hi = ca - (ca - a), a_lo = a - a_hi;
+  const double cb = split * b, b_hi = cb - (cb - b), b_lo = b - b_hi;
+  const double p = a * b;
+  return {p, ((a_hi * b_hi - p) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo};
+#endif
+}
+
+dd add(dd a, dd b) noexcept {
+  dd s = two_sum(a.hi, b.hi);
+  const dd t = two_sum(a.lo, b.lo);
+  s.lo += t.hi;
+  s = fast_two_sum(s.hi, s.lo);
+  s.lo += t.lo;
+  return fast_two_sum(s.hi, s.lo);
+}
+
+dd mul(dd a, double b) noexcept {
+  dd p = two_prod(a.hi, b);
+  p.lo += a.lo * b;
+  return fast_two_sum(p.hi, p.lo);
+}
+
+dd mul(dd a, dd b) noexcept {
+  dd p = two_prod(a.hi, b.hi);
+  p.lo += a.hi * b.lo + a.lo * b.hi;
+  return fast_two_sum(p.hi, p.lo);
+}
+
+dd div(dd a, double b) noexcept {
+  const double q = a.hi / b;
+  const dd p = two_prod(q, b);
+  return fast_two_sum(q, (((a.hi - p.hi) - p.lo) + a.lo) / b);
+}
+
+dd div(dd a, dd b) noexcept {
+  const double q = a.hi / b.hi;
+  const dd p = mul(b, q);
+  const dd r = add(a, {-p.hi, -p.lo});
+  return fast_two_sum(q, r.hi / b.hi);
+}
+
+dd sqrt(dd a) noexcept {
+  const double s = std::sqrt(a.hi);
+  const dd p = two_prod(s, s);
+  return fast_two_sum(s, (((a.hi - p.hi) - p.lo) + a.lo) / (2 * s));
+}
+
+/* a product of integers as a double-double times 2^exp, the factors are gathered in a word while it stays exact */
+struct Product {
+  static constexpr std::uint64_t exact_limit = std::uint64_t{1} << 53;
+
+  dd value{1, 0};
+  int exp = 0;
+  std::uint64_t word = 1;
+  int ops = 0;
+
+  void mul(std::uint64_t f) noexcept {
+    if (word > exact_limit / f) {
+      flush();
+    }
+    word *= f;
+  }
+
+  void flush() noexcept {
+    if (word == 1) {
+      return;
+    }
+    value = tiered::mul(value, static_cast<double>(word));
+    word = 1;
+    ++ops;
+    int e;
+    value.hi = std::frexp(value.hi, &e);
+    value.lo = std::ldexp(value.lo, -e);
+    exp += e;
+  }
+};
+
+/* Relative error bounds in units of 2^-106. Every double-double operation above errs by less than 8 units, term k
+ * carries at most 2k multiplications and divisions and every partial sum errs by less than 8 units of the sum of the
+ * magnitudes, doubled to cover the rounding of the bound itself. A result is certified below 2^-60, i.e. 2^46 units. */
+constexpr double op_error = 8;
+constexpr double term_error = 32;
+constexpr double max_error = 0x1p46;
+
+/* Sets result to (-1)^sign sqrt(prod p^row) sum_k t_k, t_0 = 1 and t_{k + 1} = -t_k * nume(k) / div(k) with nume and
+ * div exact in a double, or returns false when the bound fails. The sum goes first, so that an ill-conditioned symbol
+ * is dropped before the prefactor is evaluated. */
+template <typename Ratio>
+bool evaluate(const PrimeTable &prime_table, const exp_t *row, std::uint32_t used, int sign, int num_terms,
+              Ratio ratio, double &result) noexcept {
+  dd term{1, 0}, sum{1, 0};
+  double abs_sum = 1;
+  for (int k = 0; k + 1 < num_terms; ++k) {
+    const auto [n, d] = ratio(k);
+    term = tiered::div(mul(term, -n), d);
+    if (!(std::fabs(term.hi) < 0x1p600)) {
+      return false;
+    }
+    sum = add(sum, term);
+    abs_sum += std::fabs(term.hi);
+  }
+  if (sum.hi == 0) {
+    return false;
+  }
+  const double sum_error = term_error * num_terms * (abs_sum / std::fabs(sum.hi));
+  if (!(sum_error < max_error)) {
+    return false;
+  }
+
+  Product nume, div, root;
+  for (auto i = 0u; i < used; ++i) {
+    const int e = row[i];
+    if (!e) {
+      continue;
+    }
+    const std::uint32_t p = prime_table.prime_list[i];
+    const int odd = e & 1;
+    const int half = (e - odd) / 2;
+    if (odd) {
+      root.mul(p);
+    }
+    if (p == 2) {
+      nume.exp += half;
+      continue;
+    }
+    Product &dest = half > 0 ? nume : div;
+    for (int n = std::abs(half); n > 0; --n) {
+      dest.mul(p);
+    }
+  }
+  nume.flush();
+  div.flush();
+  root.flush();
+  if (root.exp & 1) {
+    root.value = {2 * root.value.hi, 2 * root.value.lo};
+    --root.exp;
+  }
+  const int ops = nume.ops + div.ops + root.ops + 4;
+  if (!(sum_error + op_error * ops < max_error)) {
+    return false;
+  }
+  const dd prefactor = mul(tiered::div(nume.value, div.value), sqrt(root.value));
+  const int exp = nume.exp - div.exp + root.exp / 2;
+
+  const dd value = mul(prefactor, sum);
+  const double x = value.hi + value.lo;
+  if (std::ilogb(x) + exp < DBL_MIN_EXP + DBL_MANT_DIG) {
+    return false;
+  }
+  result = std::ldexp((sign & 1) ? -x : x, exp);
+  return true;
+}
+
+/* the exponents of the factorials of Delta(a b c)^2, the triangle coefficient */
+void add_delta(const GlobalFactorialPool &pool, exp_t *row, std::uint32_t &used, int two_a, int two_b,
+               int two_c) noexcept {
+  expand_add(row, used, pool[(two_a + two_b - two_c) / 2]);
+  expand_add(row, used, pool[(two_a - two_b + two_c) / 2]);
+  expand_add(row, used, pool[(-two_a + two_b + two_c) / 2]);
+  expand_sub(row, used, pool[(two_a + two_b + two_c) / 2 + 1]);
+}
+
+void add_twice(const GlobalFactorialPool &pool, exp_t *row, std::uint32_t &used, int n) noexcept {
+  expand_add(row, used, pool[n]);
+  expand_add(row, used, pool[n]);
+}
+
+void sub_twice(const GlobalFactorialPool &pool, exp_t *row, std::uint32_t &used, int n) noexcept {
+  expand_sub(row, used, pool[n]);
+  expand_sub(row, used, pool[n]);
+}
+
+/* The Racah formula of the 3j symbol, the square of the prefactor and of the first term go to the row. two_J is
+ * 0 for 3j symbols and adds 2J + 1 of the Clebsch-Gordan coefficient to the row otherwise. */
+bool racah_3j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3, int two_m1,
+              int two_m2, int two_m3, int two_J, int sign, double &result) noexcept {
+  if (std::max({two_j1, two_j2, two_j3}) > max_two_j ||
+      (two_j1 + two_j2 + two_j3) / 2 + 1 > static_cast<int>(pool.prime_table.max_factorial)) {
+    return false;
+  }
+  exp_t *row = csi.data(prefact);
+  std::uint32_t &used = csi.used(prefact);
+  reset_row(row, used);
+  add_delta(pool, row, used, two_j1, two_j2, two_j3);
+  if (two_J) {
+    expand_add(row, used, pool.prime_factor(two_J + 1));
+  }
+
+  /* the closed form of calcsum_3j_m0 */
+  if (!two_m1 && !two_m2 && !two_m3) {
+    const int g = (two_j1 + two_j2 + two_j3) / 4;
+    add_twice(pool, row, used, g);
+    for (const int two_j : {two_j1, two_j2, two_j3}) {
+      sub_twice(pool, row, used, g - two_j / 2);
+    }
+    const auto none = [](int) { return std::pair<double, double>{0, 1}; };
+    return evaluate(pool.prime_table, row, used, sign + g, 1, none, result);
+  }
+
+  for (const int n : {two_j1 - two_m1, two_j1 + two_m1, two_j2 - two_m2, two_j2 + two_m2, two_j3 - two_m3,
+                      two_j3 + two_m3}) {
+    expand_add(row, used, pool[n / 2]);
+  }
+
+  const int a1 = (two_j1 + two_j2 - two_j3) / 2, a2 = (two_j1 - two_m1) / 2, a3 = (two_j2 + two_m2) / 2;
+  const int b1 = (two_j3 - two_j2 + two_m1) / 2, b2 = (two_j3 - two_j1 - two_m2) / 2;
+  const int k_min = std::max({0, -b1, -b2});
+  const int k_max = std::min({a1, a2, a3});
+  for (const int n : {k_min, b1 + k_min, b2 + k_min, a1 - k_min, a2 - k_min, a3 - k_min}) {
+    sub_twice(pool, row, used, n);
+  }
+
+  const auto ratio = [&](int i) {
+    const double k = k_min + i;
+    return std::pair<double, double>{(a1 - k) * (a2 - k) * (a3 - k), (k + 1) * (b1 + k + 1) * (b2 + k + 1)};
+  };
+  return evaluate(pool.prime_table, row, used, sign + (two_j1 - two_j2 - two_m3) / 2 + k_min, k_max - k_min + 1,
+                  ratio, result);
+}
+} // namespace
+
+bool try_cg(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_m1, int two_m2,
+            int two_J, int two_M, double &result) noexcept {
+  if (TrivialZero::is_zero_3j(two_j1, two_j2, two_J, two_m1, two_m2, -two_M)) {
+    result = 0;
+    return true;
+  }
+  if (!two_m1 && !two_m2 && !two_M && ((two_j1 + two_j2 + two_J) / 2) & 1) {
+    result = 0;
+    return true;
+  }
+  return racah_3j(pool, csi, two_j1, two_j2, two_J, two_m1, two_m2, -two_M, two_J,
+                  (two_j1 - two_j2 + two_M) / 2, result);
+}
+
+bool try_3j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3, int two_m1,
+            int two_m2, int two_m3, double &result) noexcept {
+  if (TrivialZero::is_zero_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3)) {
+    result = 0;
+    return true;
+  }
+  if (!two_m1 && !two_m2 && !two_m3 && ((two_j1 + two_j2 + two_j3) / 2) & 1) {
+    result = 0;
+    return true;
+  }
+  return racah_3j(pool, csi, two_j1, two_j2, two_j3, two_m1, two_m2, two_m3, 0, 0, result);
+}
+
+bool try_6j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3, int two_j4,
+            int two_j5, int two_j6, double &result) noexcept {
+  if (TrivialZero::is_zero_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6)) {
+    result = 0;
+    return true;
+  }
+  const int alpha[4] = {(two_j1 + two_j2 + two_j3) / 2, (two_j1 + two_j5 + two_j6) / 2,
+                        (two_j4 + two_j2 + two_j6) / 2, (two_j4 + two_j5 + two_j3) / 2};
+  const int beta[3] = {(two_j1 + two_j2 + two_j4 + two_j5) / 2, (two_j2 + two_j3 + two_j5 + two_j6) / 2,
+                       (two_j3 + two_j1 + two_j6 + two_j4) / 2};
+  const int k_min = std::max({alpha[0], alpha[1], alpha[2], alpha[3]});
+  const int k_max = std::min({beta[0], beta[1], beta[2]});
+  if (std::max({two_j1, two_j2, two_j3, two_j4, two_j5, two_j6}) > max_two_j ||
+      std::max({k_max + 1, beta[0], beta[1], beta[2]}) > static_cast<int>(pool.prime_table.max_factorial)) {
+    return false;
+  }
+
+  exp_t *row = csi.data(prefact);
+  std::uint32_t &used = csi.used(prefact);
+  reset_row(row, used);
+  add_delta(pool, row, used, two_j1, two_j2, two_j3);
+  add_delta(pool, row, used, two_j1, two_j5, two_j6);
+  add_delta(pool, row, used, two_j4, two_j2, two_j6);
+  add_delta(pool, row, used, two_j4, two_j5, two_j3);
+  add_twice(pool, row, used, k_min + 1);
+  for (const int a : alpha) {
+    sub_twice(pool, row, used, k_min - a);
+  }
+  for (const int b : beta) {
+    sub_twice(pool, row, used, b - k_min);
+  }
+
+  const auto ratio = [&](int i) {
+    const double k = k_min + i;
+    return std::pair<double, double>{(k + 2) * (beta[0] - k) * (beta[1] - k) * (beta[2] - k),
+                                     (k + 1 - alpha[0]) * (k + 1 - alpha[1]) * (k + 1 - alpha[2]) *
+                                         (k + 1 - alpha[3])};
+  };
+  return evaluate(pool.prime_table, row, used, k_min, k_max - k_min + 1, ratio, result);
+}
+
+double calc_cg(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_m1, int two_m2,
+               int two_J, int two_M) noexcept {
+  if (double result; (two_j1 + two_j2 + two_J) / 2 + 1 > min_factorial &&
+                     try_cg(pool, csi, two_j1, two_j2, two_m1, two_m2, two_J, two_M, result)) {
+    return result;
+  }
+  return static_cast<double>(Calculator::calc_cg(pool, csi, two_j1, two_j2, two_m1, two_m2, two_J, two_M));
+}
+
+double calc_3j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3, int two_m1,
+               int two_m2, int two_m3) noexcept {
+  if (double result; (two_j1 + two_j2 + two_j3) / 2 + 1 > min_factorial &&
+                     try_3j(pool, csi, two_j1, two_j2, two_j3, two_m1, two_m2, two_m3, result)) {
+    return result;
+  }
+  return static_cast<double>(Calculator::calc_3j(pool, csi, two_j1, two_j2, two_j3, two_m1, two_m2, two_m3));
+}
+
+double calc_6j(const GlobalFactorialPool &pool, TempStorage &csi, int two_j1, int two_j2, int two_j3, int two_j4,
+               int two_j5, int two_j6) noexcept {
+  const int largest = std::max({two_j1 + two_j2 + two_j4 + two_j5, two_j2 + two_j3 + two_j5 + two_j6,
+                                two_j3 + two_j1 + two_j6 + two_j4}) / 2 + 1;
+  if (double result; largest > min_factorial &&
+                     try_6j(pool, csi, two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, result)) {
+    return result;
+  }
+  return static_cast<double>(Calculator::calc_6j(pool, csi, two_j1, two_j2, two_j3, two_j4, two_j5, two_j6));
+}
+
+} // namespace wigcpp::internal::tiered
@@ -8,17 +8,56 @@
  */
 
 #include "internal/tmp_pool.hpp"
+#include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <new>
 
 namespace wigcpp::internal::tmp {
 
-TempStorage::TempStorage(std::uint32_t max_iter, std::uint32_t aligned_length) noexcept
-    : storage(max_iter + iter_start, aligned_length), max_iter(max_iter) {
+namespace {
+/* the fewest iteration rows of a grown storage, and the alignment of their width, 64 bytes */
+constexpr std::uint32_t min_iter_rows = 16;
+constexpr std::uint32_t width_align = 64 / sizeof(exp_t);
+} // namespace
+
+TempStorage::TempStorage(std::uint32_t aligned_length) noexcept
+    : fixed_rows(iter_start, aligned_length), delta_rows(delta_slots, aligned_length) {
+  delta_keys.fill(no_delta);
+}
+
+void TempStorage::grow_iter(std::uint32_t count, std::uint32_t width, std::uint32_t limit) noexcept {
+  std::uint32_t rows = iter_rows.rows(), row_width = iter_rows.stride();
+  if (count > rows) {
+    rows = std::max(count, std::min(std::max(2 * rows, min_iter_rows), limit));
+  }
+  if (width > row_width || !row_width) {
+    const std::uint32_t aligned = std::max(width_align, (width + width_align - 1) / width_align * width_align);
+    row_width = std::max(width, std::min(stride(), std::max(aligned, 2 * row_width)));
+  }
+  iter_rows = uniform_jagged_matrix<exp_t>(rows, row_width);
+}
+
+/* the numbers of a sum hold about the bits of max_factorial!, the products of two of them twice as many */
+std::size_t TempStorage::number_bytes(std::uint32_t max_factorial) noexcept {
+  constexpr std::size_t numbers = 10, products = 2;
+  const double bits = std::lgamma(static_cast<double>(max_factorial) + 1) / std::log(2.0);
+  const auto bytes = static_cast<std::size_t>(bits / 8) + 2 * sizeof(std::uint64_t);
+  return allocator::word_arena::bytes_for(bytes, numbers - products) +
+         allocator::word_arena::bytes_for(2 * bytes, products);
 }
 
 void TempStorage::reset() noexcept {
-  std::memset(storage.row(0u), 0, storage.rows() * storage.stride() * sizeof(std::byte));
+  std::memset(fixed_rows.row(0u), 0, fixed_rows.rows() * fixed_rows.stride() * sizeof(exp_t));
+  if (iter_rows.rows()) {
+    std::memset(iter_rows.row(0u), 0, iter_rows.rows() * iter_rows.stride() * sizeof(exp_t));
+  }
+  delta_keys.fill(no_delta);
+
+  /* the numbers keep their words in the own arena, whichever arena the thread putting it back has made current */
+  const allocator::word_arena::scope own(&arena);
   sum_prod = 0;
+  sum_acc.reset(1);
   big_prod = 0;
   big_sqrt = 0;
   big_nume = 0;
@@ -30,27 +69,130 @@ void TempStorage::reset() noexcept {
   pexpo_tmp.reset();
 }
 
-void TempManager::init(int max_two_j, std::size_t stride) noexcept {
-  ptr = std::make_unique<TempStorage>(max_two_j / 2 + 1, stride);
+void TempStorage::shrink() noexcept {
+  iter_rows = uniform_jagged_matrix<exp_t>();
+
+  /* the numbers start over outside of the arena, which then holds no live block */
+  const allocator::word_arena::scope outside(nullptr);
+  sum_prod = mwi::big_int();
+  sum_acc = mwi::big_sum();
+  big_prod = mwi::big_nat();
+  big_sqrt = mwi::big_nat();
+  big_nume = mwi::big_nat();
+  big_div = mwi::big_nat();
+  big_nume_prod = mwi::big_int();
+  triprod = mwi::big_int();
+  triprod_tmp = mwi::big_int();
+  triprod_factor = mwi::big_int();
+  pexpo_tmp = prime::pexpo_eval_temp();
+  arena.release();
+}
+
+void FreeList::set_cap(int max_storages) noexcept {
+  max_storages = std::clamp(max_storages, 0, max_slots);
+  cap.store(max_storages);
+  for (int i = max_storages; i < max_slots; ++i) {
+    delete slots[i].exchange(nullptr);
+  }
+}
+
+void FreeList::clear() noexcept {
+  for (auto &slot : slots) {
+    delete slot.exchange(nullptr, std::memory_order_acquire);
+  }
+}
+
+void FreeList::put(std::unique_ptr<TempStorage> storage) noexcept {
+  if (!storage) {
+    return;
+  }
+  storage->reset();
+  const int n = cap.load(std::memory_order_relaxed);
+  for (int i = 0; i < n; ++i) {
+    TempStorage *expected = nullptr;
+    if (!slots[i].load(std::memory_order_relaxed) && slots[i].compare_exchange_strong(expected, storage.get())) {
+      storage.release();
+      /* set_cap may have lowered the cap and swept the slot in between, then the slot is taken back. Either this load
+       * sees the new cap or the sweep sees the storage, as both sides are sequentially consistent. */
+      if (i >= cap.load()) {
+        delete slots[i].exchange(nullptr, std::memory_order_acquire);
+      }
+      return;
+    }
+  }
+}
+
+void FreeList::shrink() noexcept {
+  for (auto &slot : slots) {
+    if (!slot.load(std::memory_order_relaxed)) {
+      continue;
+    }
+    std::unique_ptr<TempStorage> storage(slot.exchange(nullptr, std::memory_order_acquire));
+    if (storage) {
+      storage->shrink();
+      put(std::move(storage));
+    }
+  }
+}
+
+std::unique_ptr<TempStorage> FreeList::take(std::uint32_t stride) noexcept {
+  for (auto &slot : slots) {
+    if (!slot.load(std::memory_order_relaxed)) {
+      continue;
+    }
+    std::unique_ptr<TempStorage> storage(slot.exchange(nullptr, std::memory_order_acquire));
+    if (storage && storage->stride() == stride) {
+      return storage;
+    }
+  }
+  return nullptr;
+}
+
+std::unique_ptr<TempStorage> TempManager::acquire(std::uint32_t stride) noexcept {
+  if (auto storage = FreeList::take(stride)) {
+    return storage;
+  }
+  std::unique_ptr<TempStorage> storage(new (std::nothrow) TempStorage(stride));
+  if (!storage) [[unlikely]] {
+    std::fprintf(stderr, "error in TempManager::acquire: failed to allocate the temporary storage.\n");
+    error::error_process(error::ErrorCode::Bad_Alloc);
+  }
+  return storage;
+}
+
+void TempManager::init(int, std::size_t stride) noexcept {
+  holder.storage = acquire(stride);
 }
 
 TempStorage &TempManager::get(int max_two_j = 0, std::size_t stride = 0) noexcept {
-  int max_iter = max_two_j / 2 + 1;
+  auto &ptr = holder.storage;
   if (!ptr) [[unlikely]] {
     if (max_two_j <= 0 || stride <= 0) [[unlikely]] {
       std::fprintf(stderr, "Error: TempManager not initialized.\n");
       error::error_process(error::ErrorCode::NOT_INITIALIZED);
     }
-    ptr = std::make_unique<TempStorage>(max_iter, stride);
-  } else if (max_two_j > 0 && stride > 0 && (ptr->max_iter != max_iter || ptr->stride() != stride)) [[unlikely]] {
-    ptr = std::make_unique<TempStorage>(max_iter, stride);
+    ptr = acquire(stride);
+  } else if (max_two_j > 0 && stride > 0 && ptr->stride() != stride) [[unlikely]] {
+    ptr = acquire(stride);
   }
   return *ptr;
 }
 
 void TempManager::reset() noexcept {
-  if (ptr) {
-    ptr->reset();
+  if (holder.storage) {
+    holder.storage->reset();
   }
 }
-} // namespace wigcpp::internal::tmp
\ No newline at end of file
+
+void TempManager::shrink() noexcept {
+  if (holder.storage) {
+    holder.storage->shrink();
+  }
+  FreeList::shrink();
+}
+
+void TempManager::release() noexcept {
+  holder.storage.reset();
+  FreeList::clear();
+}
+} // namespace wigcpp::internal::tmp
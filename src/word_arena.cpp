@@ -0,0 +1,142 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "internal/word_arena.hpp"
+#include <algorithm>
+#include <bit>
+#include <new>
+
+namespace wigcpp::internal::allocator {
+
+void *word_arena::allocate(std::size_t bytes) noexcept {
+  if (word_arena *arena = current) {
+    const std::size_t words = (bytes + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+    const auto width = static_cast<int>(std::bit_width(words - 1));
+    const auto cls = static_cast<std::size_t>(std::max(width, min_class) - min_class);
+    if (cls < num_classes) {
+      block *b = arena->take(cls);
+      return b ? b + 1 : nullptr;
+    }
+  }
+  void *p = hooks::allocate(sizeof(block) + bytes, alignof(std::max_align_t));
+  if (!p) [[unlikely]] {
+    return nullptr;
+  }
+  block *b = new (p) block{nullptr, sizeof(block) + bytes};
+  return b + 1;
+}
+
+void word_arena::deallocate(void *p) noexcept {
+  block *b = static_cast<block *>(p) - 1;
+  word_arena *owner = b->owner;
+  if (!owner) {
+    hooks::deallocate(b, b->size, alignof(std::max_align_t));
+    return;
+  }
+  if (owner == current) {
+    next_of(b) = owner->free_blocks[b->size];
+    owner->free_blocks[b->size] = b;
+    return;
+  }
+  block *head = owner->remote.load(std::memory_order_relaxed);
+  do {
+    next_of(b) = head;
+  } while (!owner->remote.compare_exchange_weak(head, b, std::memory_order_release, std::memory_order_relaxed));
+}
+
+word_arena::block *word_arena::take(std::size_t cls) noexcept {
+  block *b = free_blocks[cls];
+  if (!b && remote.load(std::memory_order_relaxed)) {
+    take_remote();
+    b = free_blocks[cls];
+  }
+  if (!b) {
+    return cut(cls);
+  }
+  free_blocks[cls] = next_of(b);
+  return b;
+}
+
+/* a new block, in a chunk of its own if it would take more than a quarter of one */
+word_arena::block *word_arena::cut(std::size_t cls) noexcept {
+  const std::size_t bytes = block_bytes(cls);
+  std::byte *p;
+  if (bytes > chunk_bytes / 4) {
+    p = new_chunk(bytes);
+  } else {
+    if (static_cast<std::size_t>(end - top) < bytes) {
+      std::byte *c = new_chunk(chunk_bytes);
+      if (!c) [[unlikely]] {
+        return nullptr;
+      }
+      top = c;
+      end = c + chunk_bytes;
+    }
+    p = top;
+    top += bytes;
+  }
+  if (!p) [[unlikely]] {
+    return nullptr;
+  }
+  return new (p) block{this, cls};
+}
+
+std::byte *word_arena::new_chunk(std::size_t bytes) noexcept {
+  void *p = hooks::allocate(sizeof(chunk) + bytes, alignof(std::max_align_t));
+  if (!p) [[unlikely]] {
+    return nullptr;
+  }
+  chunks = new (p) chunk{chunks, bytes};
+  chunk_total += bytes;
+  return reinterpret_cast<std::byte *>(chunks + 1);
+}
+
+void word_arena::take_remote() noexcept {
+  for (block *b = remote.exchange(nullptr, std::memory_order_acquire); b;) {
+    block *next = next_of(b);
+    next_of(b) = free_blocks[b->size];
+    free_blocks[b->size] = b;
+    b = next;
+  }
+}
+
+std::size_t word_arena::bytes_for(std::size_t bytes, std::size_t count) noexcept {
+  const std::size_t words = std::max<std::size_t>((bytes + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t), 1);
+  const auto width = static_cast<int>(std::bit_width(words - 1));
+  const auto top = static_cast<std::size_t>(std::max(width, min_class) - min_class);
+  std::size_t cut_bytes = 0, own_bytes = 0;
+  for (std::size_t cls = 0; cls <= top && cls < num_classes; ++cls) {
+    if (block_bytes(cls) > chunk_bytes / 4) {
+      own_bytes += sizeof(chunk) + block_bytes(cls);
+    } else {
+      cut_bytes += block_bytes(cls);
+    }
+  }
+  if (top >= num_classes) {
+    own_bytes += sizeof(block) + bytes;
+  }
+  /* the blocks cut from chunks take whole chunks */
+  const std::size_t chunks = (count * cut_bytes + chunk_bytes - 1) / chunk_bytes;
+  return chunks * (sizeof(chunk) + chunk_bytes) + count * own_bytes;
+}
+
+void word_arena::release() noexcept {
+  for (chunk *c = chunks; c;) {
+    chunk *next = c->next;
+    hooks::deallocate(c, sizeof(chunk) + c->bytes, alignof(std::max_align_t));
+    c = next;
+  }
+  chunks = nullptr;
+  top = end = nullptr;
+  free_blocks.fill(nullptr);
+  remote.store(nullptr, std::memory_order_relaxed);
+  chunk_total = 0;
+}
+
+} // namespace wigcpp::internal::allocator
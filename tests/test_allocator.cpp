@@ -0,0 +1,112 @@
+/* Copyright (c) 2025 Diketene. Licensed under GPL-3.0 */
+
+#include "gtest/gtest.h"
+#include "internal/nothrow_allocator.hpp"
+#include "internal/word_arena.hpp"
+#include "wigcpp/wigcpp.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
+
+using namespace wigcpp::internal;
+
+namespace {
+struct Counts {
+  long long allocs = 0;
+  long long frees = 0;
+  long long bytes = 0;
+};
+
+void *count_alloc(std::size_t size, std::size_t alignment, void *user) {
+  auto *counts = static_cast<Counts *>(user);
+  ++counts->allocs;
+  counts->bytes += static_cast<long long>(size);
+  return ::operator new(size, std::align_val_t{alignment}, std::nothrow);
+}
+
+void count_free(void *p, std::size_t size, std::size_t alignment, void *user) {
+  auto *counts = static_cast<Counts *>(user);
+  ++counts->frees;
+  counts->bytes -= static_cast<long long>(size);
+  ::operator delete(p, std::align_val_t{alignment}, std::nothrow);
+}
+
+double nine_j_sum() {
+  double sum = 0;
+  for (int two_j = 20; two_j <= 120; two_j += 20) {
+    sum += wigcpp::nine_j(two_j, two_j, two_j, two_j, two_j, two_j, two_j, two_j, two_j);
+    sum += wigcpp::six_j(two_j, two_j, two_j, two_j, two_j, two_j);
+  }
+  return sum;
+}
+} // namespace
+
+TEST(test_allocator, custom_allocator) {
+  wigcpp::ensure_global(120, 9);
+  wigcpp::parallel_sums(4);
+  const double expected = nine_j_sum();
+
+  Counts counts;
+  /* blocks of the default allocator are live */
+  EXPECT_FALSE(wigcpp::set_allocator(count_alloc, count_free, &counts));
+  wigcpp::release();
+  EXPECT_EQ(allocator::hooks::live_blocks(), 0);
+  ASSERT_TRUE(wigcpp::set_allocator(count_alloc, count_free, &counts));
+
+  wigcpp::ensure_global(120, 9);
+  EXPECT_EQ(nine_j_sum(), expected);
+  EXPECT_GT(counts.allocs, 0);
+
+  /* the arena of the thread serves the numbers of symbols it met before */
+  wigcpp::parallel_sums(1);
+  const long long allocs = counts.allocs;
+  EXPECT_EQ(nine_j_sum(), expected);
+  EXPECT_EQ(counts.allocs, allocs);
+
+  wigcpp::release();
+  EXPECT_EQ(counts.allocs, counts.frees);
+  EXPECT_EQ(counts.bytes, 0);
+  EXPECT_TRUE(wigcpp::set_allocator(nullptr, nullptr));
+}
+
+TEST(test_allocator, word_arena) {
+  allocator::word_arena arena;
+  void *blocks[4];
+  {
+    const allocator::word_arena::scope scope(&arena);
+    for (int i = 0; i < 4; ++i) {
+      blocks[i] = allocator::word_arena::allocate(64 << i);
+      std::memset(blocks[i], 0xff, 64 << i);
+    }
+  }
+  const std::size_t bytes = arena.bytes();
+  EXPECT_GT(bytes, 0u);
+
+  /* blocks freed on another thread come back to the arena */
+  std::thread([&] {
+    for (void *p : blocks) {
+      allocator::word_arena::deallocate(p);
+    }
+  }).join();
+  {
+    const allocator::word_arena::scope scope(&arena);
+    for (int i = 3; i >= 0; --i) {
+      EXPECT_EQ(allocator::word_arena::allocate(64 << i), blocks[i]);
+    }
+    for (void *p : blocks) {
+      allocator::word_arena::deallocate(p);
+    }
+  }
+  EXPECT_EQ(arena.bytes(), bytes);
+
+  /* without a current arena a block is of its own */
+  const auto live = allocator::hooks::live_blocks();
+  void *p = allocator::word_arena::allocate(64);
+  EXPECT_EQ(allocator::hooks::live_blocks(), live + 1);
+  allocator::word_arena::deallocate(p);
+  EXPECT_EQ(allocator::hooks::live_blocks(), live);
+
+  arena.release();
+  EXPECT_EQ(arena.bytes(), 0u);
+}
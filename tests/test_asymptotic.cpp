@@ -0,0 +1,60 @@
+/* Copyright (c) 2025 Diketene. Licensed under GPL-3.0 */
+
+#include "gtest/gtest.h"
+#include "wigcpp/wigcpp.hpp"
+#include <cmath>
+#include <random>
+
+TEST(test_asymptotic, error_estimate) {
+  wigcpp::ensure_global(2 * 300, 6);
+  std::minstd_rand rng(3);
+  std::uniform_int_distribution<int> dist(0, 300);
+  for (int n = 0; n < 4000; ++n) {
+    int j[6];
+    for (auto &x : j) {
+      x = dist(rng);
+    }
+    const int m1 = j[0] - 2 * (dist(rng) % (j[0] + 1)), m2 = j[1] - 2 * (dist(rng) % (j[1] + 1));
+
+    double error;
+    const double a3 = wigcpp::asymptotic_3j(j[0], j[1], j[2], m1, m2, -m1 - m2, error);
+    EXPECT_LE(std::fabs(a3 - wigcpp::three_j_l(j[0], j[1], j[2], m1, m2, -m1 - m2)), error);
+    const double a6 = wigcpp::asymptotic_6j(j[0], j[1], j[2], j[3], j[4], j[5], error);
+    EXPECT_LE(std::fabs(a6 - wigcpp::six_j_l(j[0], j[1], j[2], j[3], j[4], j[5])), error);
+  }
+}
+
+TEST(test_asymptotic, forbidden) {
+  wigcpp::ensure_global(2 * 700, 6);
+  /* families through both caustics, into the exponential tails */
+  for (int two_m1 = -300; two_m1 <= 300; two_m1 += 2) {
+    double error;
+    const double a = wigcpp::asymptotic_3j(300, 340, 200, two_m1, 40, -two_m1 - 40, error);
+    EXPECT_LE(std::fabs(a - wigcpp::three_j_l(300, 340, 200, two_m1, 40, -two_m1 - 40)), error);
+  }
+  for (int two_j1 = 100; two_j1 <= 700; two_j1 += 2) {
+    double error;
+    const double a = wigcpp::asymptotic_6j(two_j1, 300, 400, 340, 320, 260, error);
+    EXPECT_LE(std::fabs(a - wigcpp::six_j_l(two_j1, 300, 400, 340, 320, 260)), error);
+  }
+  EXPECT_EQ(wigcpp::asymptotic_6j(2, 4, 4, 2, 4, 1), 0.0);
+}
+
+TEST(test_asymptotic, orthogonality) {
+  /* far beyond the pool, sum_j3 (2 j3 + 1) 3j^2 = 1 and sum_x (2 x + 1) (2 j6 + 1) 6j^2 = 1 */
+  const int j1 = 20000, j2 = 24000, m1 = 6666, m2 = -2856;
+  double sum = 0;
+  for (int j3 = j2 - j1; j3 <= j1 + j2; j3 += 2) {
+    const double a = wigcpp::asymptotic_3j(j1, j2, j3, m1, m2, -m1 - m2);
+    sum += (j3 + 1) * a * a;
+  }
+  EXPECT_NEAR(sum, 1.0, 1e-6);
+
+  const int j4 = 18000, j5 = 22000, j6 = 16000;
+  sum = 0;
+  for (int x = 0; x <= 2 * (j1 + j2); x += 2) {
+    const double a = wigcpp::asymptotic_6j(j1, j2, x, j4, j5, j6);
+    sum += double(x + 1) * (j6 + 1) * a * a;
+  }
+  EXPECT_NEAR(sum, 1.0, 1e-6);
+}
@@ -0,0 +1,284 @@
+/* Copyright (c) 2025 Diketene. Licensed under GPL-3.0 */
+
+#include "gtest/gtest.h"
+#include "internal/batch.hpp"
+#include "internal/dedup.hpp"
+#include "wigcpp/wigcpp.hpp"
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace wigcpp::internal;
+
+namespace {
+std::vector<batch::Isa> supported_isas() {
+  std::vector<batch::Isa> isas{batch::Isa::scalar};
+  if (batch::native_isa() != batch::Isa::scalar) {
+    isas.push_back(batch::Isa::avx2);
+  }
+  if (batch::native_isa() == batch::Isa::avx512) {
+    isas.push_back(batch::Isa::avx512);
+  }
+  return isas;
+}
+
+/* symmetric forms of a symbol share the value of their class, which may differ from their own in the last bit */
+::testing::AssertionResult same_class_value(double result, double expected) {
+  if (std::abs(result - expected) <= 0x1p-51 * std::abs(expected)) {
+    return ::testing::AssertionSuccess();
+  }
+  return ::testing::AssertionFailure() << result << " != " << expected;
+}
+} // namespace
+
+TEST(test_batch, batch_3j) {
+  constexpr int max_two_j = 14;
+  wigcpp::ensure_global(2 * 40, 3);
+
+  std::vector<int> two_j;
+  for (int j1 = 0; j1 <= max_two_j; ++j1)
+    for (int j2 = 0; j2 <= max_two_j; ++j2)
+      for (int j3 = 0; j3 <= max_two_j; ++j3)
+        for (int m1 = -j1; m1 <= j1; m1 += 2)
+          for (int m2 = -j2; m2 <= j2; m2 += 2) {
+            two_j.insert(two_j.end(), {j1, j2, j3, m1, m2, -m1 - m2});
+          }
+  /* beyond batch::max_two_j and with odd m sums, left to the Calculator or zero */
+  two_j.insert(two_j.end(), {60, 40, 30, 2, -4, 2, 3, 3, 2, 1, 1, -1, 2, 2, 2, 0, 2, 0});
+  const auto count = two_j.size() / 6;
+
+  std::vector<double> expected(count);
+  for (std::size_t n = 0; n < count; ++n) {
+    const int *s = &two_j[6 * n];
+    expected[n] = wigcpp::three_j(s[0], s[1], s[2], s[3], s[4], s[5]);
+  }
+
+  const auto &pool = global::PoolManager::get();
+  auto &csi = tmp::TempManager::get(pool.max_two_j, pool.stride());
+  for (const auto isa : supported_isas()) {
+    /* an odd count leaves a partly filled last batch */
+    std::vector<double> results(count, 1.0);
+    batch::batch_3j(pool, csi, two_j.data(), count - 1, results.data(), isa);
+    for (std::size_t n = 0; n + 1 < count; ++n) {
+      ASSERT_EQ(results[n], expected[n]) << "isa " << static_cast<int>(isa) << ", symbol " << n;
+    }
+    EXPECT_EQ(results[count - 1], 1.0);
+  }
+
+  std::vector<double> results(count);
+  wigcpp::batch_3j(two_j.data(), static_cast<long long>(count), results.data());
+  EXPECT_EQ(results, expected);
+}
+
+TEST(test_batch, batch_6j) {
+  wigcpp::ensure_global(2 * 40, 6);
+
+  std::vector<int> two_j;
+  for (int n = 0; n < 531441; ++n) {
+    for (int i = 0, x = n; i < 6; ++i, x /= 9) {
+      two_j.push_back(x % 9);
+    }
+  }
+  std::mt19937 gen(6);
+  std::uniform_int_distribution<int> dist(1, 30);
+  for (int n = 0; n < 100000; ++n) {
+    const int a = dist(gen), b = dist(gen), d = dist(gen), e = dist(gen);
+    /* c and f from the triangles (a, b, c) and (a, e, f) */
+    const int c = std::abs(a - b) + 2 * (dist(gen) % (std::min(a, b) + 1));
+    const int f = std::abs(a - e) + 2 * (dist(gen) % (std::min(a, e) + 1));
+    two_j.insert(two_j.end(), {a, b, c, d, e, f});
+  }
+  const auto count = two_j.size() / 6;
+
+  const auto &pool = global::PoolManager::get();
+  auto &csi = tmp::TempManager::get(pool.max_two_j, pool.stride());
+  std::vector<double> expected(count);
+  for (std::size_t n = 0; n < count; ++n) {
+    const int *s = &two_j[6 * n];
+    expected[n] = wigcpp::six_j(s[0], s[1], s[2], s[3], s[4], s[5]);
+  }
+
+  for (const auto isa : supported_isas()) {
+    std::vector<double> results(count);
+    batch::batch_6j(pool, csi, two_j.data(), count, results.data(), isa);
+    for (std::size_t n = 0; n < count; ++n) {
+      ASSERT_EQ(results[n], expected[n]) << "isa " << static_cast<int>(isa) << ", symbol " << n;
+    }
+  }
+}
+
+TEST(test_batch, eval_batch_parallel) {
+  wigcpp::ensure_global(2 * 60, 9);
+
+  /* small symbols for the batch kernels among large ones, so the chunks differ in length */
+  std::mt19937 gen(44);
+  std::uniform_int_distribution<int> small(0, 12), large(0, 60);
+  auto draw = [&](int n) { return n % 7 ? small(gen) : large(gen); };
+  std::vector<int> two_j3, two_j6, two_j9;
+  for (int n = 0; n < 3000; ++n) {
+    const int j1 = draw(n), j2 = draw(n);
+    const int j3 = std::abs(j1 - j2) + 2 * (small(gen) % (std::min(j1, j2) / 2 + 1));
+    const int m1 = -j1 + 2 * (large(gen) % (j1 + 1)), m2 = -j2 + 2 * (large(gen) % (j2 + 1));
+    two_j3.insert(two_j3.end(), {j1, j2, j3, m1, m2, -m1 - m2});
+  }
+  /* the rows and the columns of most 6j and 9j symbols are triangles, the last one checked */
+  auto third = [&](int a, int b) { return std::abs(a - b) + 2 * (large(gen) % (std::min(a, b) + 1)); };
+  auto triangle = [](int a, int b, int c) { return c >= std::abs(a - b) && c <= a + b && !((a + b + c) % 2); };
+  while (two_j6.size() < 6 * 3000) {
+    const int n = static_cast<int>(two_j6.size() / 6);
+    const int a = draw(n), b = draw(n + 1), e = draw(n + 2);
+    const int c = third(a, b), f = third(a, e), d = third(b, f);
+    if (n % 5 && !triangle(d, e, c)) {
+      continue;
+    }
+    two_j6.insert(two_j6.end(), {a, b, c, d, e, f});
+  }
+  while (two_j9.size() < 9 * 300) {
+    const int n = static_cast<int>(two_j9.size() / 9);
+    const int a = n % 10 ? small(gen) : large(gen) / 2, b = draw(n + 1), d = draw(n + 1), e = draw(n + 1);
+    const int c = third(a, b), f = third(d, e), g = third(a, d), h = third(b, e), i = third(c, f);
+    if (n % 5 && !triangle(g, h, i)) {
+      continue;
+    }
+    two_j9.insert(two_j9.end(), {a, b, c, d, e, f, g, h, i});
+  }
+
+  std::vector<double> expected3, expected6, expected9;
+  for (std::size_t n = 0; n < two_j3.size(); n += 6) {
+    const int *s = &two_j3[n];
+    expected3.push_back(wigcpp::three_j(s[0], s[1], s[2], s[3], s[4], s[5]));
+  }
+  for (std::size_t n = 0; n < two_j6.size(); n += 6) {
+    const int *s = &two_j6[n];
+    expected6.push_back(wigcpp::six_j(s[0], s[1], s[2], s[3], s[4], s[5]));
+  }
+  for (std::size_t n = 0; n < two_j9.size(); n += 9) {
+    const int *s = &two_j9[n];
+    expected9.push_back(wigcpp::nine_j(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[8]));
+  }
+
+  auto run = [](int wigner_type, const std::vector<int> &two_j, const std::vector<double> &expected) {
+    std::vector<double> results(expected.size(), 1.0);
+    wigcpp::eval_batch_parallel(wigner_type, two_j.data(), static_cast<long long>(expected.size()), results.data());
+    EXPECT_EQ(results, expected) << "wigner_type " << wigner_type;
+  };
+  for (const int num_threads : {1, 3, 0}) {
+    wigcpp::executor_init(num_threads, num_threads == 3);
+    /* repeated batches reuse the workers */
+    for (int repeat = 0; repeat < 2; ++repeat) {
+      run(3, two_j3, expected3);
+      run(6, two_j6, expected6);
+      run(9, two_j9, expected9);
+    }
+  }
+  wigcpp::executor_shutdown();
+
+  /* the first batch after a shutdown starts the executor again */
+  run(9, two_j9, expected9);
+  wigcpp::eval_batch_parallel(3, two_j3.data(), 0, nullptr);
+  wigcpp::executor_shutdown();
+}
+
+TEST(test_batch, shutdown_during_batches) {
+  wigcpp::ensure_global(2 * 30, 9);
+
+  std::vector<int> two_j;
+  std::vector<double> expected;
+  for (int n = 0; n < 40; ++n) {
+    const int a = 2 + n % 5 * 4;
+    two_j.insert(two_j.end(), {a, 20, 20, 20, a, 20, 20, 20, 2 * a});
+    expected.push_back(wigcpp::nine_j(a, 20, 20, 20, a, 20, 20, 20, 2 * a));
+  }
+
+  /* init and shutdown wait for the batches that run, which never lose their executor */
+  std::atomic<int> finished{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; ++t) {
+    threads.emplace_back([&] {
+      for (int repeat = 0; repeat < 20; ++repeat) {
+        std::vector<double> results(expected.size());
+        wigcpp::eval_batch_parallel(9, two_j.data(), static_cast<long long>(expected.size()), results.data());
+        EXPECT_EQ(results, expected);
+      }
+      ++finished;
+    });
+  }
+  for (int n = 0; finished.load() < 2; ++n) {
+    wigcpp::executor_init(n % 3 + 1);
+    wigcpp::executor_shutdown();
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  wigcpp::executor_shutdown();
+}
+
+TEST(test_batch, estimate_cost) {
+  wigcpp::ensure_global(2 * 60, 9);
+
+  const int zero_3j[] = {2, 2, 6, 0, 0, 0}, small_3j[] = {4, 4, 4, 2, 0, -2}, large_3j[] = {40, 40, 40, 2, 0, -2};
+  EXPECT_EQ(wigcpp::estimate_cost(3, zero_3j), 1.0);
+  EXPECT_GT(wigcpp::estimate_cost(3, small_3j), 1.0);
+  EXPECT_GT(wigcpp::estimate_cost(3, large_3j), 10 * wigcpp::estimate_cost(3, small_3j));
+
+  const int small_6j[] = {4, 4, 4, 4, 4, 4}, large_6j[] = {40, 40, 40, 40, 40, 40}, past_pool[] = {200, 200, 200, 200,
+                                                                                                  200, 200};
+  EXPECT_GT(wigcpp::estimate_cost(6, large_6j), 10 * wigcpp::estimate_cost(6, small_6j));
+  EXPECT_GT(wigcpp::estimate_cost(6, past_pool), wigcpp::estimate_cost(6, large_6j));
+
+  const int small_9j[] = {2, 2, 2, 2, 2, 2, 2, 2, 2}, large_9j[] = {20, 20, 20, 20, 20, 20, 20, 20, 20};
+  EXPECT_GT(wigcpp::estimate_cost(9, large_9j), 10 * wigcpp::estimate_cost(9, small_9j));
+
+  /* a batch of equal keys keeps its order and skips the gathering */
+  std::vector<int> two_j;
+  for (int n = 0; n < 100; ++n) {
+    two_j.insert(two_j.end(), std::begin(large_9j), std::end(large_9j));
+  }
+  const double expected = wigcpp::nine_j(20, 20, 20, 20, 20, 20, 20, 20, 20);
+  std::vector<double> results(100);
+  wigcpp::eval_batch_parallel(9, two_j.data(), 100, results.data());
+  EXPECT_EQ(results, std::vector<double>(100, expected));
+  wigcpp::executor_shutdown();
+}
+
+TEST(test_batch, unique_symbols) {
+  wigcpp::ensure_global(2 * 40, 9);
+  wigcpp::batch_dedup();
+
+  /* Regge and tetrahedral variants of one symbol each, and a trivial zero */
+  const std::vector<int> two_j3{8, 6, 4, 2, -2, 0, 6, 8, 4, -2, 2, 0, 8, 4, 6, -2, 0, 2, 7, 5, 5, 1, 1, -2, 8, 6, 4, 0, 0, 0};
+  const std::vector<int> two_j6{8, 6, 4, 6, 4, 6, 6, 8, 4, 4, 6, 6, 6, 4, 4, 8, 6, 6, 8, 6, 4, 6, 4, 7};
+  const std::vector<int> two_j9{2, 4, 6, 4, 4, 4, 6, 4, 2, 4, 2, 6, 4, 4, 4, 4, 6, 2, 2, 4, 6, 4, 4, 4, 6, 4, 4};
+
+  const auto unique3 = dedup::unique_symbols(3, two_j3.data(), 5);
+  EXPECT_EQ(unique3.size(), 2u);
+  EXPECT_EQ(unique3.sign[3], 0);
+  const auto unique6 = dedup::unique_symbols(6, two_j6.data(), 4);
+  EXPECT_EQ(unique6.size(), 1u);
+  EXPECT_EQ(unique6.sign[3], 0);
+  const auto unique9 = dedup::unique_symbols(9, two_j9.data(), 3);
+  EXPECT_EQ(unique9.size(), 2u);
+
+  auto check = [](int wigner_type, const std::vector<int> &two_j, auto &&symbol) {
+    const int args = wigner_type == 9 ? 9 : 6;
+    const std::size_t count = two_j.size() / args;
+    std::vector<double> results(count, 1.0);
+    wigcpp::eval_batch_parallel(wigner_type, two_j.data(), static_cast<long long>(count), results.data());
+    for (std::size_t n = 0; n < count; ++n) {
+      EXPECT_TRUE(same_class_value(results[n], symbol(&two_j[args * n])))
+          << "wigner_type " << wigner_type << ", symbol " << n;
+    }
+  };
+  check(3, two_j3, [](const int *s) { return wigcpp::three_j(s[0], s[1], s[2], s[3], s[4], s[5]); });
+  check(6, two_j6, [](const int *s) { return wigcpp::six_j(s[0], s[1], s[2], s[3], s[4], s[5]); });
+  check(9, two_j9, [](const int *s) { return wigcpp::nine_j(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[8]); });
+  wigcpp::executor_shutdown();
+
+  std::vector<double> results(5);
+  wigcpp::batch_3j(two_j3.data(), 5, results.data());
+  EXPECT_EQ(results[1], -results[0]);
+  EXPECT_EQ(results[3], 0.0);
+  wigcpp::batch_dedup(false);
+}
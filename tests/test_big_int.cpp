@@ -6,6 +6,9 @@
 #include <gtest/gtest.h>
 #include "internal/big_int.hpp"
 #include "internal/definitions.hpp"
+#include "internal/mwi_kernels.hpp"
+#include <random>
+#include <vector>
 
 TEST(test_mwi_new, big_int_test) {
   using namespace wigcpp::internal::mwi;
@@ -288,10 +291,193 @@ TEST(test_mwi_new, test_operator_multiply) {
                             "0000000000000000000000000000000000000000000000000000000000000000");
 }
 
+TEST(test_mwi_new, test_multiply_large) {
+  using namespace wigcpp::internal::mwi;
+
+  /* products of thousands of bits, in the range of subquadratic multiplication, against word by word products */
+  big_int a(1), b(1);
+  for (int i = 0; i < 2000; i++) {
+    a *= 3;
+  }
+  for (int i = 0; i < 3000; i++) {
+    b *= 5;
+  }
+  big_int expected = a;
+  for (int i = 0; i < 3000; i++) {
+    expected *= 5;
+  }
+
+  EXPECT_EQ((a * b).to_hex_str(), expected.to_hex_str());
+  EXPECT_EQ((b * a).to_hex_str(), expected.to_hex_str());
+  EXPECT_EQ((a * -b).to_hex_str(), (-expected).to_hex_str());
+  EXPECT_EQ((-a * b).to_hex_str(), (-expected).to_hex_str());
+  EXPECT_EQ((-a * -b).to_hex_str(), expected.to_hex_str());
+
+  big_int c = -b;
+  for (int i = 0; i < 2000; i++) {
+    c *= 3;
+  }
+  EXPECT_EQ(c.to_hex_str(), (-expected).to_hex_str());
+
+  big_int zero(0);
+  EXPECT_TRUE((a * zero).is_zero());
+  EXPECT_TRUE((-b * zero).is_zero());
+}
+
+TEST(test_mwi_new, test_big_nat) {
+  using namespace wigcpp::internal::mwi;
+
+  /* the same products as natural numbers and as big_int, and mixed with big_int */
+  big_nat a(1), b(1);
+  big_int a_int(1), b_int(1);
+  for (int i = 0; i < 2000; i++) {
+    a *= 3;
+    a_int *= 3;
+  }
+  for (std::size_t i = 1; i <= 500; i++) {
+    b *= i;
+    b_int *= i;
+  }
+  EXPECT_EQ(a.to_hex_str(), a_int.to_hex_str());
+  EXPECT_EQ(b.to_hex_str(), b_int.to_hex_str());
+  EXPECT_EQ((a * b).to_hex_str(), (a_int * b_int).to_hex_str());
+  EXPECT_EQ((b * a).to_hex_str(), (a_int * b_int).to_hex_str());
+  EXPECT_EQ((-a_int * b).to_hex_str(), (-a_int * b_int).to_hex_str());
+
+  big_int c = -a_int;
+  c += b;
+  EXPECT_EQ(c.to_hex_str(), (b_int - a_int).to_hex_str());
+  c -= b;
+  c -= b;
+  EXPECT_EQ(c.to_hex_str(), (-a_int - b_int).to_hex_str());
+  c *= b;
+  EXPECT_EQ(c.to_hex_str(), ((-a_int - b_int) * b_int).to_hex_str());
+
+  /* a top word with its high bit set, which a big_int extends with a zero word */
+  big_nat d(~wigcpp::internal::def::uword_t(0));
+  EXPECT_EQ(d.size(), 1);
+  d *= d;
+  EXPECT_EQ(d.to_hex_str(), "fffffffffffffffe0000000000000001");
+  big_int e(1);
+  e += d;
+  EXPECT_EQ(e.to_hex_str(), "fffffffffffffffe0000000000000002");
+
+  EXPECT_TRUE((a * big_nat(0)).is_zero());
+  a *= 0;
+  EXPECT_TRUE(a.is_zero());
+  EXPECT_EQ(big_nat(0).to_hex_str(), "0");
+}
+
+TEST(test_mwi_new, test_big_sum) {
+  using namespace wigcpp::internal::mwi;
+
+  /* alternating sums of factorials, whose terms carry through the words above them */
+  for (const int sign : {0, 1}) {
+    big_sum sum;
+    sum.reset(48);
+    big_int expected(0);
+    big_nat term(1);
+    for (std::size_t k = 1; k <= 400; ++k) {
+      term *= k;
+      if ((k ^ sign) & 1) {
+        sum.sub(term);
+        expected -= term;
+      } else {
+        sum.add(term);
+        expected += term;
+      }
+    }
+    big_int result;
+    sum.result(result);
+    EXPECT_EQ(result.to_hex_str(), expected.to_hex_str());
+    EXPECT_EQ(result.size(), expected.size());
+  }
+
+  big_sum sum;
+  sum.reset(2);
+  sum.add(big_nat(~wigcpp::internal::def::uword_t(0)));
+  sum.add(big_nat(1));
+  sum.sub(big_nat(3));
+  big_int result;
+  sum.result(result);
+  EXPECT_EQ(result.to_hex_str(), "fffffffffffffffd");
+  sum.sub(big_nat(~wigcpp::internal::def::uword_t(0)));
+  sum.result(result);
+  EXPECT_EQ(result.to_hex_str(), "-2");
+  EXPECT_EQ(result.size(), 1);
+  sum.reset(1);
+  sum.result(result);
+  EXPECT_TRUE(result.is_zero());
+}
+
+TEST(test_mwi_new, test_kernels) {
+  using namespace wigcpp::internal::mwi;
+  using wigcpp::internal::def::uword_t;
+
+  const kernel::Kernels &generic = kernel::generic();
+  const kernel::Kernels *adx = kernel::adx();
+  if (!adx) {
+    GTEST_SKIP() << "ADX and BMI2 are not supported";
+  }
+
+  /* random words and words of all ones, where every carry propagates */
+  std::mt19937_64 rng(3);
+  for (const std::size_t n : {1u, 2u, 3u, 17u, 64u}) {
+    for (int round = 0; round < 20; ++round) {
+      std::vector<uword_t> u(n), v(n), r(n), r_adx(n);
+      for (std::size_t i = 0; i < n; ++i) {
+        u[i] = round % 4 ? rng() : ~uword_t(0);
+        v[i] = round % 5 ? rng() : ~uword_t(0);
+      }
+      const uword_t w = round % 3 ? rng() : ~uword_t(0);
+      const uword_t c = round & 1;
+
+      EXPECT_EQ(generic.add_n(r.data(), u.data(), v.data(), n, c), adx->add_n(r_adx.data(), u.data(), v.data(), n, c));
+      EXPECT_EQ(r, r_adx);
+      EXPECT_EQ(generic.sub_n(r.data(), u.data(), v.data(), n, c), adx->sub_n(r_adx.data(), u.data(), v.data(), n, c));
+      EXPECT_EQ(r, r_adx);
+      EXPECT_EQ(generic.mul_1(r.data(), u.data(), n, w), adx->mul_1(r_adx.data(), u.data(), n, w));
+      EXPECT_EQ(r, r_adx);
+      r = v;
+      r_adx = v;
+      EXPECT_EQ(generic.addmul_1(r.data(), u.data(), n, w), adx->addmul_1(r_adx.data(), u.data(), n, w));
+      EXPECT_EQ(r, r_adx);
+    }
+  }
+}
+
 TEST(test_mwi_new, to_floating_point) {
   using wigcpp::internal::mwi::big_int;
   big_int a(10000);
   const auto [v, e] = a.to_floating_point();
   wigcpp::internal::def::double_type res = std::ldexp(v, e);
   EXPECT_EQ(res, 10000.0);
-}
\ No newline at end of file
+}
+TEST(test_mwi_new, assign_dword) {
+  using wigcpp::internal::mwi::big_int;
+  using namespace wigcpp::internal::def;
+
+  big_int a;
+  a.assign(-1);
+  EXPECT_EQ(a.size(), 1);
+  EXPECT_TRUE(a.is_minus());
+
+  const dword_t large = static_cast<dword_t>(1) << (shift_bits + 6);
+  a.assign(large);
+  EXPECT_EQ(a.size(), 2);
+  EXPECT_EQ(a[0], 0);
+  EXPECT_EQ(a[1], 64);
+
+  big_int b(1);
+  for (int i = 0; i < 8; ++i) {
+    b *= static_cast<uword_t>(1) << (shift_bits / 8);
+  }
+  b *= 64;
+  a.assign(-large);
+  EXPECT_EQ((a + b).to_hex_str(), big_int(0).to_hex_str());
+
+  /* a positive value whose low word has the sign bit set keeps its high word */
+  a.assign(static_cast<dword_t>(sign_bit));
+  EXPECT_EQ(a.size(), 2);
+  EXPECT_FALSE(a.is_minus());
+}
@@ -0,0 +1,72 @@
+/* Copyright (c) 2025 Diketene. Licensed under GPL-3.0 */
+
+#include "gtest/gtest.h"
+#include "internal/global_pool.hpp"
+#include "internal/symbol_cache.hpp"
+#include "internal/tmp_pool.hpp"
+#include "wigcpp/wigcpp.hpp"
+
+using namespace wigcpp::internal;
+
+TEST(test_memory_plan, plan_matches_allocations) {
+  wigcpp::release();
+  long long pool_bytes = 0, thread_bytes = 0;
+  const long long total = wigcpp::plan_memory(200, 6, 2, 0, pool_bytes, thread_bytes);
+  /* the two threads and the 8 storages kept for new threads */
+  EXPECT_EQ(total, pool_bytes + (2 + 8) * thread_bytes);
+
+  wigcpp::ensure_global(200, 6);
+  const auto &pool = global::PoolManager::get();
+  EXPECT_EQ(static_cast<long long>(pool.bytes()), pool_bytes);
+
+  /* the rows and the arena of a storage stay within the plan after the largest sums */
+  EXPECT_NE(wigcpp::six_j(200, 200, 200, 200, 200, 200), 0.0);
+  EXPECT_NE(wigcpp::three_j(200, 200, 200, 0, 0, 0), 0.0);
+  const auto &csi = tmp::TempManager::get(pool.max_two_j, pool.stride());
+  EXPECT_LE(static_cast<long long>(csi.row_bytes() + csi.arena.bytes()), thread_bytes);
+
+  const long long with_cache = wigcpp::plan_memory(200, 6, 2, 1 << 20);
+  wigcpp::cache_enable(1 << 20);
+  EXPECT_EQ(with_cache - total, static_cast<long long>(cache::CacheManager::get()->bytes()));
+  wigcpp::release();
+}
+
+TEST(test_memory_plan, ensure_global_budget) {
+  wigcpp::release();
+  long long pool_bytes = 0, thread_bytes = 0;
+  const long long total = wigcpp::plan_memory(200, 6, 2, 0, pool_bytes, thread_bytes) - 8 * thread_bytes;
+
+  EXPECT_FALSE(wigcpp::ensure_global_budget(200, 6, 2, total - 1));
+  EXPECT_EQ(global::PoolManager::current(), nullptr);
+
+  /* the storages kept for new threads make room for the pool */
+  EXPECT_TRUE(wigcpp::ensure_global_budget(200, 6, 2, total + 3 * thread_bytes));
+  ASSERT_NE(global::PoolManager::current(), nullptr);
+  EXPECT_EQ(tmp::FreeList::capacity(), 3);
+  EXPECT_TRUE(wigcpp::ensure_global_budget(200, 6, 2, total));
+  EXPECT_EQ(tmp::FreeList::capacity(), 0);
+  wigcpp::recycle_tls(8);
+  const double expected = wigcpp::six_j(200, 200, 200, 200, 200, 200);
+
+  /* a larger pool that no longer fits is replaced, the cache is cut to what is left and then dropped */
+  wigcpp::ensure_global(400, 9);
+  wigcpp::cache_enable(1 << 20);
+  EXPECT_TRUE(wigcpp::ensure_global_budget(200, 6, 2, total + 4096));
+  EXPECT_EQ(global::PoolManager::current()->max_two_j, 200);
+  ASSERT_NE(cache::CacheManager::get(), nullptr);
+  EXPECT_LE(cache::CacheManager::get()->bytes(), 4096u);
+  EXPECT_EQ(wigcpp::six_j(200, 200, 200, 200, 200, 200), expected);
+
+  EXPECT_TRUE(wigcpp::ensure_global_budget(200, 6, 2, total));
+  EXPECT_EQ(cache::CacheManager::get(), nullptr);
+
+  /* a pool that fits stays */
+  const auto *pool = global::PoolManager::current();
+  EXPECT_TRUE(wigcpp::ensure_global_budget(100, 3, 2, total));
+  EXPECT_EQ(global::PoolManager::current(), pool);
+
+  wigcpp::release();
+  EXPECT_EQ(global::PoolManager::current(), nullptr);
+  wigcpp::ensure_global(200, 6);
+  EXPECT_EQ(wigcpp::six_j(200, 200, 200, 200, 200, 200), expected);
+}
@@ -0,0 +1,75 @@
+/* Copyright (c) 2025 Diketene. Licensed under GPL-3.0 */
+
+#include "gtest/gtest.h"
+#include "internal/big_int.hpp"
+#include "internal/global_pool.hpp"
+#include "internal/modular.hpp"
+#include "wigcpp/wigcpp.hpp"
+#include <vector>
+
+using namespace wigcpp::internal;
+
+TEST(test_modular, sum_terms) {
+  global::PoolManager::ensure(400, 3);
+  const auto &pool = global::PoolManager::get();
+  const std::vector<modular::exp_t> none(pool.stride(), 0);
+  const modular::view_type empty{none.data(), 0};
+
+  /* sum_k (-1)^(k + sign) (n + k)!, with far more moduli than needed */
+  for (const int n : {0, 5, 40}) {
+    for (const int sign : {0, 1}) {
+      const int k_lim = 60;
+      mwi::big_int expected, term;
+      term = 1;
+      for (int i = 2; i <= n; ++i) {
+        term *= i;
+      }
+      expected = 0;
+      for (int k = 0; k <= k_lim; ++k) {
+        if ((k ^ sign) & 1) {
+          expected -= term;
+        } else {
+          expected += term;
+        }
+        term *= n + k + 1;
+      }
+      const modular::racah_terms terms{k_lim, sign, 1, 0, 0, {n}, {}, {}};
+      mwi::big_int sum;
+      ASSERT_TRUE(modular::sum_terms(pool.prime_table, pool[n], empty, terms, 3000, sum));
+      EXPECT_EQ(sum.to_hex_str(), expected.to_hex_str());
+    }
+  }
+
+  /* sum_k (-1)^k K! / (k! (K - k)!) vanishes */
+  for (const int k_lim : {1, 7, 300}) {
+    const modular::racah_terms terms{k_lim, 0, 0, 1, 1, {}, {0}, {k_lim}};
+    mwi::big_int sum;
+    sum = 1;
+    ASSERT_TRUE(modular::sum_terms(pool.prime_table, empty, empty, terms, 400, sum));
+    EXPECT_TRUE(sum.is_zero());
+  }
+
+  /* past max_moduli the caller sums the terms itself */
+  const modular::racah_terms terms{1, 0, 1, 0, 0, {0}, {}, {}};
+  mwi::big_int sum;
+  EXPECT_FALSE(modular::sum_terms(pool.prime_table, empty, empty, terms, 61 * modular::max_moduli, sum));
+}
+
+TEST(test_modular, symbols) {
+  /* sums of several hundred bits, against the recurrence */
+  wigcpp::ensure_global(2 * 700, 6);
+  std::vector<double> results(701);
+  int first;
+  int count = wigcpp::family_3j_j(600, 500, -40, 100, first, results.data());
+  for (int k = 0; k < count; k += 7) {
+    EXPECT_NEAR(results[k], wigcpp::three_j(first + 2 * k, 600, 500, -60, -40, 100), 1e-13);
+  }
+  count = wigcpp::family_6j(500, 600, 400, 550, 450, first, results.data());
+  for (int k = 0; k < count; k += 7) {
+    EXPECT_NEAR(results[k], wigcpp::six_j(first + 2 * k, 500, 600, 400, 550, 450), 1e-13);
+  }
+
+  /* zeros that are not forced by the selection rules */
+  EXPECT_EQ(wigcpp::three_j(120, 120, 10, 2, 2, -4), 0);
+  EXPECT_EQ(wigcpp::three_j(120, 120, 6, -2, -2, 4), 0);
+}
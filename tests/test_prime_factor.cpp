@@ -1,8 +1,14 @@
 /* Copyright (c) 2025 Diketene. Licensed under GPL-3.0 */
 
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdlib>
+#include <vector>
 #include "internal/global_pool.hpp"
+#include "internal/pexpo_eval_ctx.hpp"
+#include "internal/prime_ops.hpp"
 #include "internal/tmp_pool.hpp"
 
 using namespace wigcpp::internal::global;
@@ -40,4 +46,91 @@ TEST(test_prime_factor, test_global_init) {
     EXPECT_EQ(pool3.max_two_j, 1000);
     EXPECT_EQ(pool3.wigner_type, 6);
   }
-}
\ No newline at end of file
+}
+
+TEST(test_prime_factor, test_evaluate_fixed) {
+  PoolManager::ensure(100, 3);
+  const auto &pool = PoolManager::get();
+  auto &tmp = TempManager::get(100, pool.stride());
+  using namespace wigcpp::internal::def;
+
+  /* factorials that fit in a double word, compared with the big_nat evaluation */
+  for (const auto n : {1u, 2u, 13u, 30u}) {
+    wigcpp::internal::mwi::big_nat big;
+    tmp.pexpo_tmp.evaluate(pool.prime_table, big, pool[n]);
+    const auto fixed = evaluate_fixed<udword_t>(pool.prime_table, pool[n]);
+    EXPECT_EQ(static_cast<uword_t>(fixed), big[0]);
+    EXPECT_EQ(static_cast<uword_t>(fixed >> shift_bits), big.size() > 1 ? big[1] : 0);
+  }
+
+  /* 33! / (20! 19) */
+  exp_t *row = tmp.data(prefact);
+  std::uint32_t &used = tmp.used(prefact);
+  reset_row(row, used);
+  ensure_used(used, pool[33].used);
+  add_sub3(row, used, pool[33], pool[20], pool[0], pool[0]);
+  expand_sub(row, used, pool.prime_factor(19));
+
+  udword_t pos, neg;
+  evaluate2_fixed<udword_t>(pool.prime_table, pos, neg, tmp.view(prefact));
+  udword_t expected = 1;
+  for (int i = 21; i <= 33; ++i) {
+    expected *= i;
+  }
+  EXPECT_EQ(pos, expected);
+  EXPECT_EQ(neg, 19u);
+  reset_row(row, used);
+}
+
+TEST(test_prime_factor, test_delta_cache) {
+  PoolManager::ensure(100, 3);
+  const auto &pool = PoolManager::get();
+  auto &tmp = TempManager::get(100, pool.stride());
+  tmp.reset();
+
+  int fills = 0;
+  const auto delta = [&](int a, int b, int c) {
+    return tmp.delta(a, b, c, [&](exp_t *row, std::uint32_t &used) {
+      ++fills;
+      const auto d = pool[(a + b + c) / 2 + 1];
+      set_used(row, used, d.used);
+      sum<OP::add, OP::add, OP::add, OP::sub>(row, used, pool[(a + b - c) / 2], pool[(a - b + c) / 2],
+                                              pool[(-a + b + c) / 2], d);
+    });
+  };
+
+  /* Delta(abc) is filled once for all orders of the triad */
+  const auto first = delta(10, 20, 24);
+  EXPECT_EQ(fills, 1);
+  for (const auto &[a, b, c] : {std::array{20, 10, 24}, {24, 20, 10}, {10, 24, 20}}) {
+    const auto again = delta(a, b, c);
+    EXPECT_EQ(again.ptr, first.ptr);
+    EXPECT_EQ(again.used, first.used);
+  }
+  EXPECT_EQ(fills, 1);
+
+  /* more triads than slots, every row read back against one built directly */
+  std::vector<exp_t> expected(pool.stride());
+  for (int a = 0; a <= 30; ++a) {
+    for (int b = 0; b <= 30; ++b) {
+      for (int c = std::abs(a - b); c <= a + b; c += 2) {
+        const auto d = pool[(a + b + c) / 2 + 1];
+        std::fill(expected.begin(), expected.end(), 0);
+        sum<OP::add, OP::add, OP::add, OP::sub>(expected.data(), d.used, pool[(a + b - c) / 2],
+                                                pool[(a - b + c) / 2], pool[(-a + b + c) / 2], d);
+        const auto row = delta(a, b, c);
+        ASSERT_EQ(row.used, d.used);
+        for (std::uint32_t i = 0; i < pool.stride(); ++i) {
+          ASSERT_EQ(row.ptr[i], expected[i]) << a << " " << b << " " << c;
+        }
+      }
+    }
+  }
+  EXPECT_GT(fills, static_cast<int>(delta_slots));
+
+  /* reset forgets the triads */
+  tmp.reset();
+  fills = 0;
+  delta(10, 20, 24);
+  EXPECT_EQ(fills, 1);
+}
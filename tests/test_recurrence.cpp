@@ -0,0 +1,79 @@
+/* Copyright (c) 2025 Diketene. Licensed under GPL-3.0 */
+
+#include "gtest/gtest.h"
+#include "wigcpp/wigcpp.hpp"
+#include <cmath>
+#include <random>
+#include <vector>
+
+TEST(test_recurrence, exact) {
+  wigcpp::ensure_global(2 * 200, 6);
+  std::minstd_rand rng(17);
+  std::uniform_int_distribution<int> dist(0, 100);
+  std::vector<double> results(202);
+  for (int n = 0; n < 300; ++n) {
+    int j[6];
+    for (auto &x : j) {
+      x = dist(rng);
+    }
+    const int m2 = j[1] - 2 * (dist(rng) % (j[1] + 1)), m3 = j[2] - 2 * (dist(rng) % (j[2] + 1));
+
+    int first;
+    int count = wigcpp::family_3j_j(j[1], j[2], m2, m3, first, results.data());
+    EXPECT_EQ(count, wigcpp::family_3j_j(j[1], j[2], m2, m3, first, nullptr));
+    for (int k = 0; k < count; ++k) {
+      EXPECT_NEAR(results[k], wigcpp::three_j_l(first + 2 * k, j[1], j[2], -m2 - m3, m2, m3), 1e-14);
+    }
+
+    j[0] += (j[0] + j[1] + j[2]) % 2;
+    const int m1 = j[0] - 2 * (dist(rng) % (j[0] + 1));
+    count = wigcpp::family_3j_m(j[0], j[1], j[2], m1, first, results.data());
+    for (int k = 0; k < count; ++k) {
+      const int m = first + 2 * k;
+      EXPECT_NEAR(results[k], wigcpp::three_j_l(j[0], j[1], j[2], m1, m, -m1 - m), 1e-14);
+    }
+
+    count = wigcpp::family_6j(j[1], j[2], j[3], j[4], j[5], first, results.data());
+    for (int k = 0; k < count; ++k) {
+      EXPECT_NEAR(results[k], wigcpp::six_j_l(first + 2 * k, j[1], j[2], j[3], j[4], j[5]), 1e-14);
+    }
+  }
+}
+
+TEST(test_recurrence, large) {
+  /* deep classically forbidden tails at 2j ~ 1e4, relative to the exact symbols */
+  wigcpp::ensure_global(2 * 10000, 3);
+  std::vector<double> results(5001);
+  int first;
+  const int count = wigcpp::family_3j_j(5000, 4500, 4500, -500, first, results.data());
+  ASSERT_EQ(count, 2751);
+  ASSERT_EQ(first, 4000);
+  for (int k = 0; k < count; k += 250) {
+    const long double exact = wigcpp::three_j_l(first + 2 * k, 5000, 4500, -4000, 4500, -500);
+    if (std::fabs(exact) > 1e-300L) {
+      EXPECT_NEAR(results[k] / exact, 1.0, 1e-12);
+    }
+  }
+
+  /* far beyond the pool, against the semiclassical approximation */
+  results.resize(170001);
+  ASSERT_EQ(wigcpp::family_6j(200000, 180000, 190000, 210000, 170000, first, results.data()), 170001);
+  for (int k = 0; k < 170001; k += 5000) {
+    double error;
+    const double a = wigcpp::asymptotic_6j(first + 2 * k, 200000, 180000, 190000, 210000, 170000, error);
+    EXPECT_LE(std::fabs(results[k] - a), error);
+  }
+}
+
+TEST(test_recurrence, empty) {
+  wigcpp::ensure_global(2 * 4, 3);
+  int first;
+  EXPECT_EQ(wigcpp::family_3j_j(4, 2, 5, 0, first, nullptr), 0);
+  EXPECT_EQ(wigcpp::family_3j_m(2, 4, 8, 0, first, nullptr), 0);
+  EXPECT_EQ(wigcpp::family_6j(2, 4, 4, 2, 3, first, nullptr), 0);
+
+  double result;
+  EXPECT_EQ(wigcpp::family_3j_j(0, 4, 0, 2, first, &result), 1);
+  EXPECT_EQ(first, 4);
+  EXPECT_DOUBLE_EQ(result, wigcpp::three_j(4, 0, 4, -2, 0, 2));
+}
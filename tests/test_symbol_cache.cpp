@@ -0,0 +1,186 @@
+/* Copyright (c) 2025 Diketene. Licensed under GPL-3.0 */
+
+#include "gtest/gtest.h"
+#include "internal/calc.hpp"
+#include "internal/symbol_cache.hpp"
+#include "internal/symmetry.hpp"
+#include "wigcpp/wigcpp.hpp"
+#include <array>
+#include <thread>
+#include <vector>
+
+using namespace wigcpp::internal;
+
+namespace {
+constexpr int perm3[6][3] = {{0, 1, 2}, {1, 2, 0}, {2, 0, 1}, {1, 0, 2}, {0, 2, 1}, {2, 1, 0}};
+
+std::vector<std::array<int, 6>> all_3j(int max_two_j) {
+  std::vector<std::array<int, 6>> out;
+  for (int j1 = 0; j1 <= max_two_j; ++j1)
+    for (int j2 = 0; j2 <= max_two_j; ++j2)
+      for (int j3 = 0; j3 <= max_two_j; ++j3)
+        for (int m1 = -j1; m1 <= j1; m1 += 2)
+          for (int m2 = -j2; m2 <= j2; m2 += 2) {
+            const int m3 = -m1 - m2;
+            if (!calc::TrivialZero::is_zero_3j(j1, j2, j3, m1, m2, m3)) {
+              out.push_back({j1, j2, j3, m1, m2, m3});
+            }
+          }
+  return out;
+}
+} // namespace
+
+TEST(test_symmetry, regge_3j) {
+  wigcpp::ensure_global(2 * 20, 3);
+  for (const auto &a : all_3j(8)) {
+    const int r[3][3] = {{(-a[0] + a[1] + a[2]) / 2, (a[0] - a[1] + a[2]) / 2, (a[0] + a[1] - a[2]) / 2},
+                         {(a[0] - a[3]) / 2, (a[1] - a[4]) / 2, (a[2] - a[5]) / 2},
+                         {(a[0] + a[3]) / 2, (a[1] + a[4]) / 2, (a[2] + a[5]) / 2}};
+    const int J = (a[0] + a[1] + a[2]) / 2;
+    const auto canon = symmetry::canonicalize_3j(a[0], a[1], a[2], a[3], a[4], a[5]);
+    const double value = wigcpp::three_j(a[0], a[1], a[2], a[3], a[4], a[5]);
+
+    const auto rep = symmetry::representative_3j(canon);
+    EXPECT_DOUBLE_EQ(value, canon.sign * wigcpp::three_j(rep[0], rep[1], rep[2], rep[3], rep[4], rep[5]));
+
+    for (int t = 0; t < 2; ++t)
+      for (int rp = 0; rp < 6; ++rp)
+        for (int cp = 0; cp < 6; ++cp) {
+          int s[3][3];
+          for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) {
+              const int row = perm3[rp][i], col = perm3[cp][j];
+              s[i][j] = t ? r[col][row] : r[row][col];
+            }
+          const int sign = (((rp >= 3) != (cp >= 3)) && (J & 1)) ? -1 : 1;
+          const auto other = symmetry::canonicalize_3j(s[1][0] + s[2][0], s[1][1] + s[2][1], s[1][2] + s[2][2],
+                                                       s[2][0] - s[1][0], s[2][1] - s[1][1], s[2][2] - s[1][2]);
+          ASSERT_EQ(other.chain, canon.chain);
+          if (value != 0) {
+            EXPECT_EQ(other.sign * sign, canon.sign);
+          }
+        }
+  }
+}
+
+TEST(test_symmetry, regge_6j) {
+  wigcpp::ensure_global(2 * 20, 6);
+  constexpr int n = 6;
+  for (int a = 0; a <= n; ++a)
+    for (int b = 0; b <= n; ++b)
+      for (int c = 0; c <= n; ++c)
+        for (int d = 0; d <= n; ++d)
+          for (int e = 0; e <= n; ++e)
+            for (int f = 0; f <= n; ++f) {
+              if (calc::TrivialZero::is_zero_6j(a, b, c, d, e, f)) {
+                continue;
+              }
+              const auto canon = symmetry::canonicalize_6j(a, b, c, d, e, f);
+              const auto rep = symmetry::representative_6j(canon);
+              EXPECT_DOUBLE_EQ(wigcpp::six_j(a, b, c, d, e, f),
+                               wigcpp::six_j(rep[0], rep[1], rep[2], rep[3], rep[4], rep[5]));
+
+              /* tetrahedral: column permutation and upper/lower swap in two columns */
+              EXPECT_EQ(symmetry::canonicalize_6j(b, c, a, e, f, d).chain, canon.chain);
+              EXPECT_EQ(symmetry::canonicalize_6j(d, e, c, a, b, f).chain, canon.chain);
+
+              /* Regge */
+              const int s = (b + c + e + f) / 2;
+              EXPECT_EQ(symmetry::canonicalize_6j(a, s - e, s - f, d, s - b, s - c).chain, canon.chain);
+            }
+}
+
+TEST(test_symmetry, permutation_9j) {
+  wigcpp::ensure_global(2 * 20, 9);
+  const std::array<std::array<int, 9>, 4> cases{{{2, 4, 6, 4, 2, 4, 6, 4, 2},
+                                                  {1, 1, 0, 1, 3, 2, 0, 2, 2},
+                                                  {30, 30, 30, 30, 6, 30, 30, 36, 20},
+                                                  {3, 5, 4, 5, 3, 4, 4, 4, 6}}};
+  for (const auto &m : cases) {
+    const auto canon = symmetry::canonicalize_9j(m);
+    const double value = wigcpp::nine_j(m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8]);
+    const auto &c = canon.two_j;
+    EXPECT_DOUBLE_EQ(value, canon.sign * wigcpp::nine_j(c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7], c[8]));
+
+    for (int rp = 0; rp < 6; ++rp)
+      for (int cp = 0; cp < 6; ++cp) {
+        std::array<int, 9> s;
+        for (int i = 0; i < 3; ++i)
+          for (int j = 0; j < 3; ++j)
+            s[i * 3 + j] = m[perm3[rp][i] * 3 + perm3[cp][j]];
+        EXPECT_EQ(symmetry::canonicalize_9j(s).two_j, canon.two_j);
+      }
+  }
+}
+
+TEST(test_symbol_cache, hit_and_miss) {
+  wigcpp::ensure_global(2 * 100, 9);
+  const double expected_3j = wigcpp::three_j(2 * 15, 2 * 30, 2 * 40, 2 * 2, 2 * 2, -2 * 4);
+  const double expected_6j = wigcpp::six_j(2 * 20, 2 * 20, 2 * 20, 2 * 20, 2 * 20, 0);
+  const double expected_9j = wigcpp::nine_j(60, 60, 20, 61, 61, 40, 61, 61, 20);
+
+  wigcpp::cache_enable(1 << 20);
+  wigcpp::cache_reset_stats();
+
+  EXPECT_DOUBLE_EQ(wigcpp::three_j(2 * 15, 2 * 30, 2 * 40, 2 * 2, 2 * 2, -2 * 4), expected_3j);
+  /* odd column permutation, J = 85 is odd */
+  EXPECT_DOUBLE_EQ(wigcpp::three_j(2 * 30, 2 * 15, 2 * 40, 2 * 2, 2 * 2, -2 * 4), -expected_3j);
+  EXPECT_DOUBLE_EQ(wigcpp::six_j(2 * 20, 2 * 20, 2 * 20, 2 * 20, 2 * 20, 0), expected_6j);
+  EXPECT_DOUBLE_EQ(wigcpp::six_j(2 * 20, 0, 2 * 20, 2 * 20, 2 * 20, 2 * 20), expected_6j);
+  EXPECT_DOUBLE_EQ(wigcpp::nine_j(60, 60, 20, 61, 61, 40, 61, 61, 20), expected_9j);
+  EXPECT_DOUBLE_EQ(wigcpp::nine_j(60, 61, 61, 60, 61, 61, 20, 40, 20), expected_9j);
+
+  long long hits = 0, misses = 0;
+  wigcpp::cache_stats(hits, misses);
+  EXPECT_EQ(hits, 3);
+  EXPECT_EQ(misses, 3);
+
+  /* trivial zeros never reach the cache */
+  EXPECT_EQ(wigcpp::three_j(2, 2, 4, 1, 1, 1), 0.0);
+  wigcpp::cache_stats(hits, misses);
+  EXPECT_EQ(hits + misses, 6);
+
+  wigcpp::cache_disable();
+
+  /* a size without room for a shard is no cache */
+  wigcpp::cache_enable(1 << 20);
+  wigcpp::cache_enable(0);
+  EXPECT_EQ(cache::CacheManager::get(), nullptr);
+}
+
+TEST(test_symbol_cache, multi_thread_eviction) {
+  wigcpp::ensure_global(2 * 40, 3);
+  const auto symbols = all_3j(10);
+  std::vector<double> expected(symbols.size());
+  for (std::size_t i = 0; i < symbols.size(); ++i) {
+    const auto &a = symbols[i];
+    expected[i] = wigcpp::three_j(a[0], a[1], a[2], a[3], a[4], a[5]);
+  }
+
+  /* a tiny cache forces constant eviction while threads race on the same slots */
+  wigcpp::cache_enable(4096);
+
+  constexpr int kThreads = 4;
+  std::vector<std::thread> threads;
+  std::vector<int> mismatches(kThreads, 0);
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int round = 0; round < 3; ++round) {
+        for (std::size_t i = t; i < symbols.size(); i += 1 + (t + round) % 3) {
+          const auto &a = symbols[i];
+          if (wigcpp::three_j(a[0], a[1], a[2], a[3], a[4], a[5]) != expected[i]) {
+            ++mismatches[t];
+          }
+        }
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  wigcpp::cache_disable();
+
+  for (int t = 0; t < kThreads; ++t) {
+    EXPECT_EQ(mismatches[t], 0);
+  }
+}
@@ -0,0 +1,244 @@
+/* Copyright (c) 2025 Diketene. Licensed under GPL-3.0 */
+
+#include "gtest/gtest.h"
+#include "internal/symmetry.hpp"
+#include "internal/table.hpp"
+#include "internal/table_file.hpp"
+#include "wigcpp/wigcpp.hpp"
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace wigcpp::internal;
+
+TEST(test_table, rank_and_unrank) {
+  std::array<int, 5> chain{};
+  const auto total = table::binomial(10 + 5, 5);
+  for (std::uint64_t r = 0; r < total; ++r) {
+    ASSERT_EQ(table::rank(chain), r);
+    ASSERT_EQ(table::unrank<5>(r), chain);
+    for (std::size_t i = 0; i + 1 < chain.size(); ++i) {
+      ASSERT_LE(chain[i], chain[i + 1]);
+    }
+    table::next(chain);
+  }
+  /* ranks of chains with top <= 10 are exactly [0, C(15, 5)) */
+  EXPECT_EQ(chain, (std::array<int, 5>{0, 0, 0, 0, 11}));
+}
+
+TEST(test_table, rank_3j) {
+  constexpr int top = 20;
+  std::uint64_t canonical = 0;
+  std::array<int, 5> c{};
+  auto &[v0, v1, v2, v3, v4] = c;
+  for (v4 = 0; v4 <= top; ++v4)
+    for (v3 = 0; v3 <= v4; ++v3)
+      for (v2 = 0; v2 <= v3; ++v2)
+        for (v1 = 0; v1 <= v2; ++v1)
+          for (v0 = 0; v0 <= v1; ++v0) {
+            canonical += 2 * v3 > v2 + v4 || (2 * v3 == v2 + v4 && 2 * v1 >= v0 + v2);
+          }
+  /* the canonical chains with top <= 20 are exactly [0, chains_3j_below(21)), half of all chains and fixed ones */
+  ASSERT_EQ(table::chains_3j_below(top + 1), canonical);
+
+  std::array<int, 5> chain{0, 0, 0, 0, 0};
+  for (std::uint64_t r = 0; r < canonical; ++r) {
+    ASSERT_EQ(table::rank_3j(chain), r);
+    ASSERT_EQ(table::unrank_3j(r), chain);
+    const auto a = symmetry::representative_3j({chain, 1});
+    ASSERT_EQ(symmetry::canonicalize_3j(a[0], a[1], a[2], a[3], a[4], a[5]).chain, chain);
+    table::next_3j(chain);
+  }
+  EXPECT_EQ(chain, (std::array<int, 5>{0, top + 1, top + 1, top + 1, top + 1}));
+  EXPECT_EQ(wigcpp::table_size(3, top), static_cast<long long>(canonical));
+}
+
+TEST(test_table, fill_3j) {
+  constexpr int max_two_j = 8;
+  wigcpp::ensure_global(2 * 20, 3);
+  std::vector<double> table(wigcpp::table_size(3, max_two_j));
+  wigcpp::table_fill(3, max_two_j, table.data(), 3);
+
+  int checked = 0;
+  for (int j1 = 0; j1 <= max_two_j; ++j1)
+    for (int j2 = 0; j2 <= max_two_j; ++j2)
+      for (int j3 = 0; j3 <= max_two_j; ++j3)
+        for (int m1 = -j1; m1 <= j1; m1 += 2)
+          for (int m2 = -j2; m2 <= j2; m2 += 2) {
+            const int m3 = -m1 - m2;
+            int sign;
+            const auto index = wigcpp::table_index_3j(j1, j2, j3, m1, m2, m3, sign);
+            const double value = wigcpp::three_j(j1, j2, j3, m1, m2, m3);
+            if (index < 0) {
+              EXPECT_EQ(value, 0.0);
+              continue;
+            }
+            ASSERT_LT(index, static_cast<long long>(table.size()));
+            EXPECT_DOUBLE_EQ(sign * table[index], value);
+            ++checked;
+          }
+  EXPECT_GT(checked, 0);
+}
+
+TEST(test_table, fill_6j) {
+  constexpr int max_two_j = 6;
+  wigcpp::ensure_global(2 * 20, 6);
+  std::vector<double> table(wigcpp::table_size(6, max_two_j));
+  wigcpp::table_fill(6, max_two_j, table.data(), 2);
+
+  for (int a = 0; a <= max_two_j; ++a)
+    for (int b = 0; b <= max_two_j; ++b)
+      for (int c = 0; c <= max_two_j; ++c)
+        for (int d = 0; d <= max_two_j; ++d)
+          for (int e = 0; e <= max_two_j; ++e)
+            for (int f = 0; f <= max_two_j; ++f) {
+              const auto index = wigcpp::table_index_6j(a, b, c, d, e, f);
+              const double value = wigcpp::six_j(a, b, c, d, e, f);
+              if (index < 0) {
+                EXPECT_EQ(value, 0.0);
+                continue;
+              }
+              ASSERT_LT(index, static_cast<long long>(table.size()));
+              EXPECT_DOUBLE_EQ(table[index], value);
+            }
+}
+
+TEST(test_table, fill_odd_max_two_j) {
+  constexpr int max_two_j = 5;
+  /* the pool of an odd max_two_j is that of the next even one */
+  wigcpp::ensure_global(max_two_j + 1, 6);
+
+  std::vector<double> table3(wigcpp::table_size(3, max_two_j));
+  wigcpp::table_fill(3, max_two_j, table3.data(), 2);
+  std::vector<bool> seen3(table3.size());
+  for (int j1 = 0; j1 <= max_two_j; ++j1)
+    for (int j2 = 0; j2 <= max_two_j; ++j2)
+      for (int j3 = 0; j3 <= max_two_j; ++j3)
+        for (int m1 = -j1; m1 <= j1; m1 += 2)
+          for (int m2 = -j2; m2 <= j2; m2 += 2) {
+            int sign;
+            const auto index = wigcpp::table_index_3j(j1, j2, j3, m1, m2, -m1 - m2, sign);
+            if (index < 0) {
+              continue;
+            }
+            ASSERT_LT(index, static_cast<long long>(table3.size()));
+            EXPECT_DOUBLE_EQ(sign * table3[index], wigcpp::three_j(j1, j2, j3, m1, m2, -m1 - m2))
+                << j1 << " " << j2 << " " << j3 << " " << m1 << " " << m2;
+            seen3[index] = true;
+          }
+  /* every other entry belongs to symbols beyond max_two_j */
+  for (std::size_t i = 0; i < table3.size(); ++i) {
+    if (!seen3[i]) {
+      EXPECT_EQ(table3[i], 0.0) << "3j entry " << i;
+    }
+  }
+
+  std::vector<double> table6(wigcpp::table_size(6, max_two_j));
+  wigcpp::table_fill(6, max_two_j, table6.data(), 2);
+  std::vector<bool> seen6(table6.size());
+  for (int a = 0; a <= max_two_j; ++a)
+    for (int b = 0; b <= max_two_j; ++b)
+      for (int c = 0; c <= max_two_j; ++c)
+        for (int d = 0; d <= max_two_j; ++d)
+          for (int e = 0; e <= max_two_j; ++e)
+            for (int f = 0; f <= max_two_j; ++f) {
+              const auto index = wigcpp::table_index_6j(a, b, c, d, e, f);
+              if (index < 0) {
+                continue;
+              }
+              ASSERT_LT(index, static_cast<long long>(table6.size()));
+              EXPECT_DOUBLE_EQ(table6[index], wigcpp::six_j(a, b, c, d, e, f))
+                  << a << " " << b << " " << c << " " << d << " " << e << " " << f;
+              seen6[index] = true;
+            }
+  for (std::size_t i = 0; i < table6.size(); ++i) {
+    if (!seen6[i]) {
+      EXPECT_EQ(table6[i], 0.0) << "6j entry " << i;
+    }
+  }
+}
+
+TEST(test_table, file_6j) {
+  constexpr int max_two_j = 6;
+  wigcpp::ensure_global(2 * 20, 6);
+  const std::string path = (std::filesystem::temp_directory_path() / "wigcpp_test_6j.tbl").string();
+  ASSERT_TRUE(table::write_table_file(global::PoolManager::get(), 6, max_two_j, path.c_str(), 2, 100, nullptr));
+  EXPECT_FALSE(std::filesystem::exists(path + ".partial"));
+  EXPECT_FALSE(std::filesystem::exists(path + ".progress"));
+
+  {
+    wigcpp::table_file file(path.c_str(), true);
+    ASSERT_TRUE(file);
+    for (int a = 0; a <= max_two_j; ++a)
+      for (int b = 0; b <= max_two_j; ++b)
+        for (int c = 0; c <= max_two_j; ++c)
+          for (int d = 0; d <= max_two_j; ++d)
+            for (int e = 0; e <= max_two_j; ++e)
+              for (int f = 0; f <= max_two_j; ++f) {
+                EXPECT_DOUBLE_EQ(file.six_j(a, b, c, d, e, f), wigcpp::six_j(a, b, c, d, e, f));
+              }
+  }
+
+  /* flip one payload byte: only a verifying open notices */
+  {
+    std::FILE *fp = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(fp, nullptr);
+    std::fseek(fp, static_cast<long>(table::payload_offset) + 8, SEEK_SET);
+    const int byte = std::fgetc(fp);
+    std::fseek(fp, static_cast<long>(table::payload_offset) + 8, SEEK_SET);
+    std::fputc(byte ^ 0x40, fp);
+    std::fclose(fp);
+  }
+  EXPECT_FALSE(wigcpp::table_file(path.c_str(), true));
+  EXPECT_TRUE(wigcpp::table_file(path.c_str(), false));
+  std::filesystem::remove(path);
+}
+
+TEST(test_table, file_odd_3j) {
+  /* as wigcpp-tablegen -t 3 -j 5 */
+  constexpr int max_two_j = 5;
+  table::ensure_pool(3, max_two_j);
+  const std::string path = (std::filesystem::temp_directory_path() / "wigcpp_test_3j.tbl").string();
+  ASSERT_TRUE(table::write_table_file(global::PoolManager::get(), 3, max_two_j, path.c_str(), 2, 100, nullptr));
+
+  {
+    wigcpp::table_file file(path.c_str(), true);
+    ASSERT_TRUE(file);
+    for (int j1 = 0; j1 <= max_two_j; ++j1)
+      for (int j2 = 0; j2 <= max_two_j; ++j2)
+        for (int j3 = 0; j3 <= max_two_j; ++j3)
+          for (int m1 = -j1; m1 <= j1; m1 += 2)
+            for (int m2 = -j2; m2 <= j2; m2 += 2) {
+              EXPECT_DOUBLE_EQ(file.three_j(j1, j2, j3, m1, m2, -m1 - m2), wigcpp::three_j(j1, j2, j3, m1, m2, -m1 - m2))
+                  << j1 << " " << j2 << " " << j3 << " " << m1 << " " << m2;
+            }
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(test_table, file_9j) {
+  constexpr int max_two_j = 4;
+  wigcpp::ensure_global(2 * 20, 9);
+  const std::string path = (std::filesystem::temp_directory_path() / "wigcpp_test_9j.tbl").string();
+  ASSERT_TRUE(table::write_table_file(global::PoolManager::get(), 9, max_two_j, path.c_str(), 2, 64, nullptr));
+
+  wigcpp::table_file file(path.c_str(), true);
+  ASSERT_TRUE(file);
+  int checked = 0;
+  std::array<int, 9> m{};
+  for (int n = 0; n < 1953125; ++n) {
+    for (int i = 0, x = n; i < 9; ++i, x /= 5) {
+      m[i] = x % 5;
+    }
+    if (calc::TrivialZero::is_zero_9j(m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8])) {
+      continue;
+    }
+    EXPECT_DOUBLE_EQ(file.nine_j(m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8]),
+                     wigcpp::nine_j(m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8]));
+    ++checked;
+  }
+  EXPECT_GT(checked, 0);
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,86 @@
+/* Copyright (c) 2025 Diketene. Licensed under GPL-3.0 */
+
+#include "gtest/gtest.h"
+#include "internal/tiered.hpp"
+#include "wigcpp/wigcpp.hpp"
+#include <cmath>
+#include <random>
+
+using namespace wigcpp::internal;
+
+namespace {
+/* the certified bound, plus the error of the long double reference */
+void expect_certified(double result, long double reference) {
+  EXPECT_LE(std::fabs(result - reference), (0x1p-53L + 0x1p-59L) * std::fabs(reference));
+}
+} // namespace
+
+TEST(test_tiered, certified) {
+  wigcpp::ensure_global(2 * 100, 6);
+  const auto &pool = global::PoolManager::get();
+  auto &tmp = tmp::TempManager::get(pool.max_two_j, pool.stride());
+
+  std::minstd_rand rng(11);
+  std::uniform_int_distribution<int> dist(0, 100);
+  int nonzero_3j = 0, certified_3j = 0, nonzero_6j = 0, certified_6j = 0;
+  for (int n = 0; n < 20000; ++n) {
+    int j[6];
+    for (auto &x : j) {
+      x = dist(rng);
+    }
+    const int m1 = j[0] - 2 * (dist(rng) % (j[0] + 1)), m2 = j[1] - 2 * (dist(rng) % (j[1] + 1));
+
+    double r;
+    const long double l3 = wigcpp::three_j_l(j[0], j[1], j[2], m1, m2, -m1 - m2);
+    if (l3 != 0) {
+      ++nonzero_3j;
+      if (tiered::try_3j(pool, tmp, j[0], j[1], j[2], m1, m2, -m1 - m2, r)) {
+        ++certified_3j;
+        expect_certified(r, l3);
+      }
+    }
+    if (tiered::try_cg(pool, tmp, j[0], j[1], m1, m2, j[2], m1 + m2, r)) {
+      expect_certified(r, wigcpp::cg_l(j[0], j[1], m1, m2, j[2], m1 + m2));
+    }
+
+    const long double l6 = wigcpp::six_j_l(j[0], j[1], j[2], j[3], j[4], j[5]);
+    if (l6 != 0) {
+      ++nonzero_6j;
+      if (tiered::try_6j(pool, tmp, j[0], j[1], j[2], j[3], j[4], j[5], r)) {
+        ++certified_6j;
+        expect_certified(r, l6);
+      }
+    }
+  }
+  /* well-conditioned symbols are the rule at moderate j */
+  EXPECT_GT(certified_3j, nonzero_3j * 9 / 10);
+  EXPECT_GT(certified_6j, nonzero_6j * 9 / 10);
+}
+
+TEST(test_tiered, fallback) {
+  wigcpp::ensure_global(2 * 400, 6);
+  const auto &pool = global::PoolManager::get();
+  auto &tmp = tmp::TempManager::get(pool.max_two_j, pool.stride());
+
+  /* large symbols with strong cancellation fail the bound and take the exact path */
+  std::minstd_rand rng(5);
+  std::uniform_int_distribution<int> dist(300, 400);
+  int fallbacks = 0;
+  for (int n = 0; n < 200; ++n) {
+    const int a = 2 * (dist(rng) / 2), b = 2 * (dist(rng) / 2), c = 2 * (dist(rng) / 2);
+    double r;
+    if (!tiered::try_6j(pool, tmp, a, b, c, b, c, a, r)) {
+      ++fallbacks;
+      EXPECT_EQ(tiered::calc_6j(pool, tmp, a, b, c, b, c, a), wigcpp::six_j(a, b, c, b, c, a));
+    }
+    if (!tiered::try_3j(pool, tmp, a, b, c, 2, -4, 2, r)) {
+      ++fallbacks;
+      EXPECT_EQ(tiered::calc_3j(pool, tmp, a, b, c, 2, -4, 2), wigcpp::three_j(a, b, c, 2, -4, 2));
+    }
+  }
+  EXPECT_GT(fallbacks, 0);
+
+  EXPECT_DOUBLE_EQ(wigcpp::tiered_cg(35, 37, 3, 5, 66, 8), 0.1090035277273105);
+  EXPECT_DOUBLE_EQ(wigcpp::tiered_3j(800, 160, 960, 2, -2, 0), 8.40975504480554782e-03);
+  EXPECT_EQ(wigcpp::tiered_6j(2, 4, 4, 2, 4, 1), 0.0);
+}
@@ -0,0 +1,49 @@
+/* Copyright (c) 2025 Diketene. Licensed under GPL-3.0 */
+
+#include "gtest/gtest.h"
+#include "wigcpp/tiny.hpp"
+#include "wigcpp/wigcpp.hpp"
+
+namespace tiny = wigcpp::tiny;
+
+/* evaluated by the compiler */
+static_assert(tiny::three_j(0, 0, 0, 0, 0, 0) == 1.0);
+static_assert(tiny::three_j(2, 2, 0, 2, -2, 0) > 0 && tiny::three_j(2, 2, 0, 0, 0, 0) < 0);
+static_assert(tiny::three_j(2, 2, 2, 0, 0, 0) == 0.0);
+static_assert(tiny::six_j(2, 4, 6, 4, 2, 4) == tiny::six_j(4, 2, 6, 2, 4, 4) && tiny::six_j(0, 2, 2, 2, 2, 2) < 0);
+static_assert(tiny::cg(1, 1, 1, -1, 0, 0) > 0 && tiny::cg(1, 1, -1, 1, 0, 0) < 0);
+
+TEST(test_tiny, three_j) {
+  wigcpp::ensure_global(2 * tiny::max_two_j, 3);
+  for (int j1 = 0; j1 <= tiny::max_two_j; ++j1)
+    for (int j2 = 0; j2 <= tiny::max_two_j; ++j2)
+      for (int j3 = 0; j3 <= tiny::max_two_j; ++j3)
+        for (int m1 = -j1 - 1; m1 <= j1 + 1; ++m1)
+          for (int m2 = -j2; m2 <= j2; m2 += 2) {
+            const int m3 = -m1 - m2;
+            ASSERT_EQ(tiny::three_j(j1, j2, j3, m1, m2, m3), wigcpp::three_j(j1, j2, j3, m1, m2, m3));
+            EXPECT_DOUBLE_EQ(tiny::cg(j1, j2, m1, m2, j3, -m3), wigcpp::cg(j1, j2, m1, m2, j3, -m3));
+          }
+}
+
+TEST(test_tiny, six_j) {
+  wigcpp::ensure_global(2 * tiny::max_two_j, 6);
+  for (int n = 0; n < 531441; ++n) {
+    int m[6];
+    for (int i = 0, x = n; i < 6; ++i, x /= 9) {
+      m[i] = x % 9;
+    }
+    ASSERT_EQ(tiny::six_j(m[0], m[1], m[2], m[3], m[4], m[5]), wigcpp::six_j(m[0], m[1], m[2], m[3], m[4], m[5]));
+  }
+}
+
+TEST(test_tiny, table_index) {
+  /* the entries sit at the index of the runtime tables */
+  int sign;
+  const auto index = wigcpp::table_index_3j(8, 6, 4, 2, -4, 2, sign);
+  const auto c = tiny::detail::canonicalize_3j(8, 6, 4, 2, -4, 2);
+  EXPECT_EQ(tiny::detail::rank(c), index);
+  EXPECT_EQ(c.sign, sign);
+  EXPECT_EQ(tiny::detail::rank(tiny::detail::canonicalize_6j(8, 6, 4, 2, 6, 8)),
+            wigcpp::table_index_6j(8, 6, 4, 2, 6, 8));
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "wigcpp/wigcpp.hpp"
+#include "internal/global_pool.hpp"
+#include "internal/tmp_pool.hpp"
 #include <thread>
 #include <vector>
 
@@ -64,4 +66,101 @@ TEST(test_xj_thread, MultiFunc_3j) {
       EXPECT_DOUBLE_EQ(thread_data[i].expected, thread_data[i].result);
     }
   }
-}
\ No newline at end of file
+}
+
+TEST(test_xj_thread, ParallelSums) {
+  wigcpp::ensure_global(3000, 9);
+
+  /* 9j sums over k, 3j sums past the residue summation, and symbols too small to split */
+  const auto evaluate = [] {
+    return std::vector<double>{wigcpp::nine_j(100, 100, 100, 100, 100, 100, 100, 100, 100),
+                               wigcpp::nine_j(120, 80, 60, 90, 110, 40, 70, 50, 80),
+                               wigcpp::nine_j(101, 99, 80, 97, 103, 60, 40, 60, 100),
+                               wigcpp::three_j(3000, 3000, 3000, 2, -2, 0),
+                               wigcpp::three_j(2800, 1500, 2000, 40, -60, 20),
+                               wigcpp::six_j(40, 40, 40, 40, 40, 40),
+                               wigcpp::nine_j(20, 20, 20, 20, 20, 20, 20, 20, 20)};
+  };
+
+  const auto serial = evaluate();
+  for (const int num_threads : {2, 3, 8}) {
+    wigcpp::parallel_sums(num_threads);
+    EXPECT_EQ(evaluate(), serial) << num_threads;
+
+    /* symbols split from several threads at once */
+    std::vector<std::vector<double>> results(3);
+    std::vector<std::thread> threads;
+    for (auto &r : results) {
+      threads.emplace_back([&r, &evaluate] { r = evaluate(); });
+    }
+    for (auto &t : threads) {
+      t.join();
+    }
+    for (const auto &r : results) {
+      EXPECT_EQ(r, serial);
+    }
+  }
+  wigcpp::parallel_sums(1);
+
+  for (const double v : serial) {
+    EXPECT_NE(v, 0.0);
+  }
+}
+
+TEST(test_xj_thread, RecycleTls) {
+  wigcpp::ensure_global(2 * 100, 9);
+  const auto &pool = wigcpp::internal::global::PoolManager::get();
+
+  /* the storage a new thread evaluates with, and its results */
+  const auto run_thread = [&pool] {
+    std::pair<const void *, std::vector<double>> r;
+    std::thread t([&] {
+      r.second = {wigcpp::three_j(60, 40, 80, 2, -2, 0), wigcpp::six_j(40, 40, 40, 40, 40, 40),
+                  wigcpp::nine_j(20, 20, 20, 20, 20, 20, 20, 20, 20)};
+      r.first = &wigcpp::internal::tmp::TempManager::get(pool.max_two_j, pool.stride());
+    });
+    t.join();
+    return r;
+  };
+
+  const std::vector<double> expected{wigcpp::three_j(60, 40, 80, 2, -2, 0), wigcpp::six_j(40, 40, 40, 40, 40, 40),
+                                     wigcpp::nine_j(20, 20, 20, 20, 20, 20, 20, 20, 20)};
+  wigcpp::recycle_tls(8);
+  const auto first = run_thread();
+  const auto second = run_thread();
+  EXPECT_EQ(second.first, first.first);
+  EXPECT_EQ(first.second, expected);
+  EXPECT_EQ(second.second, expected);
+
+  wigcpp::recycle_tls(0);
+  EXPECT_EQ(run_thread().second, expected);
+  wigcpp::recycle_tls(8);
+}
+
+TEST(test_xj_thread, ShrinkTls) {
+  wigcpp::ensure_global(2 * 200, 9);
+  const auto &pool = wigcpp::internal::global::PoolManager::get();
+
+  std::thread t([&pool] {
+    wigcpp::shrink_tls();
+    const auto &csi = wigcpp::internal::tmp::TempManager::get(pool.max_two_j, pool.stride());
+    const std::size_t empty_bytes = csi.row_bytes();
+    EXPECT_EQ(csi.iter_capacity(), 0u);
+
+    /* the rows grow with the sums met, not with the pool */
+    const double small = wigcpp::three_j(8, 8, 8, 2, -2, 0);
+    EXPECT_NE(small, 0.0);
+    EXPECT_LT(csi.iter_capacity(), 32u);
+
+    const double large = wigcpp::six_j(200, 200, 200, 200, 200, 200);
+    EXPECT_GE(csi.iter_capacity(), 101u);
+    EXPECT_GT(csi.row_bytes(), empty_bytes);
+
+    wigcpp::shrink_tls();
+    EXPECT_EQ(csi.iter_capacity(), 0u);
+    EXPECT_EQ(csi.row_bytes(), empty_bytes);
+    EXPECT_EQ(wigcpp::six_j(200, 200, 200, 200, 200, 200), large);
+    EXPECT_EQ(wigcpp::three_j(8, 8, 8, 2, -2, 0), small);
+  });
+  t.join();
+}
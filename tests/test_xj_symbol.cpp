@@ -2,6 +2,10 @@
 
 #include "gtest/gtest.h"
 #include "wigcpp/wigcpp.hpp"
+#include "internal/calc.hpp"
+#include <cmath>
+#include <random>
+#include <type_traits>
 
 TEST(test_3j, test_cg) {
   {
@@ -122,4 +126,113 @@ TEST(test_xj, test_9j) {
     res = wigcpp::nine_j(30, 30, 30, 30, 6, 30, 30, 36, 20);
     EXPECT_DOUBLE_EQ(res, -7.78324615309538859e-05);
   }
-}
\ No newline at end of file
+}
+TEST(test_xj, test_closed_forms) {
+  wigcpp::ensure_global(2 * 40, 9);
+  auto parity = [](int two_x) { return ((two_x / 2) & 1) ? -1.0 : 1.0; };
+  auto log_fact = [](int n) { return std::lgamma(n + 1.0); };
+
+  /* all m zero against the summed Clebsch-Gordan coefficient */
+  for (int j1 = 0; j1 <= 40; j1 += 2)
+    for (int j2 = 0; j2 <= 40; j2 += 2)
+      for (int j3 = std::abs(j1 - j2); j3 <= j1 + j2; j3 += 2) {
+        const double expected = parity(j1 - j2) * wigcpp::cg(j1, j2, 0, 0, j3, 0) / std::sqrt(j3 + 1.0);
+        EXPECT_NEAR(wigcpp::three_j(j1, j2, j3, 0, 0, 0), expected, 1e-14);
+      }
+
+  /* stretched, a single term */
+  for (int j1 = 0; j1 <= 20; ++j1)
+    for (int j2 = 0; j2 <= 20; ++j2)
+      for (int m1 = -j1; m1 <= j1; m1 += 2)
+        for (int m2 = -j2; m2 <= j2; m2 += 2) {
+          const int J = j1 + j2, M = m1 + m2;
+          const double log_value = (log_fact(j1) + log_fact(j2) + log_fact((J + M) / 2) + log_fact((J - M) / 2) -
+                                    log_fact(J + 1) - log_fact((j1 + m1) / 2) - log_fact((j1 - m1) / 2) -
+                                    log_fact((j2 + m2) / 2) - log_fact((j2 - m2) / 2)) /
+                                   2;
+          EXPECT_NEAR(wigcpp::three_j(j1, j2, J, m1, m2, -M), parity(j1 - j2 + M) * std::exp(log_value), 1e-13);
+        }
+
+  /* 6j with a zero */
+  for (int a = 0; a <= 20; ++a)
+    for (int b = 0; b <= 20; ++b)
+      for (int c = std::abs(a - b); c <= a + b; c += 2) {
+        const double expected = parity(a + b + c) / std::sqrt((a + 1.0) * (b + 1.0));
+        EXPECT_NEAR(wigcpp::six_j(a, b, c, b, a, 0), expected, 1e-15);
+        EXPECT_NEAR(wigcpp::six_j(c, a, b, 0, b, a), expected, 1e-15);
+        EXPECT_NEAR(wigcpp::six_j(0, b, b, c, a, a), expected, 1e-15);
+        EXPECT_EQ(wigcpp::six_j(a, b, c, b + 2, a, 0), 0.0);
+      }
+
+  /* 9j with a zero against the 6j it reduces to, in every position of the zero */
+  for (int a = 0; a <= 6; ++a)
+    for (int b = 0; b <= 6; ++b)
+      for (int c = std::abs(a - b); c <= a + b; c += 2)
+        for (int d = 0; d <= 6; ++d)
+          for (int e = std::abs(c - d); e <= c + d; e += 2)
+            for (int g = std::abs(a - d); g <= std::min(a + d, b + e); g += 2) {
+              if (g < std::abs(b - e)) {
+                continue;
+              }
+              const double expected = parity(b + c + d + g) / std::sqrt((c + 1.0) * (g + 1.0)) *
+                                      wigcpp::six_j(a, b, c, e, d, g);
+              const double odd = parity(a + b + c + d + e + c + g + g);
+              EXPECT_NEAR(wigcpp::nine_j(a, b, c, d, e, c, g, g, 0), expected, 1e-14);
+              EXPECT_NEAR(wigcpp::nine_j(0, g, g, c, a, b, c, d, e), expected, 1e-14);
+              EXPECT_NEAR(wigcpp::nine_j(g, g, 0, d, e, c, a, b, c), odd * expected, 1e-14);
+            }
+}
+
+TEST(test_xj, test_reused_storage) {
+  wigcpp::ensure_global(2 * 20, 9);
+  /* rows left longer by earlier symbols must not leak into a later 9j */
+  const double expected = wigcpp::nine_j(2, 2, 2, 2, 3, 1, 2, 1, 1);
+  EXPECT_DOUBLE_EQ(wigcpp::six_j(2, 1, 1, 3, 2, 4), 0.28867513459481287);
+  EXPECT_DOUBLE_EQ(wigcpp::six_j(1, 1, 2, 3, 1, 2), -0.33333333333333331);
+  EXPECT_DOUBLE_EQ(wigcpp::nine_j(2, 2, 2, 2, 3, 1, 2, 1, 1), expected);
+  EXPECT_DOUBLE_EQ(expected, 0.083333333333333329);
+}
+
+TEST(test_xj, test_double_eval) {
+  using wigcpp::internal::calc::Calculator;
+  wigcpp::ensure_global(2 * 300, 9);
+  const auto &pool = wigcpp::internal::global::PoolManager::get();
+  auto &tmp = wigcpp::internal::tmp::TempManager::get(pool.max_two_j, pool.stride());
+
+  /* the documented bound of the double evaluation relative to the long double one */
+  constexpr long double bound = 11 * 0x1p-53L;
+  const auto check = [&](long double l, double d) {
+    if (l == 0) {
+      EXPECT_EQ(d, 0.0);
+    } else {
+      EXPECT_LE(std::fabs((d - l) / l), bound);
+    }
+  };
+
+  std::minstd_rand rng(7);
+  for (int max_two_j : {40, 600}) {
+    std::uniform_int_distribution<int> dist(0, max_two_j);
+    for (int n = 0; n < 20000; ++n) {
+      int j[9];
+      for (auto &x : j) {
+        x = dist(rng);
+      }
+      const int m1 = j[0] - 2 * (dist(rng) % (j[0] + 1)), m2 = j[1] - 2 * (dist(rng) % (j[1] + 1));
+
+      const long double l3 = Calculator::calc_3j<long double>(pool, tmp, j[0], j[1], j[2], m1, m2, -m1 - m2);
+      check(l3, Calculator::calc_3j<double>(pool, tmp, j[0], j[1], j[2], m1, m2, -m1 - m2));
+      EXPECT_EQ(wigcpp::three_j_l(j[0], j[1], j[2], m1, m2, -m1 - m2), l3);
+
+      const long double l6 = Calculator::calc_6j<long double>(pool, tmp, j[0], j[1], j[2], j[3], j[4], j[5]);
+      check(l6, Calculator::calc_6j<double>(pool, tmp, j[0], j[1], j[2], j[3], j[4], j[5]));
+      if constexpr (std::is_same_v<wigcpp::internal::def::eval_type, long double>) {
+        EXPECT_EQ(wigcpp::six_j(j[0], j[1], j[2], j[3], j[4], j[5]), static_cast<double>(l6));
+      }
+
+      if (max_two_j == 40) {
+        check(Calculator::calc_9j<long double>(pool, tmp, j[0], j[1], j[2], j[3], j[4], j[5], j[6], j[7], j[8]),
+              Calculator::calc_9j<double>(pool, tmp, j[0], j[1], j[2], j[3], j[4], j[5], j[6], j[7], j[8]));
+      }
+    }
+  }
+}
@@ -0,0 +1,81 @@
+/* Copyright (c) 2025 Diketene <liuhaotian0406@163.com> */
+
+/*	This file is part of wigcpp.
+ *
+ *	Wigcpp is licensed under the GPL-3.0 license.
+ *	You should have received a copy of the GPL-3.0 license,
+ *	if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* wigcpp-tablegen: precomputes a table file of 3j, 6j or 9j symbols, see README.md for the file format and reader API */
+
+#include "internal/global_pool.hpp"
+#include "internal/table_file.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+void usage() {
+  std::fprintf(stderr, "usage: wigcpp-tablegen -t <3|6|9> -j <max_two_j> -o <file> [-n <threads>] [-s <shard_entries>] "
+                       "[-q]\n"
+                       "  -t  type of the symbols\n"
+                       "  -j  twice the largest angular momentum stored in the table\n"
+                       "  -o  output file, an interrupted run continues from <file>.partial and <file>.progress\n"
+                       "  -n  number of threads, 0 (default) uses one thread per core\n"
+                       "  -s  number of entries computed and written at once (default 1048576)\n"
+                       "  -q  don't report progress\n");
+}
+
+void report(std::uint64_t done, std::uint64_t total) {
+  std::fprintf(stderr, "\r%llu / %llu entries", static_cast<unsigned long long>(done),
+               static_cast<unsigned long long>(total));
+  if (done == total) {
+    std::fprintf(stderr, "\n");
+  }
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  int wigner_type = 0, max_two_j = -1, num_threads = 0;
+  unsigned long long shard_entries = 0;
+  const char *output = nullptr;
+  bool quiet = false;
+
+  for (int i = 1; i < argc; ++i) {
+    const bool has_value = i + 1 < argc;
+    if (!std::strcmp(argv[i], "-t") && has_value) {
+      wigner_type = std::atoi(argv[++i]);
+    } else if (!std::strcmp(argv[i], "-j") && has_value) {
+      max_two_j = std::atoi(argv[++i]);
+    } else if (!std::strcmp(argv[i], "-o") && has_value) {
+      output = argv[++i];
+    } else if (!std::strcmp(argv[i], "-n") && has_value) {
+      num_threads = std::atoi(argv[++i]);
+    } else if (!std::strcmp(argv[i], "-s") && has_value) {
+      shard_entries = std::strtoull(argv[++i], nullptr, 10);
+    } else if (!std::strcmp(argv[i], "-q")) {
+      quiet = true;
+    } else {
+      usage();
+      return EXIT_FAILURE;
+    }
+  }
+
+  if ((wigner_type != 3 && wigner_type != 6 && wigner_type != 9) || max_two_j < 0 || !output) {
+    usage();
+    return EXIT_FAILURE;
+  }
+  if (wigner_type == 9 && max_two_j > wigcpp::internal::table::max_two_j_9j) {
+    std::fprintf(stderr, "wigcpp-tablegen: max_two_j of a 9j table can't exceed %d.\n",
+                 wigcpp::internal::table::max_two_j_9j);
+    return EXIT_FAILURE;
+  }
+
+  wigcpp::internal::table::ensure_pool(wigner_type, max_two_j);
+  const auto &pool = wigcpp::internal::global::PoolManager::get();
+
+  const bool ok = wigcpp::internal::table::write_table_file(pool, wigner_type, max_two_j, output, num_threads,
+                                                            shard_entries, quiet ? nullptr : report);
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}